@@ -0,0 +1,60 @@
+// Mesh load benchmark
+//
+// Compares rebuilding a mesh from its element lists (addFace/addCell,
+// connectivity, geometry, face ordering) with loading the same mesh from
+// a native .cfdmesh file via MeshFile::read().
+//
+// Usage: bench_mesh_io [n]   (n^3 hexahedral cells, default 96)
+
+#include "core/Mesh.h"
+#include "io/MeshFile.h"
+#include "mesh/MeshGenerator.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+using namespace cfd;
+
+namespace {
+
+double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[]) {
+    int n = (argc > 1) ? std::atoi(argv[1]) : 96;
+    const std::string path = "bench_mesh_io.cfdmesh";
+
+    auto start = std::chrono::steady_clock::now();
+    Mesh mesh = MeshGenerator::createBoxMesh(n, n, n, Vector3D(0, 0, 0), Vector3D(1, 1, 1));
+    double buildTime = secondsSince(start);
+
+    start = std::chrono::steady_clock::now();
+    MeshFile::write(mesh, path);
+    double writeTime = secondsSince(start);
+
+    // Best of three to keep the page cache warm for both paths
+    double readTime = 1e30;
+    for (int i = 0; i < 3; ++i) {
+        start = std::chrono::steady_clock::now();
+        Mesh loaded = MeshFile::read(path);
+        double t = secondsSince(start);
+        if (t < readTime) readTime = t;
+        if (loaded.getNumCells() != mesh.getNumCells()) {
+            std::cerr << "Cell count mismatch after load\n";
+            return 1;
+        }
+    }
+    std::remove(path.c_str());
+
+    std::cout << "Mesh: " << mesh.getNumCells() << " cells, " << mesh.getNumFaces() << " faces\n";
+    std::cout << "Build from elements: " << buildTime << " s\n";
+    std::cout << "Write .cfdmesh:      " << writeTime << " s\n";
+    std::cout << "Read .cfdmesh:       " << readTime << " s (" << buildTime / readTime << "x faster)\n";
+    return 0;
+}
@@ -0,0 +1,141 @@
+// Mesh setup benchmark: geometry and node -> cell connectivity
+//
+// Compares Mesh::computeAllGeometry() and Mesh::buildNodeCellConnectivity()
+// against the original serial implementations that deduplicated cell
+// vertices with a std::set per cell, then times Mesh::updateGeometry()
+// after a piston-style translation of the top node layers.
+//
+// Usage: bench_mesh_setup [n]   (n^3 hexahedral cells, default 128)
+
+#include "core/Mesh.h"
+#include "mesh/MeshGenerator.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <set>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using namespace cfd;
+
+namespace {
+
+double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Original serial geometry pass with std::set vertex deduplication
+void legacyComputeAllGeometry(Mesh& mesh) {
+    for (int i = 0; i < mesh.getNumFaces(); ++i) {
+        mesh.computeFaceGeometry(i);
+    }
+    for (int c = 0; c < mesh.getNumCells(); ++c) {
+        std::set<int> uniqueNodes;
+        for (int faceId : mesh.cellFaces.row(c)) {
+            for (int nodeId : mesh.faceNodes.row(faceId)) {
+                uniqueNodes.insert(nodeId);
+            }
+        }
+        Vector3D centroid(0, 0, 0);
+        for (int nodeId : uniqueNodes) {
+            centroid += mesh.getNode(nodeId).position;
+        }
+        Cell& cell = mesh.getCell(c);
+        cell.centroid = centroid / static_cast<double>(uniqueNodes.size());
+
+        double volume = 0.0;
+        for (int faceId : mesh.cellFaces.row(c)) {
+            const Face& face = mesh.getFace(faceId);
+            double contribution = face.area * (face.centroid - cell.centroid).dot(face.normal);
+            volume += (face.ownerCell == c) ? contribution : -contribution;
+        }
+        cell.volume = std::abs(volume / 3.0);
+    }
+}
+
+// Original node -> cell build: std::set per cell, std::vector per node
+std::vector<std::vector<label>> legacyNodeCells(const Mesh& mesh) {
+    std::vector<std::vector<label>> nodeCells(mesh.getNumNodes());
+    for (int c = 0; c < mesh.getNumCells(); ++c) {
+        std::set<int> uniqueNodes;
+        for (int faceId : mesh.cellFaces.row(c)) {
+            for (int nodeId : mesh.faceNodes.row(faceId)) {
+                uniqueNodes.insert(nodeId);
+            }
+        }
+        for (int nodeId : uniqueNodes) {
+            nodeCells[nodeId].push_back(c);
+        }
+    }
+    return nodeCells;
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[]) {
+    int n = (argc > 1) ? std::atoi(argv[1]) : 128;
+
+    int threads = 1;
+#ifdef _OPENMP
+    threads = omp_get_max_threads();
+#endif
+
+    auto t0 = std::chrono::steady_clock::now();
+    Mesh mesh = MeshGenerator::createBoxMesh(n, n, n, Vector3D(0, 0, 0), Vector3D(1, 1, 1));
+    double buildTime = secondsSince(t0);
+
+    std::cout << "Mesh: " << mesh.getNumCells() << " cells, " << mesh.getNumFaces()
+              << " faces, " << mesh.getNumNodes() << " nodes (built in "
+              << buildTime << " s)\n";
+    std::cout << "Threads: " << threads << "\n\n";
+
+    t0 = std::chrono::steady_clock::now();
+    legacyComputeAllGeometry(mesh);
+    double legacyGeom = secondsSince(t0);
+
+    t0 = std::chrono::steady_clock::now();
+    mesh.computeAllGeometry();
+    double newGeom = secondsSince(t0);
+
+    t0 = std::chrono::steady_clock::now();
+    auto legacy = legacyNodeCells(mesh);
+    double legacyConn = secondsSince(t0);
+
+    t0 = std::chrono::steady_clock::now();
+    mesh.buildNodeCellConnectivity();
+    double newConn = secondsSince(t0);
+
+    // Cross-check the two node -> cell builds
+    bool match = true;
+    for (int node = 0; node < mesh.getNumNodes() && match; ++node) {
+        Span<const label> row = mesh.nodeCells.row(node);
+        match = std::vector<label>(row.begin(), row.end()) == legacy[node];
+    }
+
+    std::cout << "computeAllGeometry        legacy " << legacyGeom << " s, new "
+              << newGeom << " s, speedup " << legacyGeom / newGeom << "x\n";
+    std::cout << "buildNodeCellConnectivity legacy " << legacyConn << " s, new "
+              << newConn << " s, speedup " << legacyConn / newConn << "x\n";
+    std::cout << "node -> cell tables match: " << (match ? "yes" : "NO") << "\n";
+
+    // Piston step: move the top tenth of the node layers
+    std::vector<label> pistonNodes;
+    for (const Node& node : mesh.nodes) {
+        if (node.position.z >= 0.9) pistonNodes.push_back(node.id);
+    }
+    mesh.translateNodes(pistonNodes, Vector3D(0, 0, -0.01));
+    t0 = std::chrono::steady_clock::now();
+    label updatedCells = mesh.updateGeometry();
+    double incrementalGeom = secondsSince(t0);
+
+    std::cout << "piston step               full " << newGeom << " s, incremental "
+              << incrementalGeom << " s (" << updatedCells << " cells), speedup "
+              << newGeom / incrementalGeom << "x\n";
+
+    return match ? 0 : 1;
+}
@@ -0,0 +1,80 @@
+// Spatial index benchmark
+//
+// Times MeshSpatialIndex build and refit, then compares spark-kernel style
+// radius queries against a scan over every cell centroid.
+//
+// Usage: bench_spatial_index [n]   (n^3 hexahedral cells, default 96)
+
+#include "core/Mesh.h"
+#include "mesh/MeshGenerator.h"
+#include "mesh/MeshSpatialIndex.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace cfd;
+
+namespace {
+
+double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+std::vector<label> scanRadius(const Mesh& mesh, const Vector3D& point, double radius) {
+    std::vector<label> cells;
+    for (int i = 0; i < mesh.getNumCells(); ++i) {
+        if ((mesh.getCell(i).centroid - point).magnitude() < radius) {
+            cells.push_back(i);
+        }
+    }
+    return cells;
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[]) {
+    int n = (argc > 1) ? std::atoi(argv[1]) : 96;
+    Mesh mesh = MeshGenerator::createBoxMesh(n, n, n, Vector3D(0, 0, 0), Vector3D(1, 1, 1));
+    std::cout << "Mesh: " << mesh.getNumCells() << " cells\n";
+
+    auto start = std::chrono::steady_clock::now();
+    MeshSpatialIndex index(mesh);
+    std::cout << "Build: " << secondsSince(start) << " s (" << index.getNumTreeNodes() << " tree nodes)\n";
+
+    start = std::chrono::steady_clock::now();
+    index.refit(mesh);
+    std::cout << "Refit: " << secondsSince(start) << " s\n";
+
+    // Kernel radius of about two cells
+    const double radius = 2.0 / n;
+    const int queries = 200;
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<double> coord(0.0, 1.0);
+    std::vector<Vector3D> points(queries);
+    for (auto& p : points) {
+        p = Vector3D(coord(rng), coord(rng), coord(rng));
+    }
+
+    size_t scanHits = 0, indexHits = 0;
+    start = std::chrono::steady_clock::now();
+    for (const auto& p : points) scanHits += scanRadius(mesh, p, radius).size();
+    double scanTime = secondsSince(start) / queries;
+
+    start = std::chrono::steady_clock::now();
+    for (const auto& p : points) indexHits += index.findCellsInRadius(p, radius).size();
+    double indexTime = secondsSince(start) / queries;
+
+    start = std::chrono::steady_clock::now();
+    int found = 0;
+    for (const auto& p : points) found += (index.findCell(mesh, p) >= 0);
+    double locateTime = secondsSince(start) / queries;
+
+    std::cout << "Radius query, scan:  " << scanTime * 1e6 << " us (" << scanHits << " hits)\n";
+    std::cout << "Radius query, index: " << indexTime * 1e6 << " us (" << indexHits << " hits, "
+              << scanTime / indexTime << "x faster)\n";
+    std::cout << "Point location:      " << locateTime * 1e6 << " us (" << found << "/" << queries << " found)\n";
+    return 0;
+}
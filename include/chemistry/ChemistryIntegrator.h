@@ -27,11 +27,20 @@ public:
     double getHeatRelease() const { return heatRelease; }
     std::vector<double> getReactionRates() const { return reactionRates; }
     
+    // Time-step limit over the integrations since beginStep():
+    // maxRelativeChange times the shortest species consumption time
+    // Y_i / |omega_i| of any cell (no limit without consumption)
+    void beginStep();
+    double getMaxTimeStep() const;
+    void setMaxRelativeChange(double fraction) { maxRelativeChange = fraction; }
+    
 private:
     ReactionMechanism mechanism;
     double ethanolFraction;
     double heatRelease;
     std::vector<double> reactionRates;
+    double chemicalTimeScale;
+    double maxRelativeChange;
     
     // Integration methods
     void integrateExplicitEuler(double T, double p, std::vector<double>& Y, double dt);
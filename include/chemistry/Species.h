@@ -20,6 +20,9 @@ public:
     
     // NASA polynomial coefficients
     void setNASACoeffs(const std::vector<double>& lowT, const std::vector<double>& highT, double Tmid);
+    const std::vector<double>& getNASACoeffsLowT() const { return nasaLowT; }
+    const std::vector<double>& getNASACoeffsHighT() const { return nasaHighT; }
+    double getTmid() const { return Tmid; }
     
     // Thermodynamic properties (temperature-dependent)
     double getCp(double T) const;  // Specific heat at constant pressure [J/kg/K]
@@ -5,6 +5,7 @@
 #include "combustion/SparkIgnition.h"
 #include "combustion/FlameTracker.h"
 #include "combustion/LaminarFlameSpeed.h"
+#include "mesh/MeshSpatialIndex.h"
 
 namespace cfd {
 
@@ -12,6 +13,7 @@ struct CombustionConfig {
     std::string model = "flamelet";
     double equivalenceRatio = 1.0;
     bool enableSpark = true;
+    double maxFlameCourant = 0.2;  // Largest fraction of a cell the front may cross per step
 };
 
 class CombustionModel {
@@ -20,20 +22,41 @@ public:
     
     void initialize(const CombustionConfig& config);
     void initializeSpark(const SparkConfig& spark, double time);
+    
+    // Mesh for the spark kernel search: a cell search tree is built once
+    // here and refitted when the mesh geometry changes
+    void setMesh(const Mesh& mesh);
+    
+    // Deposit the spark energy once time reaches the ignition time
+    void applySpark(FieldManager& fields, double time);
     void solve(FieldManager& fields, double dt);
     void updateFlamePosition(FieldManager& fields, double dt);
     
     double getHeatReleaseRate() const { return heatReleaseRate; }
     double getBurnedMassFraction() const { return burnedMassFraction; }
     
+    // Time-step control: after ignition the flame front may cross at most
+    // maxFlameCourant of a cell of size cellSize per step. Before ignition
+    // (or without a spark) there is no limit, and the ignition time is the
+    // next event the solver should land on.
+    bool isBurning(double time) const;
+    double getMaxTimeStep(double time, double cellSize) const;
+    double getNextEventTime(double time) const;
+    
 private:
     CombustionConfig config;
     SparkIgnition sparkIgnition;
     FlameTracker flameTracker;
     LaminarFlameSpeed flameSpeed;
     
+    const Mesh* mesh;
+    MeshSpatialIndex spatialIndex;
+    unsigned long indexGeometryVersion;  // Mesh geometry the index was built or refitted for
+    
     double heatReleaseRate;
     double burnedMassFraction;
+    bool sparkInitialized;
+    double ignitionTime;
     
     void computeHeatRelease(FieldManager& fields);
     void computeBurnedMass(FieldManager& fields);
@@ -16,10 +16,12 @@ public:
     bool isBurned(int cellId) const;
     
     double getKernelRadius() const { return kernelRadius; }
+    double getFrontSpeed() const { return frontSpeed; }  // m/s
     
 private:
     Vector3D kernelCenter;
     double kernelRadius;
+    double frontSpeed;
     std::vector<bool> burnedCells;
     
     void updateBurnedRegion(const FieldManager& fields);
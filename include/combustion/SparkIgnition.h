@@ -2,9 +2,13 @@
 
 #include "core/Vector3D.h"
 #include "core/FieldManager.h"
+#include <vector>
 
 namespace cfd {
 
+class Mesh;
+class MeshSpatialIndex;
+
 struct SparkConfig {
     Vector3D location;
     double ignitionTime = 0.001;
@@ -19,12 +23,21 @@ public:
     void initialize(const SparkConfig& config);
     void apply(FieldManager& fields, double time, const class Mesh& mesh);
     
+    // Optional cell search index over the same mesh; used for the kernel
+    // radius query instead of scanning every cell
+    void setSpatialIndex(const MeshSpatialIndex* index) { spatialIndex = index; }
+    
     bool isActive(double time) const;
     Vector3D getLocation() const { return config.location; }
     
+    // Cells with centroid within the kernel radius, ascending; through the
+    // spatial index when one is set for this mesh, else by a full scan
+    std::vector<label> findKernelCells(const class Mesh& mesh) const;
+    
 private:
     SparkConfig config;
     bool applied;
+    const MeshSpatialIndex* spatialIndex;
     
     void depositEnergy(FieldManager& fields, const class Mesh& mesh);
 };
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "core/Label.h"
+#include "core/Span.h"
+#include <vector>
+
+namespace cfd {
+
+/**
+ * @brief Compressed-sparse-row connectivity table
+ *
+ * Row r holds indices[offsets[r] .. offsets[r + 1]). All rows share two
+ * contiguous arrays, so walking a row never touches a separate allocation.
+ */
+class CSRConnectivity {
+public:
+    std::vector<label> offsets;  // numRows + 1 entries, offsets[0] == 0
+    std::vector<label> indices;
+
+    CSRConnectivity() : offsets(1, 0) {}
+
+    // Size queries
+    label getNumRows() const { return static_cast<label>(offsets.size()) - 1; }
+    label getNumEntries() const { return static_cast<label>(indices.size()); }
+    label getRowSize(label row) const { return offsets[row + 1] - offsets[row]; }
+
+    // Row access
+    Span<const label> row(label r) const {
+        return Span<const label>(indices.data() + offsets[r], getRowSize(r));
+    }
+    Span<label> row(label r) {
+        return Span<label>(indices.data() + offsets[r], getRowSize(r));
+    }
+
+    // Incremental construction
+    void appendRow(const std::vector<label>& entries) {
+        indices.insert(indices.end(), entries.begin(), entries.end());
+        offsets.push_back(toLabel(indices.size()));
+    }
+
+    /**
+     * @brief Size the table from per-row counts (exclusive prefix sum).
+     * Indices are allocated but left for the caller to fill.
+     */
+    void allocateFromCounts(const std::vector<label>& counts) {
+        offsets.assign(counts.size() + 1, 0);
+        for (size_t i = 0; i < counts.size(); ++i) {
+            offsets[i + 1] = offsets[i] + counts[i];
+        }
+        indices.assign(offsets.back(), -1);
+    }
+
+    void reserve(label rows, label entries) {
+        offsets.reserve(rows + 1);
+        indices.reserve(entries);
+    }
+
+    void clear() {
+        offsets.assign(1, 0);
+        indices.clear();
+    }
+
+    size_t getMemoryUsage() const {
+        return (offsets.capacity() + indices.capacity()) * sizeof(label);
+    }
+};
+
+} // namespace cfd
@@ -1,5 +1,10 @@
 #pragma once
 
+#include "core/Label.h"
+#include "core/FieldArena.h"
+#include "core/FieldKernels.h"
+#include "core/FieldExpression.h"
+#include <cstddef>
 #include <vector>
 #include <string>
 #include <algorithm>
@@ -12,24 +17,114 @@ enum class FieldType {
     TENSOR
 };
 
+// Storage precision of a field's values; arithmetic is always double
+enum class FieldPrecision {
+    DOUBLE,
+    FLOAT
+};
+
+// Placement of the components of vector and tensor fields
+enum class FieldLayout {
+    INTERLEAVED,  // Array of structures: values[cell * components + comp]
+    BLOCKED       // Structure of arrays: values[comp * numCells + cell]
+};
+
 /**
  * @brief Field class for storing scalar, vector, or tensor data on mesh cells
+ *
+ * By default the components of a cell are stored contiguously at
+ * data[cellId * components] (INTERLEAVED), which suits per-cell access. A
+ * BLOCKED field stores each component as one contiguous array instead, so
+ * component-wise kernels (fillComponent, minComponent, clampComponent,
+ * component expressions) run as plain unit-stride SIMD loops. Element
+ * access goes through index(), which works for either layout; offsets are
+ * computed in size_t so they cannot overflow for any label width. Scalar
+ * fields are the same in both layouts. Storage is 64-byte aligned and bulk
+ * operations and statistics run through the SIMD/OpenMP kernels in
+ * core/FieldKernels.h. Given an arena allocator the values live in a
+ * FieldArena slab (see FieldManager::enableArena); copies of a field are
+ * always heap-allocated.
+ *
+ * A FLOAT field keeps its values in floatData (data stays empty), halving
+ * its memory and bandwidth. Bulk operations, statistics and expressions
+ * work on either precision and compute in double. operator() returns a
+ * reference into data and so needs double storage (it throws
+ * std::logic_error on FLOAT fields); element access on FLOAT fields must go through value() and
+ * setValue(), which work for both.
  */
+class FieldComponent;
+
 class Field {
 public:
     std::string name;
     FieldType type;
-    std::vector<double> data;
+    FieldPrecision precision;
+    FieldLayout layout;           // Change with setLayout()
+    FieldStorage data;            // DOUBLE fields
+    FloatFieldStorage floatData;  // FLOAT fields
+    
+    Field(const std::string& name_, FieldType type_, label size,
+          FieldPrecision precision_ = FieldPrecision::DOUBLE,
+          FieldLayout layout_ = FieldLayout::INTERLEAVED,
+          const ArenaAllocator<double>& allocator = ArenaAllocator<double>());
+    
+    // Position of (cellId, component) in data / floatData, for either layout
+    std::size_t index(label cellId, int component = 0) const {
+        return static_cast<std::size_t>(cellId) * cellStride + static_cast<std::size_t>(component) * componentStride;
+    }
+    std::size_t getCellStride() const { return cellStride; }
+    std::size_t getComponentStride() const { return componentStride; }
+    
+    // Data access (double-precision fields only: data is empty on FLOAT
+    // fields, which must use value() / setValue())
+    double& operator()(label cellId, int component = 0) {
+        if (isFloat()) throwFloatAccess();
+        return data[index(cellId, component)];
+    }
+    const double& operator()(label cellId, int component = 0) const {
+        if (isFloat()) throwFloatAccess();
+        return data[index(cellId, component)];
+    }
+    
+    // Data access for either precision
+    double value(label cellId, int component = 0) const {
+        std::size_t i = index(cellId, component);
+        return isFloat() ? static_cast<double>(floatData[i]) : data[i];
+    }
+    void setValue(label cellId, int component, double v) {
+        std::size_t i = index(cellId, component);
+        if (isFloat()) {
+            floatData[i] = static_cast<float>(v);
+        } else {
+            data[i] = v;
+        }
+    }
     
-    Field(const std::string& name_, FieldType type_, int size);
+    bool isFloat() const { return precision == FieldPrecision::FLOAT; }
+    bool isBlocked() const { return layout == FieldLayout::BLOCKED && getNumComponents() > 1; }
     
-    // Data access
-    double& operator()(int cellId, int component = 0);
-    const double& operator()(int cellId, int component = 0) const;
+    // Rearrange the values into another layout
+    void setLayout(FieldLayout newLayout);
+    
+    // One component as an expression operand / assignment target
+    FieldComponent component(int comp);
+    ComponentTerm component(int comp) const;
+    
+    // Evaluate a field expression in one pass (see core/FieldExpression.h)
+    template <typename E>
+    Field& operator=(const FieldExpression<E>& e) { return evaluate<expr::Assign>(e); }
+    template <typename E>
+    Field& operator+=(const FieldExpression<E>& e) { return evaluate<expr::AddAssign>(e); }
+    template <typename E>
+    Field& operator-=(const FieldExpression<E>& e) { return evaluate<expr::SubtractAssign>(e); }
+    Field& operator+=(const Field& other) { add(other); return *this; }
+    Field& operator-=(const Field& other) { subtract(other); return *this; }
     
     // Size queries
     int getNumComponents() const;
-    int getSize() const { return static_cast<int>(data.size()) / getNumComponents(); }
+    std::size_t getNumValues() const { return isFloat() ? floatData.size() : data.size(); }
+    label getSize() const { return static_cast<label>(getNumValues() / getNumComponents()); }
+    std::size_t getBytes() const { return data.size() * sizeof(double) + floatData.size() * sizeof(float); }
     
     // Field operations
     void fill(double value);
@@ -38,6 +133,19 @@ public:
     void add(const Field& other);
     void subtract(const Field& other);
     
+    // Change the cell count; values of new cells are zero
+    void resize(label numCells);
+    
+    // Move the values into fresh storage from allocator, resized to numCells
+    void reallocate(label numCells, const ArenaAllocator<double>& allocator);
+    
+    // Reorder cells: new cell i takes the values of old cell newToOld[i]
+    void permute(const std::vector<label>& newToOld);
+    
+    // Exchange values (and their storage) with a field of the same type,
+    // precision, layout and size; O(1), no values are copied
+    void swapValues(Field& other);
+    
     // Statistics
     double min() const;
     double max() const;
@@ -45,6 +153,14 @@ public:
     double minComponent(int component) const;
     double maxComponent(int component) const;
     
+    // Compensated sums, bitwise reproducible for any thread count. weights
+    // holds getSize() values, e.g. cell volumes (see core/FieldIntegrals.h).
+    double sum() const;
+    double weightedSum(const double* weights, int component = 0) const;
+    
+    // Min, max, sum, NaN and Inf counts over all components in one sweep
+    FieldStatistics computeStatistics() const;
+    
     // Bounds checking
     void clamp(double minVal, double maxVal);
     void clampComponent(int component, double minVal, double maxVal);
@@ -53,10 +169,104 @@ public:
     Field(const Field& other);
     Field& operator=(const Field& other);
     
-    // Validation
+    // Validation (one sweep each)
     bool isValid() const;
     bool hasNaN() const;
     bool hasInf() const;
+    
+private:
+    friend struct expr::Term<Field, void>;
+    
+    std::size_t cellStride;
+    std::size_t componentStride;
+    
+    void updateStrides();
+    [[noreturn]] void throwFloatAccess() const;
+    
+    // Call fn(values, numValues) with the storage of this field's precision
+    template <typename Fn>
+    decltype(auto) dispatch(Fn&& fn) {
+        return isFloat() ? fn(floatData.data(), floatData.size()) : fn(data.data(), data.size());
+    }
+    template <typename Fn>
+    decltype(auto) dispatch(Fn&& fn) const {
+        return isFloat() ? fn(floatData.data(), floatData.size()) : fn(data.data(), data.size());
+    }
+    
+    template <typename AssignOp, typename E>
+    Field& evaluate(const FieldExpression<E>& e) {
+        dispatch([&](auto* values, std::size_t) {
+            expr::evaluate<AssignOp>(values, getSize(), getNumComponents(), cellStride, componentStride, e);
+        });
+        return *this;
+    }
+};
+
+/**
+ * @brief Assignable view of one component of a field
+ *
+ * Reads like a single-component expression; assigning an expression writes
+ * that component of every cell.
+ */
+class FieldComponent : public ComponentTerm {
+public:
+    FieldComponent(double* data_, std::size_t numCells_, std::size_t stride_)
+        : ComponentTerm(data_, numCells_, stride_) {}
+    FieldComponent(float* floatData_, std::size_t numCells_, std::size_t stride_)
+        : ComponentTerm(floatData_, numCells_, stride_) {}
+    
+    template <typename E>
+    FieldComponent& operator=(const FieldExpression<E>& e) { return evaluate<expr::Assign>(e); }
+    template <typename E>
+    FieldComponent& operator+=(const FieldExpression<E>& e) { return evaluate<expr::AddAssign>(e); }
+    template <typename E>
+    FieldComponent& operator-=(const FieldExpression<E>& e) { return evaluate<expr::SubtractAssign>(e); }
+    
+    // Copies values, not the view
+    FieldComponent& operator=(const FieldComponent& other) {
+        return *this = static_cast<const ComponentTerm&>(other);
+    }
+    FieldComponent& operator=(double value) {
+        return *this = ConstantTerm(value);
+    }
+    
+private:
+    template <typename AssignOp, typename E>
+    FieldComponent& evaluate(const FieldExpression<E>& e) {
+        if (floatData) {
+            expr::evaluate<AssignOp>(const_cast<float*>(floatData), numCells, 1, stride, 0, e);
+        } else {
+            expr::evaluate<AssignOp>(const_cast<double*>(data), numCells, 1, stride, 0, e);
+        }
+        return *this;
+    }
 };
 
+inline FieldComponent Field::component(int comp) {
+    return dispatch([&](auto* values, std::size_t) {
+        return FieldComponent(values + comp * componentStride, getSize(), cellStride);
+    });
+}
+
+inline ComponentTerm Field::component(int comp) const {
+    return dispatch([&](const auto* values, std::size_t) {
+        return ComponentTerm(values + comp * componentStride, getSize(), cellStride);
+    });
+}
+
+namespace expr {
+
+template <>
+struct Term<Field, void> {
+    using type = FieldTerm;
+    static type make(const Field& field) {
+        return field.dispatch([&](const auto* values, std::size_t) {
+            return FieldTerm(values, field.getSize(), field.getNumComponents(), field.getCellStride(),
+                             field.getComponentStride());
+        });
+    }
+};
+
+} // namespace expr
+
 } // namespace cfd
@@ -0,0 +1,128 @@
+#pragma once
+
+#include "core/AlignedAllocator.h"
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace cfd {
+
+/**
+ * @brief Arena of SIMD_ALIGNMENT-aligned slabs for field storage
+ *
+ * Memory comes from a few large chunks, normally one sized for every field
+ * up front. Blocks are rounded up to whole slabs and placed first-fit;
+ * freed blocks are coalesced with their neighbours. When no chunk has room
+ * a new chunk is added, so allocation never fails short of the heap.
+ * Thread-safe.
+ */
+class FieldArena {
+public:
+    static constexpr std::size_t SLAB_BYTES = SIMD_ALIGNMENT;
+
+    explicit FieldArena(std::size_t capacityBytes);
+    ~FieldArena();
+
+    FieldArena(const FieldArena&) = delete;
+    FieldArena& operator=(const FieldArena&) = delete;
+
+    void* allocate(std::size_t bytes);
+    void deallocate(void* ptr, std::size_t bytes);
+
+    std::size_t getCapacity() const;        // Bytes over all chunks
+    std::size_t getUsedBytes() const;       // Bytes in live blocks (slab-rounded)
+    std::size_t getPeakBytes() const;       // Highest getUsedBytes() so far
+    std::size_t getLargestFreeBlock() const;
+    int getNumChunks() const;
+
+    /**
+     * @brief 1 - largest free block / total free bytes
+     *
+     * 0 when the free space is one block (or there is none); approaches 1
+     * as it splinters into many small gaps.
+     */
+    double getFragmentation() const;
+
+private:
+    struct Chunk {
+        char* base;
+        std::size_t size;
+        std::map<std::size_t, std::size_t> freeBlocks;  // Offset -> size
+    };
+
+    std::vector<Chunk> chunks;
+    std::size_t usedBytes;
+    std::size_t peakBytes;
+    mutable std::mutex mutex;
+
+    static std::size_t roundToSlab(std::size_t bytes) {
+        return (bytes + SLAB_BYTES - 1) / SLAB_BYTES * SLAB_BYTES;
+    }
+    void addChunk(std::size_t bytes);
+
+    // Callers hold mutex
+    std::size_t capacityLocked() const;
+    std::size_t largestFreeBlockLocked() const;
+};
+
+/**
+ * @brief Aligned allocator drawing from a FieldArena, or the heap if none
+ *
+ * Copies of a container fall back to the heap (a temporary copy of an
+ * arena field does not consume arena space); move and swap carry the
+ * arena along with the buffer.
+ */
+template <typename T>
+class ArenaAllocator {
+public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::false_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+    using is_always_equal = std::false_type;
+
+    template <typename U>
+    struct rebind {
+        using other = ArenaAllocator<U>;
+    };
+
+    ArenaAllocator() noexcept : arena(nullptr) {}
+    explicit ArenaAllocator(FieldArena* arena_) noexcept : arena(arena_) {}
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) noexcept : arena(other.getArena()) {}
+
+    T* allocate(std::size_t n) {
+        if (arena && n > 0) {
+            return static_cast<T*>(arena->allocate(n * sizeof(T)));
+        }
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(SIMD_ALIGNMENT)));
+    }
+
+    void deallocate(T* p, std::size_t n) noexcept {
+        if (arena && n > 0) {
+            arena->deallocate(p, n * sizeof(T));
+        } else {
+            ::operator delete(p, std::align_val_t(SIMD_ALIGNMENT));
+        }
+    }
+
+    ArenaAllocator select_on_container_copy_construction() const { return ArenaAllocator(); }
+
+    FieldArena* getArena() const noexcept { return arena; }
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U>& other) const noexcept { return arena == other.getArena(); }
+    template <typename U>
+    bool operator!=(const ArenaAllocator<U>& other) const noexcept { return arena != other.getArena(); }
+
+private:
+    FieldArena* arena;
+};
+
+// Field value storage: aligned, optionally arena-backed
+using FieldStorage = std::vector<double, ArenaAllocator<double>>;
+using FloatFieldStorage = std::vector<float, ArenaAllocator<float>>;
+
+} // namespace cfd
@@ -0,0 +1,449 @@
+#pragma once
+
+#include "core/FieldKernels.h"
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace cfd {
+
+/**
+ * @brief Lazy element-wise arithmetic over fields
+ *
+ * Operators on Field, component views and scalars build lightweight
+ * expression objects instead of temporaries; assigning the expression to a
+ * Field evaluates it in one fused loop:
+ *
+ *     phi = phi_old + dt * (a * x - b * y);   // one pass, no allocation
+ *     U.component(2) = U.component(2) - dt * g;
+ *
+ * Operations act per component. A single-component operand (scalar field
+ * or component view) is broadcast across the components of a vector or
+ * tensor expression, so rho * U is valid. When every operand shares the
+ * destination's layout the loop is flat, SIMD-vectorized and split across
+ * OpenMP threads above kernels::PARALLEL_THRESHOLD values. Otherwise it
+ * runs per cell and component: component-major with a unit-stride,
+ * vectorized inner loop for BLOCKED destinations, cell-major for
+ * INTERLEAVED ones.
+ *
+ * The destination may appear in its own expression. Operands that read it
+ * element for element (phi = 2 * phi, U.component(0) = U.component(1)) are
+ * evaluated in place. An operand that reads other elements of the
+ * destination, such as a component view broadcast over its own field
+ * (U = U * U.component(0)), would see values already overwritten; such
+ * expressions are evaluated into a scratch buffer first and then stored.
+ *
+ * Reduced-precision (float) fields take part like any other: operands are
+ * widened to double and the result is rounded once when stored.
+ *
+ * Expressions hold raw pointers into the fields; evaluate them before the
+ * fields are resized or destroyed.
+ */
+struct FieldExpressionBase {};
+
+template <typename E>
+struct FieldExpression : FieldExpressionBase {
+    const E& self() const { return static_cast<const E&>(*this); }
+};
+
+/*
+ * Every term provides:
+ *   operator[](i)      element i of the destination's flat storage
+ *   at(cell, comp)     element by position
+ *   conforms(n, c)     usable for a destination of n cells and c components
+ *   isFlat(c, cs, ps)  operator[] valid for a destination of c components
+ *                      stored at values[cell * cs + comp * ps]
+ *   isUnitDouble(flat) every operand is double and, unless flat, has unit
+ *                      cell stride; element<true> / elementAt<true> may then
+ *                      skip the precision and stride logic so the loop
+ *                      vectorizes with plain loads
+ *   aliases(dst)       some operand reads an element of dst other than the
+ *                      one being written at the same position
+ */
+
+namespace expr {
+
+// Storage written by an assignment: element (cell, comp) at
+// values[cell * cellStride + comp * componentStride]
+struct Destination {
+    const void* values;
+    std::size_t elementSize;
+    std::size_t numCells;
+    int numComponents;
+    std::size_t cellStride;
+    std::size_t componentStride;
+};
+
+namespace detail {
+
+// Whether a strided operand over values reads elements of dst that are
+// written at other positions
+template <typename T>
+bool readsOtherElements(const T* values, std::size_t numCells, int numComponents, std::size_t cellStride,
+                        std::size_t componentStride, const Destination& dst) {
+    // A field holds either double or float values, never both
+    if (numCells == 0 || dst.numCells == 0 || sizeof(T) != dst.elementSize) return false;
+    if (values == dst.values && numComponents == dst.numComponents && cellStride == dst.cellStride &&
+        (numComponents == 1 || componentStride == dst.componentStride)) {
+        return false;  // Same element mapping
+    }
+
+    auto extent = [](std::size_t cells, int comps, std::size_t cs, std::size_t ps) {
+        return ((cells - 1) * cs + static_cast<std::size_t>(comps - 1) * ps + 1) * sizeof(T);
+    };
+    const std::uintptr_t begin = reinterpret_cast<std::uintptr_t>(values);
+    const std::uintptr_t dstBegin = reinterpret_cast<std::uintptr_t>(dst.values);
+    if (begin + extent(numCells, numComponents, cellStride, componentStride) <= dstBegin ||
+        dstBegin + extent(dst.numCells, dst.numComponents, dst.cellStride, dst.componentStride) <= begin) {
+        return false;
+    }
+    // Two components of one interleaved field never share an element
+    if (numComponents == 1 && dst.numComponents == 1 && cellStride == dst.cellStride && cellStride > 1) {
+        const std::uintptr_t offset = (begin > dstBegin ? begin - dstBegin : dstBegin - begin) / sizeof(T);
+        return offset % cellStride == 0;
+    }
+    return true;
+}
+
+} // namespace detail
+
+} // namespace expr
+
+// Whole-field operand: element (cell, comp) at
+// data[cell * cellStride + comp * componentStride].
+// Exactly one of data / floatData is set.
+class FieldTerm : public FieldExpression<FieldTerm> {
+public:
+    using TermType = FieldTerm;
+
+    FieldTerm(const double* data_, std::size_t numCells_, int numComponents_,
+              std::size_t cellStride_, std::size_t componentStride_)
+        : data(data_), floatData(nullptr), numCells(numCells_), numComponents(numComponents_),
+          cellStride(cellStride_), componentStride(componentStride_) {}
+    FieldTerm(const float* floatData_, std::size_t numCells_, int numComponents_,
+              std::size_t cellStride_, std::size_t componentStride_)
+        : data(nullptr), floatData(floatData_), numCells(numCells_), numComponents(numComponents_),
+          cellStride(cellStride_), componentStride(componentStride_) {}
+
+    double operator[](std::size_t i) const { return element<false>(i); }
+    double at(std::size_t cell, int comp) const { return elementAt<false>(cell, comp); }
+
+    template <bool Unit>
+    double element(std::size_t i) const { return Unit ? data[i] : load(i); }
+    template <bool Unit>
+    double elementAt(std::size_t cell, int comp) const {
+        const std::size_t offset = (numComponents == 1) ? 0 : comp * componentStride;
+        return Unit ? data[cell + offset] : load(cell * cellStride + offset);
+    }
+
+    bool conforms(std::size_t cells, int comps) const {
+        return cells == numCells && (numComponents == comps || numComponents == 1);
+    }
+    bool isFlat(int comps, std::size_t cs, std::size_t ps) const {
+        return numComponents == comps && (comps == 1 || (cellStride == cs && componentStride == ps));
+    }
+    bool isUnitDouble(bool flat) const { return !floatData && (flat || cellStride == 1); }
+    bool aliases(const expr::Destination& dst) const {
+        return floatData ? expr::detail::readsOtherElements(floatData, numCells, numComponents, cellStride, componentStride, dst)
+                         : expr::detail::readsOtherElements(data, numCells, numComponents, cellStride, componentStride, dst);
+    }
+
+private:
+    const double* data;
+    const float* floatData;
+    std::size_t numCells;
+    int numComponents;
+    std::size_t cellStride;
+    std::size_t componentStride;
+
+    double load(std::size_t i) const { return floatData ? static_cast<double>(floatData[i]) : data[i]; }
+};
+
+// One component of an interleaved field: element of cell i at data[i * stride]
+class ComponentTerm : public FieldExpression<ComponentTerm> {
+public:
+    using TermType = ComponentTerm;
+
+    ComponentTerm(const double* data_, std::size_t numCells_, std::size_t stride_)
+        : data(data_), floatData(nullptr), numCells(numCells_), stride(stride_) {}
+    ComponentTerm(const float* floatData_, std::size_t numCells_, std::size_t stride_)
+        : data(nullptr), floatData(floatData_), numCells(numCells_), stride(stride_) {}
+
+    double operator[](std::size_t i) const { return element<false>(i); }
+    double at(std::size_t cell, int comp) const { return elementAt<false>(cell, comp); }
+
+    template <bool Unit>
+    double element(std::size_t i) const { return Unit ? data[i] : load(i * stride); }
+    template <bool Unit>
+    double elementAt(std::size_t cell, int) const { return element<Unit>(cell); }
+
+    bool conforms(std::size_t cells, int) const { return cells == numCells; }
+    bool isFlat(int comps, std::size_t, std::size_t) const { return comps == 1; }
+    bool isUnitDouble(bool) const { return !floatData && stride == 1; }
+    bool aliases(const expr::Destination& dst) const {
+        return floatData ? expr::detail::readsOtherElements(floatData, numCells, 1, stride, 0, dst)
+                         : expr::detail::readsOtherElements(data, numCells, 1, stride, 0, dst);
+    }
+
+protected:
+    const double* data;
+    const float* floatData;
+    std::size_t numCells;
+    std::size_t stride;
+
+    double load(std::size_t i) const { return floatData ? static_cast<double>(floatData[i]) : data[i]; }
+};
+
+class ConstantTerm : public FieldExpression<ConstantTerm> {
+public:
+    using TermType = ConstantTerm;
+
+    explicit ConstantTerm(double value_) : value(value_) {}
+
+    double operator[](std::size_t) const { return value; }
+    double at(std::size_t, int) const { return value; }
+
+    template <bool Unit>
+    double element(std::size_t) const { return value; }
+    template <bool Unit>
+    double elementAt(std::size_t, int) const { return value; }
+
+    bool conforms(std::size_t, int) const { return true; }
+    bool isFlat(int, std::size_t, std::size_t) const { return true; }
+    bool isUnitDouble(bool) const { return true; }
+    bool aliases(const expr::Destination&) const { return false; }
+
+private:
+    double value;
+};
+
+template <typename Op, typename L, typename R>
+class BinaryExpression : public FieldExpression<BinaryExpression<Op, L, R>> {
+public:
+    using TermType = BinaryExpression;
+
+    BinaryExpression(const L& lhs_, const R& rhs_) : lhs(lhs_), rhs(rhs_) {}
+
+    double operator[](std::size_t i) const { return element<false>(i); }
+    double at(std::size_t cell, int comp) const { return elementAt<false>(cell, comp); }
+
+    template <bool Unit>
+    double element(std::size_t i) const {
+        return Op::apply(lhs.template element<Unit>(i), rhs.template element<Unit>(i));
+    }
+    template <bool Unit>
+    double elementAt(std::size_t cell, int comp) const {
+        return Op::apply(lhs.template elementAt<Unit>(cell, comp), rhs.template elementAt<Unit>(cell, comp));
+    }
+
+    bool conforms(std::size_t cells, int comps) const {
+        return lhs.conforms(cells, comps) && rhs.conforms(cells, comps);
+    }
+    bool isFlat(int comps, std::size_t cs, std::size_t ps) const {
+        return lhs.isFlat(comps, cs, ps) && rhs.isFlat(comps, cs, ps);
+    }
+    bool isUnitDouble(bool flat) const { return lhs.isUnitDouble(flat) && rhs.isUnitDouble(flat); }
+    bool aliases(const expr::Destination& dst) const { return lhs.aliases(dst) || rhs.aliases(dst); }
+
+private:
+    L lhs;
+    R rhs;
+};
+
+template <typename E>
+class NegateExpression : public FieldExpression<NegateExpression<E>> {
+public:
+    using TermType = NegateExpression;
+
+    explicit NegateExpression(const E& operand_) : operand(operand_) {}
+
+    double operator[](std::size_t i) const { return element<false>(i); }
+    double at(std::size_t cell, int comp) const { return elementAt<false>(cell, comp); }
+
+    template <bool Unit>
+    double element(std::size_t i) const { return -operand.template element<Unit>(i); }
+    template <bool Unit>
+    double elementAt(std::size_t cell, int comp) const { return -operand.template elementAt<Unit>(cell, comp); }
+
+    bool conforms(std::size_t cells, int comps) const { return operand.conforms(cells, comps); }
+    bool isFlat(int comps, std::size_t cs, std::size_t ps) const { return operand.isFlat(comps, cs, ps); }
+    bool isUnitDouble(bool flat) const { return operand.isUnitDouble(flat); }
+    bool aliases(const expr::Destination& dst) const { return operand.aliases(dst); }
+
+private:
+    E operand;
+};
+
+namespace expr {
+
+struct Add { static double apply(double a, double b) { return a + b; } };
+struct Subtract { static double apply(double a, double b) { return a - b; } };
+struct Multiply { static double apply(double a, double b) { return a * b; } };
+struct Divide { static double apply(double a, double b) { return a / b; } };
+
+// T is the destination's storage type (double or float)
+struct Assign {
+    template <typename T> static void apply(T& dst, double value) { dst = static_cast<T>(value); }
+};
+struct AddAssign {
+    template <typename T> static void apply(T& dst, double value) { dst = static_cast<T>(dst + value); }
+};
+struct SubtractAssign {
+    template <typename T> static void apply(T& dst, double value) { dst = static_cast<T>(dst - value); }
+};
+
+/**
+ * @brief Operand -> expression term mapping
+ *
+ * Arithmetic values become constants and expressions map to themselves;
+ * Field specializes this in Field.h.
+ */
+template <typename T, typename = void>
+struct Term {};
+
+template <typename T>
+struct Term<T, std::enable_if_t<std::is_arithmetic<T>::value>> {
+    using type = ConstantTerm;
+    static type make(T value) { return ConstantTerm(static_cast<double>(value)); }
+};
+
+template <typename T>
+struct Term<T, std::enable_if_t<std::is_base_of<FieldExpressionBase, T>::value>> {
+    using type = typename T::TermType;
+    static type make(const T& e) { return e; }
+};
+
+template <typename T, typename = void>
+struct IsOperand : std::false_type {};
+
+template <typename T>
+struct IsOperand<T, std::void_t<typename Term<T>::type>> : std::true_type {};
+
+// At least one side must be a field or expression
+template <typename L, typename R>
+using EnableBinary = std::enable_if_t<IsOperand<L>::value && IsOperand<R>::value &&
+                                      !(std::is_arithmetic<L>::value && std::is_arithmetic<R>::value)>;
+
+template <typename Op, typename L, typename R>
+using BinaryResult = BinaryExpression<Op, typename Term<L>::type, typename Term<R>::type>;
+
+namespace detail {
+
+template <typename AssignOp, bool Unit, typename T, typename E>
+void flatLoop(T* dst, std::size_t n, const E& e) {
+    #pragma omp parallel for simd schedule(static) if(n >= kernels::PARALLEL_THRESHOLD)
+    for (std::size_t i = 0; i < n; ++i) {
+        AssignOp::apply(dst[i], e.template element<Unit>(i));
+    }
+}
+
+template <typename AssignOp, bool Unit, typename T, typename E>
+void componentLoop(T* block, std::size_t numCells, int comp, const E& e) {
+    #pragma omp parallel for simd schedule(static) if(numCells >= kernels::PARALLEL_THRESHOLD)
+    for (std::size_t cell = 0; cell < numCells; ++cell) {
+        AssignOp::apply(block[cell], e.template elementAt<Unit>(cell, comp));
+    }
+}
+
+} // namespace detail
+
+/**
+ * @brief Evaluate e into dst, where element (cell, comp) is
+ * dst[cell * cellStride + comp * componentStride]
+ *
+ * Throws std::runtime_error if an operand's size or component count does
+ * not fit the destination. Expressions that read other elements of dst are
+ * evaluated through a scratch buffer.
+ */
+template <typename AssignOp, typename T, typename E>
+void evaluate(T* dst, std::size_t numCells, int numComponents, std::size_t cellStride,
+              std::size_t componentStride, const FieldExpression<E>& expression) {
+    const E& e = expression.self();
+    if (!e.conforms(numCells, numComponents)) {
+        throw std::runtime_error("Field expression sizes do not match");
+    }
+
+    const std::size_t nc = static_cast<std::size_t>(numComponents);
+    const std::size_t n = numCells * nc;
+    if (e.aliases(Destination{dst, sizeof(T), numCells, numComponents, cellStride, componentStride})) {
+        // Read every operand before the first store
+        std::vector<double> values(n);
+        #pragma omp parallel for schedule(static) if(n >= kernels::PARALLEL_THRESHOLD)
+        for (std::size_t cell = 0; cell < numCells; ++cell) {
+            for (int comp = 0; comp < numComponents; ++comp) {
+                values[cell * nc + comp] = e.at(cell, comp);
+            }
+        }
+        #pragma omp parallel for schedule(static) if(n >= kernels::PARALLEL_THRESHOLD)
+        for (std::size_t cell = 0; cell < numCells; ++cell) {
+            for (int comp = 0; comp < numComponents; ++comp) {
+                AssignOp::apply(dst[cell * cellStride + comp * componentStride], values[cell * nc + comp]);
+            }
+        }
+        return;
+    }
+
+    const bool contiguous = (cellStride == nc && (nc == 1 || componentStride == 1)) ||
+                            (cellStride == 1 && componentStride == numCells);
+    if (contiguous && e.isFlat(numComponents, cellStride, componentStride)) {
+        if (e.isUnitDouble(true)) {
+            detail::flatLoop<AssignOp, true>(dst, n, e);
+        } else {
+            detail::flatLoop<AssignOp, false>(dst, n, e);
+        }
+        return;
+    }
+
+    if (cellStride == 1) {
+        // Component-major: unit stride through each component block
+        for (int comp = 0; comp < numComponents; ++comp) {
+            T* block = dst + comp * componentStride;
+            if (e.isUnitDouble(false)) {
+                detail::componentLoop<AssignOp, true>(block, numCells, comp, e);
+            } else {
+                detail::componentLoop<AssignOp, false>(block, numCells, comp, e);
+            }
+        }
+        return;
+    }
+
+    #pragma omp parallel for schedule(static) if(n >= kernels::PARALLEL_THRESHOLD)
+    for (std::size_t cell = 0; cell < numCells; ++cell) {
+        for (int comp = 0; comp < numComponents; ++comp) {
+            AssignOp::apply(dst[cell * cellStride + comp * componentStride], e.at(cell, comp));
+        }
+    }
+}
+
+} // namespace expr
+
+// Arithmetic operators over fields, component views, expressions and scalars
+
+template <typename L, typename R, typename = expr::EnableBinary<L, R>>
+expr::BinaryResult<expr::Add, L, R> operator+(const L& lhs, const R& rhs) {
+    return expr::BinaryResult<expr::Add, L, R>(expr::Term<L>::make(lhs), expr::Term<R>::make(rhs));
+}
+
+template <typename L, typename R, typename = expr::EnableBinary<L, R>>
+expr::BinaryResult<expr::Subtract, L, R> operator-(const L& lhs, const R& rhs) {
+    return expr::BinaryResult<expr::Subtract, L, R>(expr::Term<L>::make(lhs), expr::Term<R>::make(rhs));
+}
+
+template <typename L, typename R, typename = expr::EnableBinary<L, R>>
+expr::BinaryResult<expr::Multiply, L, R> operator*(const L& lhs, const R& rhs) {
+    return expr::BinaryResult<expr::Multiply, L, R>(expr::Term<L>::make(lhs), expr::Term<R>::make(rhs));
+}
+
+template <typename L, typename R, typename = expr::EnableBinary<L, R>>
+expr::BinaryResult<expr::Divide, L, R> operator/(const L& lhs, const R& rhs) {
+    return expr::BinaryResult<expr::Divide, L, R>(expr::Term<L>::make(lhs), expr::Term<R>::make(rhs));
+}
+
+template <typename T, typename = std::enable_if_t<expr::IsOperand<T>::value && !std::is_arithmetic<T>::value>>
+NegateExpression<typename expr::Term<T>::type> operator-(const T& operand) {
+    return NegateExpression<typename expr::Term<T>::type>(expr::Term<T>::make(operand));
+}
+
+} // namespace cfd
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "core/Mesh.h"
+#include "core/Field.h"
+#include "core/Vector3D.h"
+#include <string>
+
+namespace cfd {
+
+/**
+ * @brief Mesh integrals of cell fields
+ *
+ * All sums are compensated and reproducible for any thread count (see
+ * core/Reduction.h), so they can be compared bitwise between runs and are
+ * cheap enough to monitor every step. Patch integrals take the owner cell
+ * value on each face (zero gradient); patches are addressed by name and
+ * throw std::runtime_error if missing.
+ */
+
+// sum_i V_i phi_i
+double volumeIntegral(const Mesh& mesh, const Field& field, int component = 0);
+
+// volumeIntegral / total volume
+double volumeAverage(const Mesh& mesh, const Field& field, int component = 0);
+
+double totalVolume(const Mesh& mesh);
+
+// sum_f |S_f| phi_P over the patch faces
+double patchIntegral(const Mesh& mesh, const Field& field, const std::string& patch, int component = 0);
+
+// patchIntegral / patch area
+double patchAverage(const Mesh& mesh, const Field& field, const std::string& patch, int component = 0);
+
+double patchArea(const Mesh& mesh, const std::string& patch);
+
+// Outward flux sum_f S_f . U_P of a vector field, e.g. velocity
+double patchFlux(const Mesh& mesh, const Field& vectorField, const std::string& patch);
+
+} // namespace cfd
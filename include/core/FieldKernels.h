@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstddef>
+
+namespace cfd {
+
+/**
+ * @brief Summary of an array gathered in one pass
+ *
+ * NaN values are counted but excluded from min, max and sum; infinities
+ * are included. An empty (or all-NaN) array has min = +inf, max = -inf.
+ */
+struct FieldStatistics {
+    double min;
+    double max;
+    double sum;
+    std::size_t count;   // Values examined, including NaN
+    std::size_t numNaN;
+    std::size_t numInf;
+    
+    FieldStatistics();
+    
+    bool isValid() const { return numNaN == 0 && numInf == 0; }
+    double mean() const;  // Over non-NaN values; 0 if there are none
+    
+    // Combine with the statistics of another range
+    void merge(const FieldStatistics& other);
+};
+
+/**
+ * @brief Vectorized bulk kernels over contiguous double arrays
+ *
+ * The instruction set is chosen at compile time (AVX-512, AVX2, or a scalar
+ * fallback); Release builds use -march=native. Arrays of at least
+ * PARALLEL_THRESHOLD values are split into cache-line aligned chunks across
+ * OpenMP threads; inside an enclosing parallel region the kernels run on the
+ * calling thread. Interleaved kernels treat the array as tuples of
+ * numComponents values (1 <= numComponents <= MAX_COMPONENTS), as Field
+ * stores vector and tensor data.
+ *
+ * Every kernel has a float overload for reduced-precision fields: values
+ * are widened to double on load, computed in double and rounded once on
+ * store, so only the memory traffic is halved.
+ *
+ * Sums and dot products are compensated (see core/Reduction.h) and use a
+ * fixed blocking, so they give the same bits for any thread count; fused
+ * statistics use the same blocking without compensation. Results may
+ * differ in the last bits between instruction sets. NaN values are skipped
+ * by min/max (an all-NaN array gives +inf / -inf) and left unchanged by
+ * clamp.
+ */
+namespace kernels {
+
+constexpr std::size_t PARALLEL_THRESHOLD = std::size_t(1) << 16;
+constexpr int MAX_COMPONENTS = 9;
+
+// "AVX-512", "AVX2" or "scalar"
+const char* getInstructionSet();
+
+// Element-wise
+void fill(double* x, std::size_t n, double value);
+void fill(float* x, std::size_t n, double value);
+void scale(double* x, std::size_t n, double factor);
+void scale(float* x, std::size_t n, double factor);
+void add(double* x, const double* y, std::size_t n);        // x += y
+void add(float* x, const float* y, std::size_t n);
+void add(double* x, const float* y, std::size_t n);
+void add(float* x, const double* y, std::size_t n);
+void subtract(double* x, const double* y, std::size_t n);   // x -= y
+void subtract(float* x, const float* y, std::size_t n);
+void subtract(double* x, const float* y, std::size_t n);
+void subtract(float* x, const double* y, std::size_t n);
+void clamp(double* x, std::size_t n, double minVal, double maxVal);
+void clamp(float* x, std::size_t n, double minVal, double maxVal);
+
+// Reductions (n > 0)
+double min(const double* x, std::size_t n);
+double min(const float* x, std::size_t n);
+double max(const double* x, std::size_t n);
+double max(const float* x, std::size_t n);
+double sum(const double* x, std::size_t n);
+double sum(const float* x, std::size_t n);
+
+// Weighted sums: sum x[i] * w[i], or x[i * stride] * w[i] over n weights
+double dot(const double* x, const double* w, std::size_t n);
+double dot(const float* x, const double* w, std::size_t n);
+double dot(const double* x, std::size_t stride, const double* w, std::size_t n);
+double dot(const float* x, std::size_t stride, const double* w, std::size_t n);
+
+// Fused min / max / sum / NaN count / Inf count
+FieldStatistics statistics(const double* x, std::size_t n);
+FieldStatistics statistics(const float* x, std::size_t n);
+
+// Interleaved tuples: x[i * numComponents + c]
+void fillComponent(double* x, std::size_t numTuples, int numComponents, int component, double value);
+void fillComponent(float* x, std::size_t numTuples, int numComponents, int component, double value);
+void clampComponent(double* x, std::size_t numTuples, int numComponents, int component,
+                    double minVal, double maxVal);
+void clampComponent(float* x, std::size_t numTuples, int numComponents, int component,
+                    double minVal, double maxVal);
+
+/**
+ * @brief Per-component minimum and maximum in one pass (numTuples > 0)
+ *
+ * minOut and maxOut receive numComponents values each.
+ */
+void componentMinMax(const double* x, std::size_t numTuples, int numComponents,
+                     double* minOut, double* maxOut);
+void componentMinMax(const float* x, std::size_t numTuples, int numComponents,
+                     double* minOut, double* maxOut);
+
+} // namespace kernels
+
+} // namespace cfd
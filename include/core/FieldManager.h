@@ -7,20 +7,190 @@
 
 namespace cfd {
 
+/**
+ * @brief Stable integer handle to a field registered in a FieldManager
+ *
+ * Ids index a slot vector, so lookup is O(1) with no string compares.
+ * An id stays valid until its field is removed; re-registering a name
+ * keeps its id. Default-constructed ids are invalid.
+ */
+class FieldId {
+public:
+    FieldId() : index(-1) {}
+    explicit FieldId(int index_) : index(index_) {}
+    
+    int getIndex() const { return index; }
+    bool isValid() const { return index >= 0; }
+    
+    bool operator==(const FieldId& other) const { return index == other.index; }
+    bool operator!=(const FieldId& other) const { return index != other.index; }
+    
+private:
+    int index;
+};
+
+/**
+ * @brief FieldId whose field type was checked when the handle was issued
+ *
+ * Lets module interfaces state which kind of field they expect.
+ */
+template <FieldType Type>
+class TypedFieldId : public FieldId {
+public:
+    static constexpr FieldType TYPE = Type;
+    
+    TypedFieldId() {}
+    
+private:
+    friend class FieldManager;
+    explicit TypedFieldId(FieldId id) : FieldId(id) {}
+};
+
+using ScalarFieldId = TypedFieldId<FieldType::SCALAR>;
+using VectorFieldId = TypedFieldId<FieldType::VECTOR>;
+using TensorFieldId = TypedFieldId<FieldType::TENSOR>;
+
+/**
+ * @brief Memory report filled by FieldManager::getTotalMemoryUsage
+ *
+ * Arena figures are zero unless arena mode is enabled.
+ */
+struct FieldMemoryUsage {
+    size_t fieldBytes = 0;        // Registered fields
+    size_t oldTimeBytes = 0;      // Old time levels (included in fieldBytes)
+    size_t scratchBytes = 0;      // Scratch pool, idle or checked out
+    size_t peakBytes = 0;         // Highest fieldBytes + scratchBytes so far
+    
+    // Float-precision fields and the bytes they save against double storage
+    // (equally, the traffic saved by each full sweep over them)
+    int numFloatFields = 0;
+    size_t floatSavedBytes = 0;
+    
+    bool arenaEnabled = false;
+    size_t arenaCapacity = 0;
+    size_t arenaUsedBytes = 0;
+    size_t arenaPeakBytes = 0;
+    size_t arenaLargestFreeBlock = 0;
+    int arenaChunks = 0;
+    double arenaFragmentation = 0.0;  // See FieldArena::getFragmentation
+};
+
+class FieldManager;
+
+/**
+ * @brief Checked-out scratch field; returns itself to the pool when destroyed
+ *
+ * Move-only. The field has the manager's current cell count and unspecified
+ * contents. Handles must be released before the manager is resized or
+ * destroyed.
+ */
+class ScratchField {
+public:
+    ScratchField() : manager(nullptr) {}
+    ~ScratchField() { release(); }
+    
+    ScratchField(ScratchField&& other) noexcept;
+    ScratchField& operator=(ScratchField&& other) noexcept;
+    ScratchField(const ScratchField&) = delete;
+    ScratchField& operator=(const ScratchField&) = delete;
+    
+    Field& get() const { return *field; }
+    Field& operator*() const { return *field; }
+    Field* operator->() const { return field.get(); }
+    bool isValid() const { return field != nullptr; }
+    
+    // Return the field to the pool now
+    void release();
+    
+private:
+    friend class FieldManager;
+    ScratchField(FieldManager* manager_, std::unique_ptr<Field> field_)
+        : manager(manager_), field(std::move(field_)) {}
+    
+    FieldManager* manager;
+    std::unique_ptr<Field> field;
+};
+
 /**
  * @brief Manager for all field variables in the simulation
+ *
+ * Fields are addressed by name for setup and by FieldId in solver code.
+ *
+ * A field may keep old time levels (setNumOldTimeLevels) for transient
+ * schemes. advanceTimeLevels() shifts them by swapping storage, so no values
+ * are copied per step.
+ *
+ * By default every field owns a separate heap allocation. In arena mode
+ * (enableArena) all fields and scratch fields are laid out back to back in
+ * one FieldArena of aligned slabs; resize() and compactArena() rebuild the
+ * arena in a single allocation instead of reallocating field by field.
  */
 class FieldManager {
 public:
     FieldManager();
     
-    // Field registration and access
-    void registerField(const std::string& name, FieldType type, int size);
+    // Field registration. Registering an existing name replaces the field
+    // but keeps its id.
+    // FLOAT precision halves storage and traffic for fields that tolerate
+    // it (species mass fractions, turbulence quantities). BLOCKED layout
+    // suits vector and tensor fields that are mostly processed per component.
+    FieldId registerField(const std::string& name, FieldType type, label size,
+                          FieldPrecision precision = FieldPrecision::DOUBLE,
+                          FieldLayout layout = FieldLayout::INTERLEAVED);
+    ScalarFieldId registerScalarField(const std::string& name, label size,
+                                      FieldPrecision precision = FieldPrecision::DOUBLE);
+    VectorFieldId registerVectorField(const std::string& name, label size,
+                                      FieldPrecision precision = FieldPrecision::DOUBLE,
+                                      FieldLayout layout = FieldLayout::INTERLEAVED);
+    
+    // Existing field (type must match, else std::invalid_argument) or a new one
+    FieldId findOrRegisterField(const std::string& name, FieldType type, label size);
+    ScalarFieldId findOrRegisterScalarField(const std::string& name, label size);
+    VectorFieldId findOrRegisterVectorField(const std::string& name, label size);
+    
+    // Handle lookup by name; throws std::runtime_error if missing and
+    // std::invalid_argument on a type mismatch
+    FieldId getFieldId(const std::string& name) const;
+    ScalarFieldId getScalarFieldId(const std::string& name) const;
+    VectorFieldId getVectorFieldId(const std::string& name) const;
+    
+    // O(1) access by handle; throws std::out_of_range for invalid or removed ids
+    Field& getField(FieldId id) {
+        if (!hasField(id)) throwInvalidId(id);
+        return *slots[id.getIndex()];
+    }
+    const Field& getField(FieldId id) const {
+        if (!hasField(id)) throwInvalidId(id);
+        return *slots[id.getIndex()];
+    }
+    bool hasField(FieldId id) const {
+        return id.getIndex() >= 0 && id.getIndex() < static_cast<int>(slots.size()) && slots[id.getIndex()];
+    }
+    
+    // Access by name (map lookup; prefer ids in per-step code)
     Field& getField(const std::string& name);
     const Field& getField(const std::string& name) const;
     bool hasField(const std::string& name) const;
     
-    // Field removal
+    // Old time levels: level 1 holds phi^n, level 2 phi^{n-1}, and so on,
+    // named "<name>_0", "<name>_0_0", ... New levels start as copies of the
+    // current values; 0 drops them all. Re-registering a field keeps the
+    // count and restarts the levels from the new values.
+    void setNumOldTimeLevels(FieldId id, int numOldLevels);
+    int getNumOldTimeLevels(FieldId id) const;
+    
+    // Read-only view of an old level; throws std::out_of_range unless
+    // 1 <= level <= getNumOldTimeLevels(id). The reference stays valid
+    // across advanceTimeLevels() and always shows the given level.
+    const Field& getOldField(FieldId id, int level = 1) const;
+    
+    // Open a new time step: every field with old levels shifts them back by
+    // one and its current values become level 1. Storage is rotated, not
+    // copied; the current field then holds the values dropped from the
+    // oldest level, so the step must write it in full (from level 1).
+    void advanceTimeLevels();
+    
+    // Field removal. Removed ids are not reused.
     void removeField(const std::string& name);
     void clearAll();
     
@@ -28,23 +198,68 @@ public:
     std::vector<std::string> getFieldNames() const;
     std::vector<std::string> getScalarFieldNames() const;
     std::vector<std::string> getVectorFieldNames() const;
-    int getNumFields() const { return static_cast<int>(fields.size()); }
+    int getNumFields() const { return static_cast<int>(ids.size()); }
     
     // Bulk operations
     void fillAll(double value);
     void scaleAll(double factor);
     
-    // Validation
+    // Reorder every field after a mesh cell renumbering (new id -> old id)
+    void permuteCells(const std::vector<label>& newToOld);
+    
+    // Validation. All fields are swept once, in parallel over fields and
+    // over blocks of cells.
     bool validateAll() const;
     std::vector<std::string> getInvalidFields() const;
+    std::map<std::string, FieldStatistics> computeStatistics() const;
+    
+    // Memory management. Returns the bytes held by registered fields and, if
+    // usage is given, fills in scratch, peak and arena figures.
+    size_t getTotalMemoryUsage(FieldMemoryUsage* usage = nullptr) const;
+    void resize(label newSize);
+    
+    // Move all fields into one arena of at least capacityBytes (default:
+    // exactly what the current fields and scratch pool need). Fields
+    // registered later are placed in the arena too.
+    void enableArena(size_t capacityBytes = 0);
+    bool isArenaEnabled() const { return arena != nullptr; }
+    
+    // Rebuild the arena without the gaps left by removed or replaced fields
+    void compactArena();
     
-    // Memory management
-    size_t getTotalMemoryUsage() const;
-    void resize(int newSize);
+    // Scratch fields for per-step temporaries. Returned fields are kept and
+    // handed out again, so steady-state checkout does not allocate.
+    ScratchField checkoutScratch(FieldType type, FieldLayout layout = FieldLayout::INTERLEAVED);
+    int getNumScratchFields() const { return numScratchFields; }
+    int getNumScratchInUse() const { return numScratchInUse; }
     
 private:
-    std::map<std::string, std::unique_ptr<Field>> fields;
-    int currentSize;
+    friend class ScratchField;
+    
+    // Declared before the fields so it is destroyed after them
+    std::unique_ptr<FieldArena> arena;
+    
+    std::vector<std::unique_ptr<Field>> slots;  // Indexed by FieldId; null once removed
+    std::map<std::string, FieldId> ids;          // Name -> id, in name order
+    std::vector<std::vector<std::unique_ptr<Field>>> oldTimes;  // Indexed by FieldId, then level - 1
+    label currentSize;
+    
+    std::vector<std::unique_ptr<Field>> scratchPool;  // Idle scratch fields
+    int numScratchFields;
+    int numScratchInUse;
+    size_t scratchBytes;
+    size_t peakBytes;
+    
+    ArenaAllocator<double> getAllocator() const { return ArenaAllocator<double>(arena.get()); }
+    void returnScratch(std::unique_ptr<Field> field);
+    void rebuildArena(label newSize, size_t capacityBytes);
+    void updatePeak();
+    std::unique_ptr<Field> makeOldLevel(const Field& field, int level) const;
+    
+    template <FieldType Type>
+    TypedFieldId<Type> checkType(FieldId id, const std::string& name) const;
+    
+    [[noreturn]] static void throwInvalidId(FieldId id);
 };
 
 } // namespace cfd
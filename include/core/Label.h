@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+namespace cfd {
+
+/**
+ * @brief Index type for mesh entities, connectivity entries and field cells
+ *
+ * 32-bit by default, which keeps connectivity tables compact. Configure with
+ * -DCFD_LABEL_64=ON for meshes with more than 2^31 - 1 nodes, faces, cells or
+ * connectivity entries. Field offsets (cell * components) are computed in
+ * size_t whichever width is chosen.
+ */
+#ifdef CFD_LABEL_64
+using label = std::int64_t;
+#else
+using label = std::int32_t;
+#endif
+
+constexpr label LABEL_MAX = std::numeric_limits<label>::max();
+
+/**
+ * @brief Narrow a container size to label, throwing std::overflow_error if
+ * it does not fit (for example a 32-bit build given too large a mesh)
+ */
+inline label toLabel(std::size_t n) {
+    if (n > static_cast<std::size_t>(LABEL_MAX)) {
+        throw std::overflow_error("Size " + std::to_string(n) + " exceeds the " +
+                                  std::to_string(8 * sizeof(label)) +
+                                  "-bit label range; rebuild with CFD_LABEL_64=ON");
+    }
+    return static_cast<label>(n);
+}
+
+} // namespace cfd
@@ -1,10 +1,13 @@
 #pragma once
 
 #include "core/Vector3D.h"
+#include "core/Label.h"
+#include "core/Connectivity.h"
+#include "core/AlignedAllocator.h"
+#include <cassert>
 #include <vector>
 #include <map>
 #include <string>
-#include <set>
 
 namespace cfd {
 
@@ -12,22 +15,22 @@ namespace cfd {
  * @brief Node (vertex) in the mesh
  */
 struct Node {
-    int id;
+    label id;
     Vector3D position;
-    std::vector<int> connectedCells;  // Cells sharing this node
     
     Node() : id(-1) {}
-    Node(int id_, const Vector3D& pos) : id(id_), position(pos) {}
+    Node(label id_, const Vector3D& pos) : id(id_), position(pos) {}
 };
 
 /**
  * @brief Face connecting cells
+ *
+ * Face nodes live in Mesh::faceNodes (CSR), not in the face itself.
  */
 struct Face {
-    int id;
-    std::vector<int> nodeIds;
-    int ownerCell;
-    int neighborCell;  // -1 for boundary faces
+    label id;
+    label ownerCell;
+    label neighborCell;  // -1 for boundary faces
     Vector3D normal;
     Vector3D centroid;
     double area;
@@ -39,33 +42,71 @@ struct Face {
 
 /**
  * @brief Cell (control volume) in the mesh
+ *
+ * Cell faces and neighbours live in Mesh::cellFaces / Mesh::cellNeighbors (CSR).
  */
 struct Cell {
-    int id;
-    std::vector<int> faceIds;
-    std::vector<int> neighborCells;  // Neighboring cell IDs
+    label id;
     Vector3D centroid;
     double volume;
     
     Cell() : id(-1), volume(0.0) {}
-    
-    int getNumFaces() const { return static_cast<int>(faceIds.size()); }
-    int getNumNeighbors() const { return static_cast<int>(neighborCells.size()); }
 };
 
 /**
  * @brief Boundary patch (collection of boundary faces)
+ *
+ * When the mesh faces are ordered (Mesh::hasOrderedFaces()), the patch
+ * owns the contiguous face range [startFace, startFace + numFaces) and
+ * faceIds lists the same ids.
  */
 struct BoundaryPatch {
     std::string name;
     std::string type;  // "wall", "inlet", "outlet", "symmetry"
-    std::vector<int> faceIds;
+    std::vector<label> faceIds;
+    label startFace = -1;
+    label numFaces = 0;
     
     BoundaryPatch() {}
     BoundaryPatch(const std::string& name_, const std::string& type_)
         : name(name_), type(type_) {}
 };
 
+/**
+ * @brief Structure-of-arrays copy of face and cell geometry
+ *
+ * Each array is 64-byte aligned and indexed by face or cell id, so flux and
+ * cell kernels stream only the components they use.
+ */
+struct MeshGeometry {
+    // Face area vectors (normal * area) and centroids
+    AlignedVector<double> faceAreaX, faceAreaY, faceAreaZ;
+    AlignedVector<double> faceCentroidX, faceCentroidY, faceCentroidZ;
+    
+    // Cell centroids and volumes
+    AlignedVector<double> cellCentroidX, cellCentroidY, cellCentroidZ;
+    AlignedVector<double> cellVolume;
+    AlignedVector<double> cellInvVolume;
+    
+    // Finite-volume face factors, shared by every transport equation. With
+    // d = C_N - C_P (C_f - C_P on boundary faces) and n the unit normal:
+    //   faceWeight       phi_f = w phi_P + (1 - w) phi_N (1 on boundary faces)
+    //   faceDeltaCoeff   1 / (n . d), limited to 1 / (0.05 |d|)
+    //   faceNonOrth*     n - d * faceDeltaCoeff; zero on orthogonal faces
+    //   faceLaplacianCoeff  |S_f| * faceDeltaCoeff, the orthogonal diffusion
+    //                       coefficient per unit diffusivity
+    AlignedVector<double> faceWeight;
+    AlignedVector<double> faceDeltaCoeff;
+    AlignedVector<double> faceLaplacianCoeff;
+    AlignedVector<double> faceNonOrthX, faceNonOrthY, faceNonOrthZ;
+    
+    label getNumFaces() const { return static_cast<label>(faceAreaX.size()); }
+    label getNumCells() const { return static_cast<label>(cellVolume.size()); }
+    
+    void resize(label numFaces, label numCells);
+    void clear();
+};
+
 /**
  * @brief Mesh class containing nodes, faces, cells, and connectivity
  */
@@ -75,42 +116,127 @@ public:
     ~Mesh();
     
     // Accessors
-    int getNumNodes() const { return static_cast<int>(nodes.size()); }
-    int getNumCells() const { return static_cast<int>(cells.size()); }
-    int getNumFaces() const { return static_cast<int>(faces.size()); }
-    int getNumBoundaryFaces() const;
-    int getNumInternalFaces() const;
+    label getNumNodes() const { return static_cast<label>(nodes.size()); }
+    label getNumCells() const { return static_cast<label>(cells.size()); }
+    label getNumFaces() const { return static_cast<label>(faces.size()); }
+    label getNumBoundaryFaces() const;  // O(1) when faces are ordered
+    label getNumInternalFaces() const;  // O(1) when faces are ordered
+    
+    const Node& getNode(label id) const { return nodes[id]; }
+    const Cell& getCell(label id) const { return cells[id]; }
+    const Face& getFace(label id) const { return faces[id]; }
     
-    const Node& getNode(int id) const { return nodes[id]; }
-    const Cell& getCell(int id) const { return cells[id]; }
-    const Face& getFace(int id) const { return faces[id]; }
+    Node& getNode(label id) { return nodes[id]; }
+    Cell& getCell(label id) { return cells[id]; }
+    Face& getFace(label id) { return faces[id]; }
     
-    Node& getNode(int id) { return nodes[id]; }
-    Cell& getCell(int id) { return cells[id]; }
-    Face& getFace(int id) { return faces[id]; }
+    // Connectivity queries (copying; kept for API compatibility). Before
+    // buildConnectivity() neighbours and node cells are empty.
+    std::vector<label> getCellNeighbors(label cellId) const;
+    std::vector<label> getNodeCells(label nodeId) const;
+    std::vector<label> getCellFaces(label cellId) const;
     
-    // Connectivity queries
-    std::vector<int> getCellNeighbors(int cellId) const;
-    std::vector<int> getNodeCells(int nodeId) const;
-    std::vector<int> getCellFaces(int cellId) const;
+    // Zero-copy connectivity views into the CSR tables. Ids are only
+    // bounds-checked in debug builds; prefer these inside solver loops.
+    Span<const label> getCellNeighborsView(label cellId) const {
+        assert(cellId >= 0 && cellId < cellNeighbors.getNumRows());
+        return cellNeighbors.row(cellId);
+    }
+    Span<const label> getNodeCellsView(label nodeId) const {
+        assert(nodeId >= 0 && nodeId < nodeCells.getNumRows());
+        return nodeCells.row(nodeId);
+    }
+    Span<const label> getCellFacesView(label cellId) const {
+        assert(cellId >= 0 && cellId < cellFaces.getNumRows());
+        return cellFaces.row(cellId);
+    }
+    Span<const label> getFaceNodesView(label faceId) const {
+        assert(faceId >= 0 && faceId < faceNodes.getNumRows());
+        return faceNodes.row(faceId);
+    }
     
     // Geometric computations
-    void computeFaceGeometry(int faceId);
-    void computeCellGeometry(int cellId);
+    void computeFaceGeometry(label faceId);
+    void computeCellGeometry(label cellId);
     void computeAllGeometry();
     
+    /**
+     * @brief Fill the finite-volume face factors in MeshGeometry
+     *
+     * Called by computeAllGeometry(); updateGeometry() refreshes only the
+     * faces of moved cells. Requires face and cell geometry.
+     */
+    void computeFaceFactors();
+    
+    // Mesh motion. Moved nodes are recorded so that updateGeometry() only
+    // recomputes the faces and cells around them.
+    void setNodePosition(label nodeId, const Vector3D& position);
+    void translateNodes(const std::vector<label>& nodeIds, const Vector3D& offset);  // Distinct ids
+    void markNodeMoved(label nodeId);  // After writing nodes[nodeId].position directly
+    bool hasMovedNodes() const { return !movedNodes.empty(); }
+    const std::vector<label>& getMovedNodes() const { return movedNodes; }
+    
+    /**
+     * @brief Recompute geometry of the faces and cells touching moved nodes
+     *
+     * Cost scales with the moved region. Falls back to computeAllGeometry()
+     * if geometry was never computed or node -> cell connectivity is not
+     * built. Returns the number of cells recomputed.
+     */
+    label updateGeometry();
+    
+    // Incremented whenever geometry is (re)computed, updated or permuted;
+    // caches derived from geometry (search trees, matrices) compare it
+    unsigned long getGeometryVersion() const { return geometryVersion; }
+    
     // Mesh building
-    int addNode(const Vector3D& position);
-    int addCell(const std::vector<int>& faceIds);
-    int addFace(const std::vector<int>& nodeIds, int owner, int neighbor = -1);
+    label addNode(const Vector3D& position);
+    label addCell(const std::vector<label>& faceIds);
+    label addFace(const std::vector<label>& nodeIds, label owner, label neighbor = -1);
     void addBoundaryPatch(const std::string& name, const std::string& type);
-    void assignFaceToBoundary(int faceId, const std::string& patchName);
+    void assignFaceToBoundary(label faceId, const std::string& patchName);
     
     // Connectivity building
     void buildConnectivity();
     void buildCellNeighbors();
     void buildNodeCellConnectivity();
     
+    /**
+     * @brief Relabel nodes, faces and cells (each list maps new id -> old id)
+     *
+     * Topology, boundary patch face lists and computed geometry follow the
+     * new numbering. Internal faces are flipped where needed so that
+     * ownerCell < neighborCell. Cell/node connectivity is rebuilt if it had
+     * been built before.
+     */
+    void permute(const std::vector<label>& cellNewToOld,
+                 const std::vector<label>& faceNewToOld,
+                 const std::vector<label>& nodeNewToOld);
+    
+    /**
+     * @brief Face ordering: internal faces first, then one contiguous block per patch
+     *
+     * Internal faces are sorted by (owner, neighbor) under the cell numbering
+     * given by cellNewToOld (empty = current numbering). Each patch follows in
+     * name order, sorted by owner; boundary faces in no patch come last.
+     * Returns the new face id -> old face id list.
+     */
+    std::vector<label> computeOrderedFaceList(const std::vector<label>& cellNewToOld = {}) const;
+    
+    // Reorder faces into the layout above (cells and nodes keep their ids)
+    void orderFaces();
+    
+    /**
+     * @brief Check whether the current face layout is ordered and cache the
+     * internal face count and patch ranges if so. Called by permute(); faces
+     * added or assigned to patches afterwards clear the ordered state.
+     */
+    bool updateFaceOrdering();
+    bool hasOrderedFaces() const { return facesOrdered; }
+    
+    // Matrix bandwidth of the cell graph: max |owner - neighbor| over internal faces
+    label computeBandwidth() const;
+    
     // Validation
     bool validate() const;
     
@@ -120,13 +246,40 @@ public:
     std::vector<Face> faces;
     std::map<std::string, BoundaryPatch> boundaries;
     
+    // Compressed-sparse-row topology
+    CSRConnectivity faceNodes;      // face -> nodes, filled by addFace()
+    CSRConnectivity cellFaces;      // cell -> faces, filled by addCell()
+    CSRConnectivity cellNeighbors;  // cell -> cells, built by buildConnectivity()
+    CSRConnectivity nodeCells;      // node -> cells, built by buildConnectivity()
+    
+    // SoA geometry, filled by computeAllGeometry()
+    MeshGeometry geometry;
+    
 private:
+    // Face ordering state (valid when facesOrdered)
+    bool facesOrdered;
+    label numInternalFaces;
+    unsigned long geometryVersion;
+    
+    // Nodes moved since the last geometry update
+    std::vector<char> nodeMovedFlags;
+    std::vector<label> movedNodes;
+    std::vector<char> cellUpdateMarks;  // Scratch for updateGeometry(), all zero between calls
+    std::vector<char> faceUpdateMarks;
+    
     // Helper methods
     Vector3D computeFaceCentroid(const Face& face) const;
     Vector3D computeFaceNormal(const Face& face) const;
     double computeFaceArea(const Face& face) const;
     Vector3D computeCellCentroid(const Cell& cell) const;
     double computeCellVolume(const Cell& cell) const;
+    
+    // Copy AoS geometry of one element into the SoA arrays
+    void storeFaceGeometry(label faceId);
+    void storeCellGeometry(label cellId);
+    void storeFaceFactors(label faceId);
+    
+    void clearMovedNodes();
 };
 
 } // namespace cfd
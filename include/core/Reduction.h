@@ -0,0 +1,89 @@
+#pragma once
+
+#include "core/FieldKernels.h"
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+#include <omp.h>
+
+namespace cfd {
+
+/**
+ * @brief Running sum with an error term (Knuth's TwoSum)
+ *
+ * Every add captures the rounding error of the sum exactly; the errors are
+ * accumulated separately and folded in by result(). The result is accurate
+ * to about one rounding of the true sum, independent of the number of
+ * terms, as long as the error terms themselves do not cancel badly.
+ *
+ * Relies on strict IEEE evaluation; do not build with -ffast-math.
+ */
+struct CompensatedSum {
+    double sum = 0.0;
+    double error = 0.0;
+
+    void add(double x) {
+        double t = sum + x;
+        double z = t - sum;
+        error += (sum - (t - z)) + (x - z);
+        sum = t;
+    }
+    void add(const CompensatedSum& other) {
+        add(other.sum);
+        error += other.error;
+    }
+    double result() const { return sum + error; }
+};
+
+/**
+ * @brief Deterministic parallel reduction over [0, n)
+ *
+ * The range is cut into blocks of REDUCTION_BLOCK indices whatever the
+ * thread count; blockFn(begin, end) reduces one block and the partials are
+ * merged in block order. The result is therefore bitwise identical for any
+ * number of threads, and for serial and parallel runs. Blocks are spread
+ * over OpenMP threads for n >= PARALLEL_THRESHOLD outside a parallel region;
+ * inside one the calling thread does all blocks.
+ */
+constexpr std::size_t REDUCTION_BLOCK = 4096;
+
+template <typename Partial, typename BlockFn, typename MergeFn>
+Partial reduceBlocks(std::size_t n, Partial identity, BlockFn blockFn, MergeFn merge) {
+    const std::size_t numBlocks = (n + REDUCTION_BLOCK - 1) / REDUCTION_BLOCK;
+    Partial result = identity;
+    if (n < kernels::PARALLEL_THRESHOLD || omp_in_parallel()) {
+        for (std::size_t b = 0; b < numBlocks; ++b) {
+            merge(result, blockFn(b * REDUCTION_BLOCK, std::min(n, (b + 1) * REDUCTION_BLOCK)));
+        }
+        return result;
+    }
+
+    std::vector<Partial> partial(numBlocks, identity);
+    const long numBlocksLong = static_cast<long>(numBlocks);
+    #pragma omp parallel for schedule(static)
+    for (long b = 0; b < numBlocksLong; ++b) {
+        const std::size_t begin = static_cast<std::size_t>(b) * REDUCTION_BLOCK;
+        partial[b] = blockFn(begin, std::min(n, begin + REDUCTION_BLOCK));
+    }
+    for (const Partial& p : partial) {
+        merge(result, p);
+    }
+    return result;
+}
+
+// Compensated, reproducible sum of term(i) for i in [0, n)
+template <typename Term>
+double reproducibleSum(std::size_t n, Term term) {
+    CompensatedSum total = reduceBlocks(n, CompensatedSum(),
+        [&](std::size_t begin, std::size_t end) {
+            CompensatedSum block;
+            for (std::size_t i = begin; i < end; ++i) {
+                block.add(term(i));
+            }
+            return block;
+        },
+        [](CompensatedSum& into, const CompensatedSum& block) { into.add(block); });
+    return total.result();
+}
+
+} // namespace cfd
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+
+namespace cfd {
+
+/**
+ * @brief Non-owning view of a contiguous array (C++17 stand-in for std::span)
+ */
+template <typename T>
+class Span {
+public:
+    Span() : ptr(nullptr), count(0) {}
+    Span(T* data_, std::size_t size_) : ptr(data_), count(size_) {}
+    
+    // Span<T> -> Span<const T>
+    template <typename U, typename = std::enable_if_t<std::is_convertible<U*, T*>::value>>
+    Span(const Span<U>& other) : ptr(other.data()), count(other.size()) {}
+
+    // Element access (bounds-checked in debug builds only)
+    T& operator[](std::size_t i) const {
+        assert(i < count);
+        return ptr[i];
+    }
+    T* data() const { return ptr; }
+
+    // Size queries
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    // Iteration
+    T* begin() const { return ptr; }
+    T* end() const { return ptr + count; }
+
+private:
+    T* ptr;
+    std::size_t count;
+};
+
+} // namespace cfd
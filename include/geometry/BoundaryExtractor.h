@@ -13,7 +13,7 @@ namespace cfd {
  */
 struct BoundaryRegion {
     std::string name;
-    std::vector<int> triangleIndices;
+    std::vector<label> triangleIndices;
     Vector3D averageNormal;
     Vector3D centroid;
     double totalArea;
@@ -60,7 +60,7 @@ private:
     // Helper methods
     bool normalsAreSimilar(const Vector3D& n1, const Vector3D& n2, double angleTolerance) const;
     std::string generateNameFromNormal(const Vector3D& normal) const;
-    void assignTriangleToRegion(int triangleIndex, const Triangle& tri, int regionIndex);
+    void assignTriangleToRegion(label triangleIndex, const Triangle& tri, int regionIndex);
 };
 
 } // namespace cfd
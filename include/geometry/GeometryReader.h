@@ -1,5 +1,6 @@
 #pragma once
 
+#include "core/Label.h"
 #include "core/Vector3D.h"
 #include <vector>
 #include <string>
@@ -47,7 +48,7 @@ struct Surface {
     Surface() {}
     Surface(const std::string& name_) : name(name_) {}
     
-    int getNumTriangles() const { return static_cast<int>(triangles.size()); }
+    label getNumTriangles() const { return static_cast<label>(triangles.size()); }
     void addTriangle(const Triangle& tri) { triangles.push_back(tri); }
 };
 
@@ -98,7 +99,7 @@ public:
     virtual bool validate() const = 0;
     
     // Common functionality
-    int getNumTriangles() const;
+    label getNumTriangles() const;
     void scale(double factor);
     void translate(const Vector3D& offset);
     
@@ -45,9 +45,9 @@ struct GeometryError {
  * @brief Edge representation for manifold checking
  */
 struct Edge {
-    int v0, v1;  // Vertex indices (ordered: v0 < v1)
+    label v0, v1;  // Vertex indices (ordered: v0 < v1)
     
-    Edge(int a, int b) {
+    Edge(label a, label b) {
         v0 = std::min(a, b);
         v1 = std::max(a, b);
     }
@@ -85,9 +85,9 @@ public:
     void clearErrors() { errors.clear(); }
     
     // Statistics
-    int getTotalTriangles() const { return totalTriangles; }
-    int getTotalEdges() const { return totalEdges; }
-    int getTotalVertices() const { return totalVertices; }
+    label getTotalTriangles() const { return totalTriangles; }
+    label getTotalEdges() const { return totalEdges; }
+    label getTotalVertices() const { return totalVertices; }
     
     // Tolerance settings
     void setDegeneracyTolerance(double tol) { degeneracyTolerance = tol; }
@@ -98,21 +98,21 @@ private:
     double degeneracyTolerance;
     double normalTolerance;
     
-    int totalTriangles;
-    int totalEdges;
-    int totalVertices;
+    label totalTriangles;
+    label totalEdges;
+    label totalVertices;
     
     // Helper methods
     void buildVertexMap(const std::vector<Surface>& surfaces,
-                       std::map<Vector3D, int>& vertexMap,
+                       std::map<Vector3D, label>& vertexMap,
                        std::vector<Vector3D>& vertices);
     
     void buildEdgeMap(const std::vector<Surface>& surfaces,
-                     const std::map<Vector3D, int>& vertexMap,
+                     const std::map<Vector3D, label>& vertexMap,
                      std::map<Edge, int>& edgeCount);
     
-    int getVertexIndex(const Vector3D& v, std::map<Vector3D, int>& vertexMap,
-                      std::vector<Vector3D>& vertices);
+    label getVertexIndex(const Vector3D& v, std::map<Vector3D, label>& vertexMap,
+                        std::vector<Vector3D>& vertices);
     
     bool vectorsEqual(const Vector3D& v1, const Vector3D& v2, double tol = 1e-9) const;
 };
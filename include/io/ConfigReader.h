@@ -26,6 +26,8 @@ struct GeometryConfig {
 struct MeshConfig {
     double baseSize = 0.5;
     int boundaryLayers = 0;
+    std::string renumbering = "rcm";
+    std::string file = "mesh.cfdmesh";  // Native binary mesh (MeshFile)
 };
 
 struct SimulationTimingConfig {
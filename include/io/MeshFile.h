@@ -0,0 +1,93 @@
+#pragma once
+
+#include "core/Mesh.h"
+#include <cstdint>
+#include <string>
+
+namespace cfd {
+
+/**
+ * @brief Native binary mesh file (".cfdmesh")
+ *
+ * Versioned, little-endian image of a finished Mesh: CSR topology, face
+ * owner/neighbour, node positions, boundary patches and precomputed
+ * geometry. Every array is stored as a 64-byte aligned section, so the
+ * reader maps the file read-only and bulk-copies each section into place
+ * without parsing or rebuilding connectivity and geometry.
+ *
+ * The finite-volume face factors are stored too, so nothing geometric is
+ * recomputed on load. The load is still not zero-copy: Mesh owns its
+ * arrays, so every section is copied out of the mapping and the
+ * per-element Face/Cell records are refilled. That costs about 0.4 s per
+ * million cells on one core (bench_mesh_io), several seconds at 10M cells,
+ * against about 3 s per million cells for a rebuild from element lists.
+ * Offsets, indices, face cells and patch faces are range-checked, so a
+ * corrupt file throws instead of reading out of bounds.
+ */
+class MeshFile {
+public:
+    static constexpr char MAGIC[8] = {'C', 'F', 'D', 'M', 'E', 'S', 'H', '\0'};
+    static constexpr uint32_t FORMAT_VERSION = 2;
+    static constexpr uint32_t ENDIAN_TAG = 0x01020304;
+
+    // Header flags
+    static constexpr uint32_t FLAG_FACES_ORDERED = 1u << 0;
+    static constexpr uint32_t FLAG_CONNECTIVITY = 1u << 1;
+    static constexpr uint32_t FLAG_GEOMETRY = 1u << 2;
+    static constexpr uint32_t FLAG_FACE_FACTORS = 1u << 3;
+
+    enum Section : uint32_t {
+        NODE_POSITIONS,    // double[3 * numNodes], interleaved xyz
+        FACE_OWNER,        // label[numFaces]
+        FACE_NEIGHBOR,     // label[numFaces]
+        FACE_NODE_OFFSETS,
+        FACE_NODE_INDICES,
+        CELL_FACE_OFFSETS,
+        CELL_FACE_INDICES,
+        CELL_NEIGHBOR_OFFSETS,
+        CELL_NEIGHBOR_INDICES,
+        NODE_CELL_OFFSETS,
+        NODE_CELL_INDICES,
+        FACE_NORMAL,       // double[3 * numFaces], interleaved xyz
+        FACE_AREA,         // double[numFaces]
+        FACE_AREA_X, FACE_AREA_Y, FACE_AREA_Z,
+        FACE_CENTROID_X, FACE_CENTROID_Y, FACE_CENTROID_Z,
+        CELL_CENTROID_X, CELL_CENTROID_Y, CELL_CENTROID_Z,
+        CELL_VOLUME,
+        CELL_INV_VOLUME,
+        FACE_WEIGHT, FACE_DELTA_COEFF, FACE_LAPLACIAN_COEFF,
+        FACE_NON_ORTH_X, FACE_NON_ORTH_Y, FACE_NON_ORTH_Z,
+        PATCHES,           // Patch table, see MeshFile.cpp
+        NUM_SECTIONS
+    };
+
+    struct Header {
+        char magic[8];
+        uint32_t version;
+        uint32_t endianTag;
+        uint32_t labelBytes;
+        uint32_t flags;
+        uint64_t numNodes;
+        uint64_t numFaces;
+        uint64_t numCells;
+        uint64_t numPatches;
+        uint64_t sectionOffset[NUM_SECTIONS];
+        uint64_t sectionBytes[NUM_SECTIONS];
+    };
+
+    /**
+     * @brief Write a mesh. Geometry missing from the SoA arrays is taken
+     * from the per-face/per-cell values. Throws std::runtime_error on I/O
+     * failure or on a big-endian host.
+     */
+    static void write(const Mesh& mesh, const std::string& path);
+
+    /**
+     * @brief Map a mesh file read-only and load it. Throws
+     * std::runtime_error if the file is missing, truncated, inconsistent
+     * or has an unsupported version, byte order or label size.
+     */
+    static Mesh read(const std::string& path);
+};
+
+} // namespace cfd
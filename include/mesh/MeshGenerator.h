@@ -2,6 +2,7 @@
 
 #include "core/Mesh.h"
 #include "geometry/GeometryReader.h"
+#include "mesh/MeshRenumbering.h"
 #include <vector>
 #include <memory>
 
@@ -22,6 +23,9 @@ struct MeshParams {
         double size;
     };
     std::vector<RefinementRegion> refinementRegions;
+    
+    // Cell renumbering for cache locality: "none", "rcm", "morton", "hilbert"
+    std::string renumbering = "rcm";
 };
 
 /**
@@ -36,8 +40,8 @@ struct MeshQualityMetrics {
     double avgAspectRatio = 0.0;
     double minSkewness = 0.0;
     double maxSkewness = 0.0;
-    int numCells = 0;
-    int numBadCells = 0;
+    label numCells = 0;
+    label numBadCells = 0;
 };
 
 /**
@@ -54,13 +58,26 @@ public:
     
     // Generation
     bool generate();
-    Mesh getMesh() const { return mesh; }
+    const Mesh& getMesh() const { return mesh; }  // Valid while the generator lives
+    
+    /**
+     * @brief Structured hexahedral mesh of an axis-aligned box
+     *
+     * Boundary faces are assigned to patches "xmin", "xmax", "ymin",
+     * "ymax", "zmin" and "zmax". Connectivity and geometry are built and
+     * faces are ordered (Mesh::orderFaces()).
+     */
+    static Mesh createBoxMesh(int nx, int ny, int nz,
+                              const Vector3D& minCorner, const Vector3D& maxCorner);
     
     // Quality assessment
     MeshQualityMetrics getQualityMetrics() const;
     
     // Status
     bool isGenerated() const { return generated; }
+    const RenumberingReport& getRenumberingReport() const { return renumberingReport; }
+    // Cells marked by refineRegions(), ascending ids of the final mesh
+    const std::vector<label>& getRefinementCells() const { return refinementCells; }
     std::string getLastError() const { return lastError; }
     
 private:
@@ -69,6 +86,8 @@ private:
     Mesh mesh;
     bool generated;
     std::string lastError;
+    RenumberingReport renumberingReport;
+    std::vector<label> refinementCells;
     
     // Internal generation steps
     bool generateSurfaceMesh();
@@ -16,9 +16,9 @@ public:
     void computeMetrics(const Mesh& mesh);
     
     // Individual metrics
-    double computeCellAspectRatio(const Mesh& mesh, int cellId) const;
-    double computeCellSkewness(const Mesh& mesh, int cellId) const;
-    double computeFaceAngle(const Mesh& mesh, int faceId) const;
+    double computeCellAspectRatio(const Mesh& mesh, label cellId) const;
+    double computeCellSkewness(const Mesh& mesh, label cellId) const;
+    double computeFaceAngle(const Mesh& mesh, label faceId) const;
     
     // Statistics
     double getMinAspectRatio() const { return minAspectRatio; }
@@ -29,7 +29,7 @@ public:
     double getMaxSkewness() const { return maxSkewness; }
     double getAvgSkewness() const { return avgSkewness; }
     
-    int getNumBadCells() const { return numBadCells; }
+    label getNumBadCells() const { return numBadCells; }
     
     // Quality thresholds
     void setAspectRatioThreshold(double threshold) { aspectRatioThreshold = threshold; }
@@ -41,7 +41,7 @@ public:
 private:
     double minAspectRatio, maxAspectRatio, avgAspectRatio;
     double minSkewness, maxSkewness, avgSkewness;
-    int numBadCells;
+    label numBadCells;
     
     double aspectRatioThreshold;
     double skewnessThreshold;
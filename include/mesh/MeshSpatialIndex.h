@@ -0,0 +1,88 @@
+#pragma once
+
+#include "core/Mesh.h"
+#include "geometry/GeometryReader.h"
+#include <vector>
+
+namespace cfd {
+
+/**
+ * @brief Bounding volume hierarchy over mesh cells
+ *
+ * Each leaf holds up to LEAF_SIZE cells and is bounded by the union of their
+ * node bounding boxes. Cells are split at the median centroid along the
+ * longest axis, so the tree shape depends only on the cell count and can be
+ * built in parallel into preallocated preorder slots. When nodes move,
+ * refit() updates the boxes without changing the tree.
+ *
+ * Radius and nearest-neighbour queries measure distance to cell centroids.
+ * They need Mesh::computeAllGeometry(); findCell() also needs face normals.
+ */
+class MeshSpatialIndex {
+public:
+    static constexpr int LEAF_SIZE = 8;
+
+    MeshSpatialIndex() {}
+    explicit MeshSpatialIndex(const Mesh& mesh) { build(mesh); }
+
+    /**
+     * @brief Build the hierarchy from the mesh's cell bounds and centroids
+     */
+    void build(const Mesh& mesh);
+
+    /**
+     * @brief Recompute the boxes and centroids after nodes have moved
+     *
+     * The topology must be unchanged since build(). Throws
+     * std::invalid_argument if the cell count differs.
+     */
+    void refit(const Mesh& mesh);
+
+    void clear();
+    bool isBuilt() const { return !nodes.empty(); }
+    label getNumCells() const { return static_cast<label>(cellIds.size()); }
+    label getNumTreeNodes() const { return static_cast<label>(nodes.size()); }
+
+    /**
+     * @brief Cells with centroid strictly within @p radius of @p point,
+     * in ascending cell order
+     */
+    std::vector<label> findCellsInRadius(const Vector3D& point, double radius) const;
+
+    /**
+     * @brief The @p k cells with the nearest centroids, closest first
+     */
+    std::vector<label> findNearestCells(const Vector3D& point, int k) const;
+
+    /**
+     * @brief Cell containing @p point, or -1 if it lies outside the mesh
+     */
+    label findCell(const Mesh& mesh, const Vector3D& point) const;
+
+    /**
+     * @brief Point-in-cell test against the cell's face planes (convex cells)
+     */
+    static bool cellContains(const Mesh& mesh, label cellId, const Vector3D& point, double tolerance = 1e-12);
+
+private:
+    struct TreeNode {
+        BoundingBox box;
+        label begin = 0;        // Range in cellIds
+        label end = 0;
+        label rightChild = -1;  // Left child is the next node; -1 for leaves
+
+        bool isLeaf() const { return rightChild < 0; }
+    };
+
+    std::vector<TreeNode> nodes;         // Preorder
+    std::vector<label> cellIds;          // Cells in leaf order
+    std::vector<Vector3D> centroids;     // Centroids in leaf order
+    std::vector<BoundingBox> cellBoxes;  // Cell bounds in leaf order
+
+    static label countTreeNodes(label numCells);
+    void buildSubtree(label nodeIndex, label begin, label end);
+    void computeCellBounds(const Mesh& mesh);
+    void refitNodes();
+};
+
+} // namespace cfd
@@ -4,6 +4,7 @@
 #include "core/FieldManager.h"
 #include "solver/FluidDynamics.h"
 #include "solver/ThermodynamicProperties.h"
+#include "solver/TimeStepController.h"
 #include "turbulence/TurbulenceModel.h"
 #include "combustion/CombustionModel.h"
 #include "chemistry/ChemistryIntegrator.h"
@@ -14,13 +15,16 @@ namespace cfd {
 struct SimulationConfig {
     double startTime = 0.0;
     double endTime = 0.01;
-    double timeStep = 1e-6;
+    double timeStep = 1e-6;            // Fixed step, or the first step when adaptive
+    bool adaptiveTimeStep = false;     // Courant-controlled steps (limits below)
+    TimeStepLimits timeStepLimits;
     double outputInterval = 1e-4;
     double checkpointInterval = 1e-3;
     std::string turbulenceModel = "k-epsilon";
     std::string combustionModel = "flamelet";
     int maxIterations = 100;
     double convergenceTolerance = 1e-6;
+    bool matrixFree = false;  // Apply implicit operators without assembled matrices
 };
 
 struct InitialConditions {
@@ -39,26 +43,52 @@ public:
     void setInitialConditions(const InitialConditions& ic);
     bool solve();
     void writeOutput(double time);
+    void writeCheckpoint(double time);
+    
+    // Spark ignition for the combustion model; limits the step once burning
+    void setSpark(const SparkConfig& spark);
+    
+    // Mixture species, after initialize(): each gets a FLOAT mass-fraction
+    // field "Y_<name>" and enters the thermodynamics in the order added.
+    // InitialConditions::massFractions follows the same order.
+    void addSpecies(const Species& species);
     
     double getCurrentTime() const { return currentTime; }
     int getCurrentIteration() const { return currentIteration; }
+    double getLastTimeStep() const { return lastTimeStep; }
+    double getSmallestTimeStep() const { return smallestTimeStep; }  // Over the run so far
+    const FieldManager& getFields() const { return fields; }
     
 private:
     const Mesh* mesh;
     SimulationConfig config;
     FieldManager fields;
     
+    // Handles to the primary fields, resolved once in initialize()
+    VectorFieldId velocityId;
+    ScalarFieldId pressureId;
+    ScalarFieldId temperatureId;
+    ScalarFieldId densityId;
+    
     std::unique_ptr<FluidDynamics> fluidSolver;
     std::unique_ptr<TurbulenceModel> turbulenceModel;
     std::unique_ptr<CombustionModel> combustionModel;
     std::unique_ptr<ChemistryIntegrator> chemistryIntegrator;
     std::unique_ptr<ThermodynamicProperties> thermo;
+    std::vector<ScalarFieldId> speciesIds;    // Mass fractions, in thermo's species order
+    std::vector<const Field*> speciesFields;  // The same fields, refreshed before each use
     
     double currentTime;
     int currentIteration;
+    double lastTimeStep;
+    double proposedTimeStep;  // Controller's last step before fitting to sync times
+    double smallestTimeStep;
+    TimeStepController timeStepController;
+    double minCellSize;  // Cube root of the smallest cell volume
     
     // Time integration
     void advanceTimeStep(double dt);
+    double physicsTimeStepLimit() const;
     void updateThermodynamics();
     bool checkConvergence();
     
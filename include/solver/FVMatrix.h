@@ -0,0 +1,143 @@
+#pragma once
+
+#include "core/Mesh.h"
+#include "core/Connectivity.h"
+#include "core/AlignedAllocator.h"
+#include "solver/LinearSolver.h"
+#include <vector>
+
+namespace cfd {
+
+/**
+ * @brief Sparsity pattern of a mesh's finite-volume matrices
+ *
+ * Built once per mesh and shared by every FVMatrix on it. In LDU form
+ * internal face i couples lowerAddr[i] (owner) and upperAddr[i]
+ * (neighbour). The same pattern is also kept row-wise (CSR): row c lists
+ * the cells coupled to c in ascending order, and entry k reads coefficient
+ * rowCoeffs[k] of the matrix's offDiag array. Boundary faces are grouped
+ * by owner cell in the same way. Row-wise loops (products, diagonal
+ * collection) therefore write only to their own cell and need no atomics.
+ */
+class FVAddressing {
+public:
+    std::vector<label> internalFaces;   // Internal face i -> mesh face id
+    std::vector<label> lowerAddr;       // Owner cell of internal face i
+    std::vector<label> upperAddr;       // Neighbour cell of internal face i
+    std::vector<label> boundaryFaces;   // Boundary face b -> mesh face id
+
+    CSRConnectivity rows;               // Cell -> coupled cells, ascending
+    std::vector<label> rowCoeffs;       // Per row entry: index into offDiag
+    CSRConnectivity cellBoundaryFaces;  // Cell -> boundary face indices b
+
+    FVAddressing() : numCells(0) {}
+    explicit FVAddressing(const Mesh& mesh) { build(mesh); }
+
+    void build(const Mesh& mesh);
+
+    label getNumCells() const { return numCells; }
+    label getNumInternalFaces() const { return static_cast<label>(lowerAddr.size()); }
+    label getNumBoundaryFaces() const { return static_cast<label>(boundaryFaces.size()); }
+
+    // Same cell and face counts as mesh (pattern still usable)
+    bool matches(const Mesh& mesh) const;
+
+    size_t getMemoryUsage() const;
+
+private:
+    label numCells;
+};
+
+/**
+ * @brief Finite-volume matrix in LDU form on a shared FVAddressing
+ *
+ * Coefficients of the equation A x = source:
+ *   diag[c]                     row c, column c
+ *   upper()[i] = offDiag[i]     row owner, column neighbour of internal face i
+ *   lower()[i] = offDiag[nI+i]  row neighbour, column owner
+ *   boundaryDiag/Source[b]      added to the owner row of boundary face b
+ *
+ * Storage is sized when the addressing is set and reused for every
+ * assembly, so refilling allocates nothing. An assembly runs:
+ *   1. zero()
+ *   2. fillInternalFaces() / fillBoundaryFaces(): parallel face loops in
+ *      which every face writes only its own coefficients
+ *   3. collectDiagonal(): parallel cell loop gathering the face terms into
+ *      diag and source
+ *   4. cell-local terms (time derivative, sources) written directly
+ *
+ * collectDiagonal() uses the conservative-flux identity of FV operators:
+ * a face's contribution to the owner diagonal is -lower and to the
+ * neighbour diagonal -upper. Matrices whose diagonal is not built that way
+ * write diag directly instead.
+ */
+class FVMatrix : public LinearOperator {
+public:
+    AlignedVector<double> diag;
+    AlignedVector<double> offDiag;
+    AlignedVector<double> source;
+    AlignedVector<double> boundaryDiag;
+    AlignedVector<double> boundarySource;
+
+    FVMatrix() : addressing(nullptr) {}
+    explicit FVMatrix(const FVAddressing& addressing_) : addressing(nullptr) { setAddressing(addressing_); }
+
+    // Size the coefficient arrays for addressing (no-op if unchanged)
+    void setAddressing(const FVAddressing& addressing_);
+    const FVAddressing& getAddressing() const { return *addressing; }
+    label getNumCells() const { return static_cast<label>(diag.size()); }
+
+    double* upper() { return offDiag.data(); }
+    double* lower() { return offDiag.data() + offDiag.size() / 2; }
+    const double* upper() const { return offDiag.data(); }
+    const double* lower() const { return offDiag.data() + offDiag.size() / 2; }
+
+    void zero();
+    
+    // Release the coefficient storage (setAddressing() sizes it again)
+    void clear();
+
+    // fn(i, meshFaceId, upper, lower) for every internal face i, in parallel
+    template <typename FaceFn>
+    void fillInternalFaces(FaceFn fn) {
+        const label numFaces = addressing->getNumInternalFaces();
+        double* up = upper();
+        double* lo = lower();
+        #pragma omp parallel for schedule(static)
+        for (label i = 0; i < numFaces; ++i) {
+            fn(i, addressing->internalFaces[i], up[i], lo[i]);
+        }
+    }
+
+    // fn(b, meshFaceId, boundaryDiag, boundarySource) for every boundary face b
+    template <typename FaceFn>
+    void fillBoundaryFaces(FaceFn fn) {
+        const label numFaces = addressing->getNumBoundaryFaces();
+        #pragma omp parallel for schedule(static)
+        for (label b = 0; b < numFaces; ++b) {
+            fn(b, addressing->boundaryFaces[b], boundaryDiag[b], boundarySource[b]);
+        }
+    }
+
+    // diag -= column sums of offDiag; diag / source += boundary terms
+    void collectDiagonal();
+
+    // y = A x and r = source - A x (x, y, r hold getNumCells() values)
+    void multiply(const double* x, double* y) const;
+    void residual(const double* x, double* r) const;
+
+    bool isSymmetric(double tolerance = 0.0) const;
+
+    // LinearOperator
+    label getSize() const override { return getNumCells(); }
+    void apply(const double* x, double* y) const override { multiply(x, y); }
+    void getDiagonal(double* diagonal) const override;
+
+    // Bytes of coefficient storage (the shared addressing not included)
+    size_t getMemoryUsage() const;
+
+private:
+    const FVAddressing* addressing;
+};
+
+} // namespace cfd
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "core/Mesh.h"
+#include "solver/FVMatrix.h"
+#include "solver/LinearSolver.h"
+
+namespace cfd {
+
+/**
+ * @brief Matrix-free implicit transport operator
+ *
+ * Applies the operator an FVMatrix would hold for a transport equation,
+ *   cell terms + upwind convection of massFlux - laplacian(diffusivity),
+ * without storing off-diagonal coefficients: apply() recomputes each face
+ * coefficient from the face flux and the geometry cached in
+ * mesh.geometry. Only the diagonal is stored, for the cell terms and for
+ * Jacobi preconditioning, so the storage is one value per cell instead of
+ * the diagonal, two coefficients per internal face and the boundary terms.
+ *
+ * The face loop is row-wise over the shared FVAddressing, one cell per
+ * thread. Coefficients match FluidDynamics' assembled momentum matrix:
+ *   upper = -D + min(F, 0), lower = -D - max(F, 0), D = Gamma_f faceLaplacianCoeff
+ * with Gamma_f linearly interpolated from the cell diffusivity, and the
+ * boundary flux F added to the owner diagonal (zero gradient).
+ *
+ * The flux and diffusivity arrays are referenced, not copied: they must
+ * stay alive and unchanged while the operator is used. One operator
+ * serves every equation with the same flux and diffusivity (all velocity
+ * components, for example).
+ */
+class FVTransportOperator : public LinearOperator {
+public:
+    AlignedVector<double> diag;
+
+    FVTransportOperator() : mesh(nullptr), addressing(nullptr), massFlux(nullptr), diffusivity(nullptr) {}
+
+    void setAddressing(const Mesh& mesh, const FVAddressing& addressing);
+
+    // massFlux per mesh face (out of the owner), diffusivity per cell.
+    // Recomputes the face part of diag; cell-local terms (time derivative,
+    // implicit sources) are then added to diag directly.
+    void update(const double* massFlux, const double* diffusivity);
+
+    // LinearOperator
+    label getSize() const override { return static_cast<label>(diag.size()); }
+    void apply(const double* x, double* y) const override;
+    void getDiagonal(double* diagonal) const override;
+
+    // Bytes of coefficient storage (the diagonal)
+    size_t getMemoryUsage() const { return diag.capacity() * sizeof(double); }
+
+private:
+    const Mesh* mesh;
+    const FVAddressing* addressing;
+    const double* massFlux;
+    const double* diffusivity;
+};
+
+} // namespace cfd
@@ -2,6 +2,10 @@
 
 #include "core/Mesh.h"
 #include "core/FieldManager.h"
+#include "solver/FVMatrix.h"
+#include "solver/FVTransportOperator.h"
+#include "solver/LinearSolver.h"
+#include "solver/AMGPreconditioner.h"
 #include "solver/ThermodynamicProperties.h"
 
 namespace cfd {
@@ -17,6 +21,11 @@ public:
     void initialize(const Mesh& mesh, FieldManager& fields);
     void setThermodynamicProperties(ThermodynamicProperties* thermo);
     
+    // Matrix-free mode: the momentum operator is applied from the face
+    // fluxes instead of being assembled, and only its diagonal is stored
+    void setMatrixFree(bool matrixFree);
+    bool isMatrixFree() const { return matrixFree; }
+    
     // Solver steps
     void computeMomentum(FieldManager& fields, double dt);
     void solvePressureCorrection(FieldManager& fields);
@@ -26,19 +35,67 @@ public:
     // Diagnostics
     double getMaxCourantNumber() const { return maxCourantNumber; }
     
+    // Matrices assembled by the last step. Momentum has one matrix for all
+    // velocity components (sources excluded), assembled or matrix-free;
+    // pressure is the correction Poisson equation.
+    const FVAddressing& getAddressing() const { return addressing; }
+    const FVMatrix& getMomentumMatrix() const { return momentumMatrix; }
+    const FVTransportOperator& getMomentumOperator() const { return momentumOperator; }
+    const LinearOperator& getMomentumSystem() const;  // Whichever of the two is in use
+    const FVMatrix& getPressureMatrix() const { return pressureMatrix; }
+    const AlignedVector<double>& getMassFlux() const { return massFlux; }
+    
+    // Pressure correction p' of the last step and its PCG/AMG solve
+    const AlignedVector<double>& getPressureCorrection() const { return pressureCorrection; }
+    const SolverPerformance& getPressurePerformance() const { return pressurePerformance; }
+    const AMGPreconditioner& getPressurePreconditioner() const { return pressureAMG; }
+    PCGSolver& getPressureSolver() { return pressureSolver; }
+    
 private:
     const Mesh* mesh;
     ThermodynamicProperties* thermo;
     double maxCourantNumber;
+    double timeStep;
+    bool matrixFree;
+    
+    // Pattern built once in initialize(); coefficient storage reused each step
+    FVAddressing addressing;
+    FVMatrix momentumMatrix;               // Empty in matrix-free mode
+    FVTransportOperator momentumOperator;  // Diagonal only; empty when assembled
+    FVMatrix pressureMatrix;
+    AlignedVector<double> massFlux;  // rho_f U_f . S_f per mesh face, out of the owner
+    AlignedVector<double> cellViscosity;
+    std::vector<unsigned char> fixedPressureFace;  // Per boundary face: on an outlet patch
+    std::vector<unsigned char> closedFace;         // Per boundary face: wall or symmetry (no flux)
+    bool hasFixedPressure;
+    
+    // The pressure matrix depends only on the geometry: it and the AMG
+    // hierarchy are rebuilt on the first solve and whenever the mesh
+    // geometry version changes
+    PCGSolver pressureSolver;
+    AMGPreconditioner pressureAMG;
+    unsigned long pressureGeometryVersion;  // Mesh geometry the matrix was assembled for
+    AlignedVector<double> pressureCorrection;
+    SolverPerformance pressurePerformance;
+    
+    // Field handles, resolved in initialize()
+    VectorFieldId velocityId;
+    ScalarFieldId pressureId;
+    ScalarFieldId densityId;
+    ScalarFieldId temperatureId;
     
-    // Convection schemes
-    double computeConvectiveFlux(int faceId, const Field& phi, const Field& velocity);
-    double computeDiffusiveFlux(int faceId, const Field& phi);
+    // Convection schemes. Both read the face factors cached in
+    // mesh->geometry (see Mesh::computeFaceFactors()).
+    double computeConvectiveFlux(label faceId, const Field& phi, const Field& velocity);  // Upwind
+    double computeDiffusiveFlux(label faceId, const Field& phi);  // Orthogonal part, per unit diffusivity
     
     // SIMPLE algorithm helpers
-    void assembleM omentumMatrix();
-    void assemblePressureMatrix();
-    void correctVelocity();
+    void computeMassFlux(const FieldManager& fields);
+    void computeViscosity(const FieldManager& fields);
+    void assembleMomentumMatrix(const FieldManager& fields, double dt);  // Euler + upwind + diffusion
+    void updateMomentumOperator(const FieldManager& fields, double dt);  // Same terms, matrix-free
+    void assemblePressureMatrix();  // Coefficients; geometric only
+    void assemblePressureSource(double dt);  // -div(massFlux) / dt
 };
 
 } // namespace cfd
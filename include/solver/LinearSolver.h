@@ -0,0 +1,103 @@
+#pragma once
+
+#include "core/Label.h"
+#include "core/AlignedAllocator.h"
+
+namespace cfd {
+
+/**
+ * @brief Square operator y = A x for the Krylov solvers
+ *
+ * Implemented by FVMatrix; anything that can apply itself and report its
+ * diagonal (for Jacobi preconditioning) can be solved.
+ */
+class LinearOperator {
+public:
+    virtual ~LinearOperator() = default;
+
+    virtual label getSize() const = 0;
+    virtual void apply(const double* x, double* y) const = 0;
+    virtual void getDiagonal(double* diagonal) const = 0;
+};
+
+/**
+ * @brief Approximate inverse z = M^-1 r applied once per Krylov iteration
+ *
+ * PCG needs a symmetric positive definite M. The interface is apply()
+ * only: each concrete preconditioner has its own setup(...) from the
+ * matrix, called before solve(), so the (possibly expensive) preparation
+ * can be kept across solves.
+ */
+class Preconditioner {
+public:
+    virtual ~Preconditioner() = default;
+
+    virtual void apply(const double* r, double* z) const = 0;
+};
+
+/**
+ * @brief Diagonal (Jacobi) preconditioner
+ */
+class JacobiPreconditioner : public Preconditioner {
+public:
+    void setup(const LinearOperator& A);
+    void apply(const double* r, double* z) const override;
+
+private:
+    AlignedVector<double> invDiagonal;
+};
+
+/**
+ * @brief Outcome of a linear solve; residuals are ||b - A x|| / ||b||
+ */
+struct SolverPerformance {
+    int iterations = 0;
+    double initialResidual = 0.0;
+    double finalResidual = 0.0;
+    bool converged = false;
+};
+
+/**
+ * @brief Preconditioned conjugate gradients for symmetric positive
+ * (semi-)definite operators
+ *
+ * Work vectors are kept between solves, so repeated solves of the same size
+ * do not allocate. Inner products use the reproducible kernels::dot, so
+ * the iterates do not depend on the thread count. A consistent singular
+ * system (pure Neumann pressure) converges to a solution in the range of A.
+ */
+class PCGSolver {
+public:
+    double relativeTolerance;  // Stop when ||r|| <= relativeTolerance * ||b||
+    int maxIterations;
+
+    PCGSolver() : relativeTolerance(1e-8), maxIterations(1000) {}
+
+    // x holds the initial guess on entry and the solution on return
+    SolverPerformance solve(const LinearOperator& A, const Preconditioner& M, const double* b, double* x);
+
+private:
+    AlignedVector<double> r, z, p, q;
+};
+
+/**
+ * @brief Right-preconditioned BiCGStab for non-symmetric operators
+ *
+ * Used for transport equations with upwind convection, where PCG does not
+ * apply. Same conventions as PCGSolver: relative residuals, reproducible
+ * inner products and work vectors kept between solves.
+ */
+class BiCGStabSolver {
+public:
+    double relativeTolerance;
+    int maxIterations;
+
+    BiCGStabSolver() : relativeTolerance(1e-8), maxIterations(1000) {}
+
+    SolverPerformance solve(const LinearOperator& A, const Preconditioner& M, const double* b, double* x);
+
+private:
+    AlignedVector<double> r, r0, p, v, s, t, pHat, sHat;
+};
+
+} // namespace cfd
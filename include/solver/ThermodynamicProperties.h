@@ -1,6 +1,8 @@
 #pragma once
 
 #include "chemistry/Species.h"
+#include "core/Field.h"
+#include "core/Label.h"
 #include <vector>
 #include <memory>
 
@@ -8,6 +10,16 @@ namespace cfd {
 
 /**
  * @brief Thermodynamic properties for gas mixtures
+ *
+ * The per-cell functions take the mass fractions as a vector. The batched
+ * compute*() functions evaluate a cell range [begin, end) at once: T, p
+ * and the result are arrays indexed by cell id, and Y lists one scalar
+ * field per species (double or float storage) in species order, so mass
+ * fractions are read straight from the species fields. Cells are processed
+ * in fixed-size blocks on stack buffers, species outermost, so the inner
+ * loops run unit-stride over cells and vectorize; blocks are spread over
+ * OpenMP threads and nothing is allocated. Results match the per-cell
+ * functions to rounding.
  */
 class ThermodynamicProperties {
 public:
@@ -33,12 +45,37 @@ public:
     double computePressure(double rho, double T, const std::vector<double>& Y) const;
     double computeTemperature(double rho, double p, const std::vector<double>& Y) const;
     
+    // Batched mixture properties over cells [begin, end)
+    void computeDensity(const double* T, const double* p, const std::vector<const Field*>& Y,
+                        label begin, label end, double* rho) const;
+    void computeCp(const double* T, const std::vector<const Field*>& Y, label begin, label end, double* cp) const;
+    void computeEnthalpy(const double* T, const std::vector<const Field*>& Y, label begin, label end,
+                         double* h) const;
+    void computeViscosity(const double* T, const std::vector<const Field*>& Y, label begin, label end,
+                          double* mu) const;
+    
 private:
     std::vector<Species> species;
     
+    // Per-species constants for the batched functions, filled by addSpecies()
+    std::vector<double> speciesInvMW;      // 1 / MW
+    std::vector<double> speciesR;          // R / MW [J/kg/K]
+    std::vector<double> speciesTmid;
+    std::vector<double> speciesNASA;       // 14 per species: low then high range
+    
     // Universal gas constant
     static constexpr double R_universal = 8314.46;  // J/kmol/K
     
+    // Sutherland's law for air
+    static constexpr double sutherlandT0 = 273.15;     // K
+    static constexpr double sutherlandMu0 = 1.716e-5;  // Pa s
+    static constexpr double sutherlandS = 110.4;       // K
+    
+    // Mass-weighted sum over species of f(s, T) per cell in one block
+    template <typename SpeciesTerm>
+    void accumulateBlock(const double* T, const std::vector<const Field*>& Y, label begin, label n,
+                         SpeciesTerm term, double* sum) const;
+    
     // Viscosity mixing rules
     double computeViscosityWilke(double T, const std::vector<double>& Y) const;
     double getSutherlandViscosity(double T, double T0, double mu0, double S) const;
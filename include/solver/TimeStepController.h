@@ -0,0 +1,63 @@
+#pragma once
+
+namespace cfd {
+
+/**
+ * @brief Limits for adaptive time stepping
+ */
+struct TimeStepLimits {
+    double maxCourant = 0.5;    // Target maximum cell Courant number
+    double maxGrowth = 1.2;     // Largest ratio dt_new / dt_old
+    double minTimeStep = 1e-12;
+    double maxTimeStep = 1e-4;
+};
+
+/**
+ * @brief Chooses the next time step from the measured Courant number
+ *
+ * The Courant number scales linearly with dt, so the step that would give
+ * exactly maxCourant is dt * maxCourant / Co. The proposal is the smallest
+ * of that, the growth limit, any physics limits (combustion, chemistry)
+ * and maxTimeStep; it may shrink at once but grows by at most maxGrowth
+ * per step. Growth is measured from the previous proposal, so steps cut
+ * short by a sync time do not hold the step size back.
+ *
+ * The proposal is then fitted to the next sync time (output, checkpoint,
+ * end time): a step that would reach or pass it lands on it exactly, and
+ * a step that would leave a sliver shorter than itself is split into two
+ * equal parts. Sync times built independently (k * interval for output
+ * and checkpoints) may differ from each other by rounding only; a sync
+ * time within syncTolerance() of the current time counts as reached, so
+ * coinciding times are met by one step and no step is ever shorter than
+ * minTimeStep.
+ */
+class TimeStepController {
+public:
+    TimeStepController() = default;
+    explicit TimeStepController(const TimeStepLimits& limits_) : limits(limits_) {}
+    
+    const TimeStepLimits& getLimits() const { return limits; }
+    
+    // Step from the Courant number alone; courant was measured with lastDt
+    double courantLimitedStep(double lastDt, double courant) const;
+    
+    // Next step before sync times: lastDt is the step taken, courant its
+    // Courant number, lastProposal the previous proposal and physicsLimit
+    // the tightest limit from the physics modules
+    double proposeTimeStep(double lastDt, double courant, double lastProposal, double physicsLimit) const;
+    
+    // Shorten dt so that it lands on, or splits the approach to, syncTime.
+    // Sets landsOnSync if time + dt is meant to be exactly syncTime. A
+    // syncTime already reached leaves dt unchanged.
+    double fitToSyncTime(double time, double dt, double syncTime, bool& landsOnSync) const;
+    
+    // Closer than this to syncTime counts as on it: minTimeStep, or a few
+    // ulps of syncTime if larger
+    double syncTolerance(double syncTime) const;
+    bool isSyncReached(double time, double syncTime) const { return syncTime - time <= syncTolerance(syncTime); }
+    
+private:
+    TimeStepLimits limits;
+};
+
+} // namespace cfd
@@ -6,6 +6,10 @@ namespace cfd {
 
 /**
  * @brief Standard k-epsilon turbulence model
+ *
+ * k and epsilon are registered as FLOAT fields: they are stored in single
+ * precision and every update loads, computes and stores through value() /
+ * setValue() in double.
  */
 class KEpsilonModel : public TurbulenceModel {
 public:
@@ -28,6 +32,11 @@ private:
     double sigmaK = 1.0;
     double sigmaEps = 1.3;
     
+    // Field handles, resolved in initialize()
+    ScalarFieldId kId;
+    ScalarFieldId epsilonId;
+    ScalarFieldId densityId;
+    
     // Cached values
     std::vector<double> turbulentViscosity;
     
@@ -1,10 +1,13 @@
 #include "chemistry/ChemistryIntegrator.h"
 #include <algorithm>
+#include <cmath>
+#include <limits>
 
 namespace cfd {
 
 ChemistryIntegrator::ChemistryIntegrator() 
-    : ethanolFraction(0.0), heatRelease(0.0) {
+    : ethanolFraction(0.0), heatRelease(0.0),
+      chemicalTimeScale(std::numeric_limits<double>::max()), maxRelativeChange(0.1) {
 }
 
 void ChemistryIntegrator::loadMechanism(const std::string& chemkinFile) {
@@ -35,6 +38,13 @@ void ChemistryIntegrator::integrateExplicitEuler(double T, double p, std::vector
     // Simplified: assume constant density
     double rho = 1.0;  // Placeholder
     
+    // Shortest consumption time over the step's cells, for time-step control
+    for (size_t i = 0; i < Y.size() && i < omega.size(); ++i) {
+        if (omega[i] < 0.0 && Y[i] > 0.0) {
+            chemicalTimeScale = std::min(chemicalTimeScale, rho * Y[i] / std::abs(omega[i]));
+        }
+    }
+    
     for (size_t i = 0; i < Y.size(); ++i) {
         Y[i] += (omega[i] / rho) * dt;
         Y[i] = std::max(0.0, std::min(1.0, Y[i]));  // Clamp to [0,1]
@@ -51,6 +61,17 @@ void ChemistryIntegrator::integrateExplicitEuler(double T, double p, std::vector
     heatRelease = 0.0;  // Would compute from reaction enthalpies
 }
 
+void ChemistryIntegrator::beginStep() {
+    chemicalTimeScale = std::numeric_limits<double>::max();
+}
+
+double ChemistryIntegrator::getMaxTimeStep() const {
+    if (chemicalTimeScale == std::numeric_limits<double>::max()) {
+        return chemicalTimeScale;
+    }
+    return maxRelativeChange * chemicalTimeScale;
+}
+
 void ChemistryIntegrator::integrateImplicit(double T, double p, std::vector<double>& Y, double dt) {
     // Placeholder for implicit integration
     integrateExplicitEuler(T, p, Y, dt);
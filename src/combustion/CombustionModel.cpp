@@ -1,9 +1,11 @@
 #include "combustion/CombustionModel.h"
+#include <limits>
 
 namespace cfd {
 
 CombustionModel::CombustionModel() 
-    : heatReleaseRate(0.0), burnedMassFraction(0.0) {
+    : mesh(nullptr), indexGeometryVersion(0), heatReleaseRate(0.0), burnedMassFraction(0.0),
+      sparkInitialized(false), ignitionTime(0.0) {
 }
 
 void CombustionModel::initialize(const CombustionConfig& config_) {
@@ -13,6 +15,50 @@ void CombustionModel::initialize(const CombustionConfig& config_) {
 void CombustionModel::initializeSpark(const SparkConfig& spark, double time) {
     sparkIgnition.initialize(spark);
     flameTracker.initializeKernel(spark);
+    sparkInitialized = config.enableSpark;
+    ignitionTime = spark.ignitionTime;
+}
+
+void CombustionModel::setMesh(const Mesh& mesh_) {
+    mesh = &mesh_;
+    spatialIndex.build(*mesh);
+    indexGeometryVersion = mesh->getGeometryVersion();
+    sparkIgnition.setSpatialIndex(&spatialIndex);
+}
+
+void CombustionModel::applySpark(FieldManager& fields, double time) {
+    if (!mesh || !sparkInitialized || !sparkIgnition.isActive(time)) {
+        return;
+    }
+    if (mesh->getGeometryVersion() != indexGeometryVersion) {
+        // Moved nodes keep the tree; a changed cell count needs a rebuild
+        if (spatialIndex.getNumCells() == mesh->getNumCells()) {
+            spatialIndex.refit(*mesh);
+        } else {
+            spatialIndex.build(*mesh);
+        }
+        indexGeometryVersion = mesh->getGeometryVersion();
+    }
+    sparkIgnition.apply(fields, time, *mesh);
+}
+
+bool CombustionModel::isBurning(double time) const {
+    return sparkInitialized && time >= ignitionTime;
+}
+
+double CombustionModel::getMaxTimeStep(double time, double cellSize) const {
+    const double frontSpeed = flameTracker.getFrontSpeed();
+    if (!isBurning(time) || frontSpeed <= 0.0) {
+        return std::numeric_limits<double>::max();
+    }
+    return config.maxFlameCourant * cellSize / frontSpeed;
+}
+
+double CombustionModel::getNextEventTime(double time) const {
+    if (sparkInitialized && time < ignitionTime) {
+        return ignitionTime;
+    }
+    return std::numeric_limits<double>::max();
 }
 
 void CombustionModel::solve(FieldManager& fields, double dt) {
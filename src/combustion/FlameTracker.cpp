@@ -3,7 +3,7 @@
 
 namespace cfd {
 
-FlameTracker::FlameTracker() : kernelRadius(0.0) {
+FlameTracker::FlameTracker() : kernelRadius(0.0), frontSpeed(1.0) {
 }
 
 void FlameTracker::initializeKernel(const SparkConfig& spark) {
@@ -15,8 +15,8 @@ void FlameTracker::advectFlame(const FieldManager& fields, double dt) {
     // G-equation: dG/dt + u·∇G = St|∇G|
     // Simplified: grow kernel radius based on flame speed
     
-    double St = 1.0;  // m/s (placeholder turbulent flame speed)
-    kernelRadius += St * dt * 1000.0;  // Convert to mm
+    // frontSpeed: placeholder turbulent flame speed
+    kernelRadius += frontSpeed * dt * 1000.0;  // Convert to mm
 }
 
 double FlameTracker::getFlameSpeed(int cellId, const FieldManager& fields) const {
@@ -1,9 +1,10 @@
 #include "combustion/SparkIgnition.h"
 #include "core/Mesh.h"
+#include "mesh/MeshSpatialIndex.h"
 
 namespace cfd {
 
-SparkIgnition::SparkIgnition() : applied(false) {
+SparkIgnition::SparkIgnition() : applied(false), spatialIndex(nullptr) {
 }
 
 void SparkIgnition::initialize(const SparkConfig& config_) {
@@ -27,16 +28,27 @@ bool SparkIgnition::isActive(double time) const {
 void SparkIgnition::depositEnergy(FieldManager& fields, const Mesh& mesh) {
     Field& temperature = fields.getField("temperature");
     
-    // Find cells within spark kernel radius
-    for (int i = 0; i < mesh.getNumCells(); ++i) {
+    for (label i : findKernelCells(mesh)) {
+        // Deposit energy as temperature rise
+        temperature(i) += 500.0;  // K (simplified)
+    }
+}
+
+std::vector<label> SparkIgnition::findKernelCells(const Mesh& mesh) const {
+    if (spatialIndex && spatialIndex->getNumCells() == mesh.getNumCells()) {
+        return spatialIndex->findCellsInRadius(config.location, config.kernelRadius);
+    }
+    
+    // No index: scan every cell
+    std::vector<label> kernelCells;
+    for (label i = 0; i < mesh.getNumCells(); ++i) {
         const Cell& cell = mesh.getCell(i);
         double dist = (cell.centroid - config.location).magnitude();
-        
         if (dist < config.kernelRadius) {
-            // Deposit energy as temperature rise
-            temperature(i) += 500.0;  // K (simplified)
+            kernelCells.push_back(i);
         }
     }
+    return kernelCells;
 }
 
 } // namespace cfd
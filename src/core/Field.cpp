@@ -4,36 +4,54 @@
 #include <numeric>
 #include <cmath>
 #include <limits>
+#include <type_traits>
 
 namespace cfd {
 
-Field::Field(const std::string& name_, FieldType type_, int size)
-    : name(name_), type(type_) {
-    int components = getNumComponents();
-    data.resize(size * components, 0.0);
+Field::Field(const std::string& name_, FieldType type_, label size,
+             FieldPrecision precision_, FieldLayout layout_, const ArenaAllocator<double>& allocator)
+    : name(name_), type(type_), precision(precision_), layout(layout_), data(allocator), floatData(allocator) {
+    size_t numValues = static_cast<size_t>(size) * getNumComponents();
+    if (isFloat()) {
+        floatData.resize(numValues, 0.0f);
+    } else {
+        data.resize(numValues, 0.0);
+    }
+    updateStrides();
 }
 
 Field::Field(const Field& other)
-    : name(other.name), type(other.type), data(other.data) {
+    : name(other.name), type(other.type), precision(other.precision), layout(other.layout),
+      data(other.data), floatData(other.floatData),
+      cellStride(other.cellStride), componentStride(other.componentStride) {
 }
 
 Field& Field::operator=(const Field& other) {
     if (this != &other) {
         name = other.name;
         type = other.type;
+        precision = other.precision;
+        layout = other.layout;
         data = other.data;
+        floatData = other.floatData;
+        cellStride = other.cellStride;
+        componentStride = other.componentStride;
     }
     return *this;
 }
 
-double& Field::operator()(int cellId, int component) {
-    int components = getNumComponents();
-    return data[cellId * components + component];
+void Field::updateStrides() {
+    if (isBlocked()) {
+        cellStride = 1;
+        componentStride = static_cast<size_t>(getSize());
+    } else {
+        cellStride = static_cast<size_t>(getNumComponents());
+        componentStride = 1;
+    }
 }
 
-const double& Field::operator()(int cellId, int component) const {
-    int components = getNumComponents();
-    return data[cellId * components + component];
+void Field::throwFloatAccess() const {
+    throw std::logic_error("Field '" + name + "' is FLOAT; use value()/setValue() instead of operator()");
 }
 
 int Field::getNumComponents() const {
@@ -46,112 +64,258 @@ int Field::getNumComponents() const {
 }
 
 void Field::fill(double value) {
-    std::fill(data.begin(), data.end(), value);
+    dispatch([&](auto* x, size_t n) { kernels::fill(x, n, value); });
 }
 
 void Field::fillComponent(int component, double value) {
-    int components = getNumComponents();
-    int size = getSize();
-    for (int i = 0; i < size; ++i) {
-        data[i * components + component] = value;
-    }
+    dispatch([&](auto* x, size_t) {
+        if (isBlocked()) {
+            kernels::fill(x + component * componentStride, getSize(), value);
+        } else {
+            kernels::fillComponent(x, getSize(), getNumComponents(), component, value);
+        }
+    });
 }
 
 void Field::scale(double factor) {
-    for (auto& val : data) {
-        val *= factor;
-    }
+    dispatch([&](auto* x, size_t n) { kernels::scale(x, n, factor); });
 }
 
 void Field::add(const Field& other) {
-    if (data.size() != other.data.size()) {
+    if (getNumValues() != other.getNumValues()) {
         throw std::runtime_error("Field sizes do not match");
     }
-    for (size_t i = 0; i < data.size(); ++i) {
-        data[i] += other.data[i];
+    if (isBlocked() != other.isBlocked()) {
+        *this += expr::Term<Field>::make(other);
+        return;
     }
+    dispatch([&](auto* x, size_t n) {
+        other.dispatch([&](const auto* y, size_t) { kernels::add(x, y, n); });
+    });
 }
 
 void Field::subtract(const Field& other) {
-    if (data.size() != other.data.size()) {
+    if (getNumValues() != other.getNumValues()) {
         throw std::runtime_error("Field sizes do not match");
     }
-    for (size_t i = 0; i < data.size(); ++i) {
-        data[i] -= other.data[i];
+    if (isBlocked() != other.isBlocked()) {
+        *this -= expr::Term<Field>::make(other);
+        return;
+    }
+    dispatch([&](auto* x, size_t n) {
+        other.dispatch([&](const auto* y, size_t) { kernels::subtract(x, y, n); });
+    });
+}
+
+namespace {
+
+// Copy the leading min(oldCells, newCells) cells of every component
+template <typename Storage>
+void copyCells(const Storage& from, Storage& to, size_t numComponents, bool blocked,
+               size_t oldCells, size_t newCells) {
+    const size_t cells = std::min(oldCells, newCells);
+    if (!blocked) {
+        std::copy(from.begin(), from.begin() + cells * numComponents, to.begin());
+        return;
+    }
+    for (size_t c = 0; c < numComponents; ++c) {
+        std::copy(from.begin() + c * oldCells, from.begin() + c * oldCells + cells, to.begin() + c * newCells);
+    }
+}
+
+template <typename Storage>
+void transposeValues(Storage& values, size_t numCells, size_t numComponents, bool toBlocked) {
+    Storage result(values.size(), 0, values.get_allocator());
+    for (size_t cell = 0; cell < numCells; ++cell) {
+        for (size_t c = 0; c < numComponents; ++c) {
+            size_t interleaved = cell * numComponents + c;
+            size_t blocked = c * numCells + cell;
+            if (toBlocked) {
+                result[blocked] = values[interleaved];
+            } else {
+                result[interleaved] = values[blocked];
+            }
+        }
     }
+    values.swap(result);
+}
+
+// New cell i of every component takes old cell newToOld[i]
+template <typename Storage>
+void permuteValues(Storage& values, size_t cellStride, size_t componentStride, size_t numComponents,
+                   const std::vector<label>& newToOld) {
+    Storage permuted(values.size(), 0, values.get_allocator());
+    for (size_t i = 0; i < newToOld.size(); ++i) {
+        const size_t from = static_cast<size_t>(newToOld[i]) * cellStride;
+        const size_t to = i * cellStride;
+        for (size_t c = 0; c < numComponents; ++c) {
+            permuted[to + c * componentStride] = values[from + c * componentStride];
+        }
+    }
+    values.swap(permuted);
+}
+
+} // anonymous namespace
+
+void Field::resize(label numCells) {
+    if (!isBlocked()) {
+        // Interleaved values keep their positions; grow or shrink in place
+        size_t numValues = static_cast<size_t>(numCells) * getNumComponents();
+        if (isFloat()) {
+            floatData.resize(numValues, 0.0f);
+        } else {
+            data.resize(numValues, 0.0);
+        }
+        updateStrides();
+        return;
+    }
+    reallocate(numCells, data.get_allocator());
+}
+
+void Field::reallocate(label numCells, const ArenaAllocator<double>& allocator) {
+    const size_t nc = getNumComponents();
+    const size_t oldCells = static_cast<size_t>(getSize());
+    const size_t newCells = static_cast<size_t>(numCells);
+    
+    // Moving the fresh storage in adopts its allocator; the old buffers are
+    // released to their own allocator
+    auto move = [&](auto& values, bool active) {
+        std::decay_t<decltype(values)> fresh(active ? newCells * nc : 0, 0, allocator);
+        if (active) {
+            copyCells(values, fresh, nc, isBlocked(), oldCells, newCells);
+        }
+        values = std::move(fresh);
+    };
+    move(data, !isFloat());
+    move(floatData, isFloat());
+    updateStrides();
+}
+
+void Field::setLayout(FieldLayout newLayout) {
+    if (newLayout == layout) return;
+    
+    const bool wasBlocked = isBlocked();
+    layout = newLayout;
+    if (isBlocked() != wasBlocked) {
+        if (isFloat()) {
+            transposeValues(floatData, getSize(), getNumComponents(), isBlocked());
+        } else {
+            transposeValues(data, getSize(), getNumComponents(), isBlocked());
+        }
+    }
+    updateStrides();
+}
+
+void Field::permute(const std::vector<label>& newToOld) {
+    if (static_cast<label>(newToOld.size()) != getSize()) {
+        throw std::runtime_error("Permutation size does not match field size");
+    }
+    if (isFloat()) {
+        permuteValues(floatData, cellStride, componentStride, getNumComponents(), newToOld);
+    } else {
+        permuteValues(data, cellStride, componentStride, getNumComponents(), newToOld);
+    }
+}
+
+void Field::swapValues(Field& other) {
+    if (type != other.type || precision != other.precision || layout != other.layout ||
+        getNumValues() != other.getNumValues()) {
+        throw std::invalid_argument("Cannot swap values of differently shaped fields");
+    }
+    data.swap(other.data);
+    floatData.swap(other.floatData);
 }
 
 double Field::min() const {
-    if (data.empty()) return 0.0;
-    return *std::min_element(data.begin(), data.end());
+    if (getNumValues() == 0) return 0.0;
+    return dispatch([](const auto* x, size_t n) { return kernels::min(x, n); });
 }
 
 double Field::max() const {
-    if (data.empty()) return 0.0;
-    return *std::max_element(data.begin(), data.end());
+    if (getNumValues() == 0) return 0.0;
+    return dispatch([](const auto* x, size_t n) { return kernels::max(x, n); });
 }
 
 double Field::mean() const {
-    if (data.empty()) return 0.0;
-    double sum = std::accumulate(data.begin(), data.end(), 0.0);
-    return sum / static_cast<double>(data.size());
+    if (getNumValues() == 0) return 0.0;
+    return sum() / static_cast<double>(getNumValues());
+}
+
+double Field::sum() const {
+    if (getNumValues() == 0) return 0.0;
+    return dispatch([](const auto* x, size_t n) { return kernels::sum(x, n); });
+}
+
+double Field::weightedSum(const double* weights, int component) const {
+    if (getSize() == 0) return 0.0;
+    return dispatch([&](const auto* x, size_t) {
+        return kernels::dot(x + component * componentStride, cellStride, weights, getSize());
+    });
 }
 
 double Field::minComponent(int component) const {
-    int components = getNumComponents();
-    int size = getSize();
-    if (size == 0) return 0.0;
+    if (getSize() == 0) return 0.0;
     
-    double minVal = data[component];
-    for (int i = 1; i < size; ++i) {
-        minVal = std::min(minVal, data[i * components + component]);
+    if (isBlocked()) {
+        return dispatch([&](const auto* x, size_t) {
+            return kernels::min(x + component * componentStride, getSize());
+        });
     }
-    return minVal;
+    
+    // One pass yields every component; interleaved data is read in full either way
+    double minVals[kernels::MAX_COMPONENTS];
+    double maxVals[kernels::MAX_COMPONENTS];
+    dispatch([&](const auto* x, size_t) {
+        kernels::componentMinMax(x, getSize(), getNumComponents(), minVals, maxVals);
+    });
+    return minVals[component];
 }
 
 double Field::maxComponent(int component) const {
-    int components = getNumComponents();
-    int size = getSize();
-    if (size == 0) return 0.0;
+    if (getSize() == 0) return 0.0;
     
-    double maxVal = data[component];
-    for (int i = 1; i < size; ++i) {
-        maxVal = std::max(maxVal, data[i * components + component]);
+    if (isBlocked()) {
+        return dispatch([&](const auto* x, size_t) {
+            return kernels::max(x + component * componentStride, getSize());
+        });
     }
-    return maxVal;
+    
+    double minVals[kernels::MAX_COMPONENTS];
+    double maxVals[kernels::MAX_COMPONENTS];
+    dispatch([&](const auto* x, size_t) {
+        kernels::componentMinMax(x, getSize(), getNumComponents(), minVals, maxVals);
+    });
+    return maxVals[component];
 }
 
 void Field::clamp(double minVal, double maxVal) {
-    for (auto& val : data) {
-        val = std::max(minVal, std::min(maxVal, val));
-    }
+    dispatch([&](auto* x, size_t n) { kernels::clamp(x, n, minVal, maxVal); });
 }
 
 void Field::clampComponent(int component, double minVal, double maxVal) {
-    int components = getNumComponents();
-    int size = getSize();
-    for (int i = 0; i < size; ++i) {
-        double& val = data[i * components + component];
-        val = std::max(minVal, std::min(maxVal, val));
-    }
+    dispatch([&](auto* x, size_t) {
+        if (isBlocked()) {
+            kernels::clamp(x + component * componentStride, getSize(), minVal, maxVal);
+        } else {
+            kernels::clampComponent(x, getSize(), getNumComponents(), component, minVal, maxVal);
+        }
+    });
+}
+
+FieldStatistics Field::computeStatistics() const {
+    return dispatch([](const auto* x, size_t n) { return kernels::statistics(x, n); });
 }
 
 bool Field::isValid() const {
-    return !hasNaN() && !hasInf();
+    return computeStatistics().isValid();
 }
 
 bool Field::hasNaN() const {
-    for (const auto& val : data) {
-        if (std::isnan(val)) return true;
-    }
-    return false;
+    return computeStatistics().numNaN > 0;
 }
 
 bool Field::hasInf() const {
-    for (const auto& val : data) {
-        if (std::isinf(val)) return true;
-    }
-    return false;
+    return computeStatistics().numInf > 0;
 }
 
 } // namespace cfd
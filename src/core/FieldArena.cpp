@@ -0,0 +1,139 @@
+#include "core/FieldArena.h"
+#include <algorithm>
+#include <iterator>
+
+namespace cfd {
+
+FieldArena::FieldArena(std::size_t capacityBytes) : usedBytes(0), peakBytes(0) {
+    if (capacityBytes > 0) {
+        addChunk(roundToSlab(capacityBytes));
+    }
+}
+
+FieldArena::~FieldArena() {
+    for (Chunk& chunk : chunks) {
+        ::operator delete(chunk.base, std::align_val_t(SLAB_BYTES));
+    }
+}
+
+void FieldArena::addChunk(std::size_t bytes) {
+    Chunk chunk;
+    chunk.base = static_cast<char*>(::operator new(bytes, std::align_val_t(SLAB_BYTES)));
+    chunk.size = bytes;
+    chunk.freeBlocks[0] = bytes;
+    chunks.push_back(std::move(chunk));
+}
+
+void* FieldArena::allocate(std::size_t bytes) {
+    const std::size_t size = roundToSlab(bytes);
+    std::lock_guard<std::mutex> lock(mutex);
+
+    // First fit over chunks in creation order
+    for (std::size_t pass = 0; pass < 2; ++pass) {
+        for (Chunk& chunk : chunks) {
+            for (auto it = chunk.freeBlocks.begin(); it != chunk.freeBlocks.end(); ++it) {
+                if (it->second < size) continue;
+
+                std::size_t offset = it->first;
+                std::size_t remaining = it->second - size;
+                chunk.freeBlocks.erase(it);
+                if (remaining > 0) {
+                    chunk.freeBlocks[offset + size] = remaining;
+                }
+                usedBytes += size;
+                peakBytes = std::max(peakBytes, usedBytes);
+                return chunk.base + offset;
+            }
+        }
+        // Grow: at least double the capacity so chunks stay few
+        addChunk(std::max(size, capacityLocked()));
+    }
+    throw std::bad_alloc();
+}
+
+void FieldArena::deallocate(void* ptr, std::size_t bytes) {
+    const std::size_t size = roundToSlab(bytes);
+    char* p = static_cast<char*>(ptr);
+    std::lock_guard<std::mutex> lock(mutex);
+
+    for (Chunk& chunk : chunks) {
+        if (p < chunk.base || p >= chunk.base + chunk.size) continue;
+
+        std::size_t offset = static_cast<std::size_t>(p - chunk.base);
+        auto next = chunk.freeBlocks.lower_bound(offset);
+        std::size_t start = offset;
+        std::size_t length = size;
+
+        // Merge with the preceding and following free blocks
+        if (next != chunk.freeBlocks.begin()) {
+            auto prev = std::prev(next);
+            if (prev->first + prev->second == offset) {
+                start = prev->first;
+                length += prev->second;
+                chunk.freeBlocks.erase(prev);
+            }
+        }
+        if (next != chunk.freeBlocks.end() && offset + size == next->first) {
+            length += next->second;
+            chunk.freeBlocks.erase(next);
+        }
+        chunk.freeBlocks[start] = length;
+        usedBytes -= size;
+        return;
+    }
+}
+
+std::size_t FieldArena::capacityLocked() const {
+    std::size_t total = 0;
+    for (const Chunk& chunk : chunks) {
+        total += chunk.size;
+    }
+    return total;
+}
+
+std::size_t FieldArena::largestFreeBlockLocked() const {
+    std::size_t largest = 0;
+    for (const Chunk& chunk : chunks) {
+        for (const auto& block : chunk.freeBlocks) {
+            largest = std::max(largest, block.second);
+        }
+    }
+    return largest;
+}
+
+std::size_t FieldArena::getCapacity() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return capacityLocked();
+}
+
+std::size_t FieldArena::getUsedBytes() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return usedBytes;
+}
+
+std::size_t FieldArena::getPeakBytes() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return peakBytes;
+}
+
+std::size_t FieldArena::getLargestFreeBlock() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return largestFreeBlockLocked();
+}
+
+int FieldArena::getNumChunks() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return static_cast<int>(chunks.size());
+}
+
+double FieldArena::getFragmentation() const {
+    // One lock, so capacity, usage and the largest block are consistent
+    std::lock_guard<std::mutex> lock(mutex);
+    std::size_t freeBytes = capacityLocked() - usedBytes;
+    if (freeBytes == 0) {
+        return 0.0;
+    }
+    return 1.0 - static_cast<double>(largestFreeBlockLocked()) / static_cast<double>(freeBytes);
+}
+
+} // namespace cfd
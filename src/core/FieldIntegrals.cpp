@@ -0,0 +1,73 @@
+#include "core/FieldIntegrals.h"
+#include "core/Reduction.h"
+#include <stdexcept>
+
+namespace cfd {
+
+namespace {
+
+const BoundaryPatch& findPatch(const Mesh& mesh, const std::string& patch) {
+    auto it = mesh.boundaries.find(patch);
+    if (it == mesh.boundaries.end()) {
+        throw std::runtime_error("Boundary patch not found: " + patch);
+    }
+    return it->second;
+}
+
+void checkSize(const Mesh& mesh, const Field& field) {
+    if (field.getSize() != mesh.getNumCells()) {
+        throw std::runtime_error("Field " + field.name + " does not match the mesh cell count");
+    }
+}
+
+} // anonymous namespace
+
+double volumeIntegral(const Mesh& mesh, const Field& field, int component) {
+    checkSize(mesh, field);
+    return field.weightedSum(mesh.geometry.cellVolume.data(), component);
+}
+
+double totalVolume(const Mesh& mesh) {
+    return kernels::sum(mesh.geometry.cellVolume.data(), mesh.geometry.cellVolume.size());
+}
+
+double volumeAverage(const Mesh& mesh, const Field& field, int component) {
+    double volume = totalVolume(mesh);
+    return volume > 0.0 ? volumeIntegral(mesh, field, component) / volume : 0.0;
+}
+
+double patchIntegral(const Mesh& mesh, const Field& field, const std::string& patch, int component) {
+    checkSize(mesh, field);
+    const std::vector<label>& faceIds = findPatch(mesh, patch).faceIds;
+    return reproducibleSum(faceIds.size(), [&](std::size_t i) {
+        const Face& face = mesh.faces[faceIds[i]];
+        return face.area * field.value(face.ownerCell, component);
+    });
+}
+
+double patchArea(const Mesh& mesh, const std::string& patch) {
+    const std::vector<label>& faceIds = findPatch(mesh, patch).faceIds;
+    return reproducibleSum(faceIds.size(), [&](std::size_t i) { return mesh.faces[faceIds[i]].area; });
+}
+
+double patchAverage(const Mesh& mesh, const Field& field, const std::string& patch, int component) {
+    double area = patchArea(mesh, patch);
+    return area > 0.0 ? patchIntegral(mesh, field, patch, component) / area : 0.0;
+}
+
+double patchFlux(const Mesh& mesh, const Field& vectorField, const std::string& patch) {
+    checkSize(mesh, vectorField);
+    if (vectorField.type != FieldType::VECTOR) {
+        throw std::invalid_argument("patchFlux needs a vector field: " + vectorField.name);
+    }
+    const MeshGeometry& g = mesh.geometry;
+    const std::vector<label>& faceIds = findPatch(mesh, patch).faceIds;
+    return reproducibleSum(faceIds.size(), [&](std::size_t i) {
+        const label f = faceIds[i];
+        const label owner = mesh.faces[f].ownerCell;
+        return g.faceAreaX[f] * vectorField.value(owner, 0) + g.faceAreaY[f] * vectorField.value(owner, 1) +
+               g.faceAreaZ[f] * vectorField.value(owner, 2);
+    });
+}
+
+} // namespace cfd
@@ -0,0 +1,659 @@
+#include "core/FieldKernels.h"
+#include "core/Reduction.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <omp.h>
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace cfd {
+
+FieldStatistics::FieldStatistics()
+    : min(std::numeric_limits<double>::infinity()),
+      max(-std::numeric_limits<double>::infinity()),
+      sum(0.0), count(0), numNaN(0), numInf(0) {
+}
+
+double FieldStatistics::mean() const {
+    std::size_t numValues = count - numNaN;
+    return (numValues > 0) ? sum / static_cast<double>(numValues) : 0.0;
+}
+
+void FieldStatistics::merge(const FieldStatistics& other) {
+    min = std::min(min, other.min);
+    max = std::max(max, other.max);
+    sum += other.sum;
+    count += other.count;
+    numNaN += other.numNaN;
+    numInf += other.numInf;
+}
+
+namespace kernels {
+
+namespace {
+
+/**
+ * @brief One SIMD register of doubles
+ *
+ * Float arrays are widened on load and narrowed on store, so every kernel
+ * computes in double whatever the storage precision.
+ *
+ * vmin/vmax follow the x86 convention: the second operand is returned when
+ * either is NaN. The scalar fallback mimics this so every path agrees.
+ */
+#if defined(__AVX512F__)
+
+struct Vec {
+    static constexpr std::size_t WIDTH = 8;
+    __m512d v;
+
+    static Vec load(const double* p) { return {_mm512_loadu_pd(p)}; }
+    static Vec load(const float* p) { return {_mm512_cvtps_pd(_mm256_loadu_ps(p))}; }
+    static Vec broadcast(double a) { return {_mm512_set1_pd(a)}; }
+    void store(double* p) const { _mm512_storeu_pd(p, v); }
+    void store(float* p) const { _mm256_storeu_ps(p, _mm512_cvtpd_ps(v)); }
+};
+
+inline Vec operator+(Vec a, Vec b) { return {_mm512_add_pd(a.v, b.v)}; }
+inline Vec operator-(Vec a, Vec b) { return {_mm512_sub_pd(a.v, b.v)}; }
+inline Vec operator*(Vec a, Vec b) { return {_mm512_mul_pd(a.v, b.v)}; }
+inline Vec vmin(Vec a, Vec b) { return {_mm512_min_pd(a.v, b.v)}; }
+inline Vec vmax(Vec a, Vec b) { return {_mm512_max_pd(a.v, b.v)}; }
+
+// 1.0 in NaN / infinite lanes, else 0.0; x with NaN lanes zeroed
+inline Vec nanLanes(Vec a) {
+    return {_mm512_maskz_mov_pd(_mm512_cmp_pd_mask(a.v, a.v, _CMP_UNORD_Q), _mm512_set1_pd(1.0))};
+}
+inline Vec infLanes(Vec a) {
+    __mmask8 m = _mm512_cmp_pd_mask(_mm512_abs_pd(a.v), _mm512_set1_pd(HUGE_VAL), _CMP_EQ_OQ);
+    return {_mm512_maskz_mov_pd(m, _mm512_set1_pd(1.0))};
+}
+inline Vec zeroNaN(Vec a) {
+    return {_mm512_maskz_mov_pd(_mm512_cmp_pd_mask(a.v, a.v, _CMP_ORD_Q), a.v)};
+}
+
+const char* const INSTRUCTION_SET = "AVX-512";
+
+#elif defined(__AVX2__)
+
+struct Vec {
+    static constexpr std::size_t WIDTH = 4;
+    __m256d v;
+
+    static Vec load(const double* p) { return {_mm256_loadu_pd(p)}; }
+    static Vec load(const float* p) { return {_mm256_cvtps_pd(_mm_loadu_ps(p))}; }
+    static Vec broadcast(double a) { return {_mm256_set1_pd(a)}; }
+    void store(double* p) const { _mm256_storeu_pd(p, v); }
+    void store(float* p) const { _mm_storeu_ps(p, _mm256_cvtpd_ps(v)); }
+};
+
+inline Vec operator+(Vec a, Vec b) { return {_mm256_add_pd(a.v, b.v)}; }
+inline Vec operator-(Vec a, Vec b) { return {_mm256_sub_pd(a.v, b.v)}; }
+inline Vec operator*(Vec a, Vec b) { return {_mm256_mul_pd(a.v, b.v)}; }
+inline Vec vmin(Vec a, Vec b) { return {_mm256_min_pd(a.v, b.v)}; }
+inline Vec vmax(Vec a, Vec b) { return {_mm256_max_pd(a.v, b.v)}; }
+
+inline Vec nanLanes(Vec a) {
+    return {_mm256_and_pd(_mm256_cmp_pd(a.v, a.v, _CMP_UNORD_Q), _mm256_set1_pd(1.0))};
+}
+inline Vec infLanes(Vec a) {
+    __m256d absA = _mm256_andnot_pd(_mm256_set1_pd(-0.0), a.v);
+    return {_mm256_and_pd(_mm256_cmp_pd(absA, _mm256_set1_pd(HUGE_VAL), _CMP_EQ_OQ), _mm256_set1_pd(1.0))};
+}
+inline Vec zeroNaN(Vec a) {
+    return {_mm256_and_pd(_mm256_cmp_pd(a.v, a.v, _CMP_ORD_Q), a.v)};
+}
+
+const char* const INSTRUCTION_SET = "AVX2";
+
+#else
+
+struct Vec {
+    static constexpr std::size_t WIDTH = 1;
+    double v;
+
+    static Vec load(const double* p) { return {*p}; }
+    static Vec load(const float* p) { return {static_cast<double>(*p)}; }
+    static Vec broadcast(double a) { return {a}; }
+    void store(double* p) const { *p = v; }
+    void store(float* p) const { *p = static_cast<float>(v); }
+};
+
+inline Vec operator+(Vec a, Vec b) { return {a.v + b.v}; }
+inline Vec operator-(Vec a, Vec b) { return {a.v - b.v}; }
+inline Vec operator*(Vec a, Vec b) { return {a.v * b.v}; }
+inline Vec vmin(Vec a, Vec b) { return {a.v < b.v ? a.v : b.v}; }
+inline Vec vmax(Vec a, Vec b) { return {a.v > b.v ? a.v : b.v}; }
+
+inline Vec nanLanes(Vec a) { return {std::isnan(a.v) ? 1.0 : 0.0}; }
+inline Vec infLanes(Vec a) { return {std::isinf(a.v) ? 1.0 : 0.0}; }
+inline Vec zeroNaN(Vec a) { return {std::isnan(a.v) ? 0.0 : a.v}; }
+
+const char* const INSTRUCTION_SET = "scalar";
+
+#endif
+
+constexpr std::size_t W = Vec::WIDTH;
+constexpr std::size_t CACHE_LINE = 64;
+constexpr double INF = std::numeric_limits<double>::infinity();
+
+// Scalar versions with the same NaN convention, for loop tails
+inline double smin(double a, double b) { return a < b ? a : b; }
+inline double smax(double a, double b) { return a > b ? a : b; }
+
+// Reduction over one register's lanes
+template <typename Op>
+double reduceLanes(Vec a, Op op) {
+    double lanes[W];
+    a.store(lanes);
+    double result = lanes[0];
+    for (std::size_t i = 1; i < W; ++i) {
+        result = op(result, lanes[i]);
+    }
+    return result;
+}
+
+/**
+ * @brief Run fn(begin, end) over [0, n), split across threads above the
+ * threshold
+ *
+ * Chunk boundaries are multiples of granule, so each chunk starts on a
+ * cache line (granule a multiple of 8) and on a tuple boundary.
+ */
+template <typename Fn>
+void forEachChunk(std::size_t n, std::size_t granule, Fn fn) {
+    if (n < PARALLEL_THRESHOLD || omp_in_parallel() || omp_get_max_threads() == 1) {
+        fn(std::size_t(0), n, 0);
+        return;
+    }
+
+    const std::size_t numGranules = (n + granule - 1) / granule;
+    #pragma omp parallel
+    {
+        const std::size_t t = omp_get_thread_num();
+        const std::size_t nt = omp_get_num_threads();
+        std::size_t begin = std::min(n, (numGranules * t / nt) * granule);
+        std::size_t end = std::min(n, (numGranules * (t + 1) / nt) * granule);
+        fn(begin, end, static_cast<int>(t));
+    }
+}
+
+// One value per thread, combined in thread order
+template <typename ChunkFn, typename Op>
+double reduceChunks(std::size_t n, double identity, ChunkFn chunkFn, Op op) {
+    std::vector<double> partial(omp_get_max_threads(), identity);
+    forEachChunk(n, 8, [&](std::size_t begin, std::size_t end, int thread) {
+        partial[thread] = chunkFn(begin, end);
+    });
+
+    double result = identity;
+    for (double value : partial) {
+        result = op(result, value);
+    }
+    return result;
+}
+
+// Element-wise transform: x[i] = f(x[i]) or f(x[i], y[i])
+template <typename T, typename VecOp, typename ScalarOp>
+void transform(T* x, std::size_t n, VecOp vecOp, ScalarOp scalarOp) {
+    forEachChunk(n, CACHE_LINE / sizeof(T), [&](std::size_t begin, std::size_t end, int) {
+        std::size_t i = begin;
+        for (; i + W <= end; i += W) {
+            vecOp(i);
+        }
+        for (; i < end; ++i) {
+            x[i] = static_cast<T>(scalarOp(i));
+        }
+    });
+}
+
+template <typename T>
+double chunkMin(const T* x, std::size_t begin, std::size_t end) {
+    Vec acc0 = Vec::broadcast(INF), acc1 = acc0, acc2 = acc0, acc3 = acc0;
+    std::size_t i = begin;
+    for (; i + 4 * W <= end; i += 4 * W) {
+        acc0 = vmin(Vec::load(x + i), acc0);
+        acc1 = vmin(Vec::load(x + i + W), acc1);
+        acc2 = vmin(Vec::load(x + i + 2 * W), acc2);
+        acc3 = vmin(Vec::load(x + i + 3 * W), acc3);
+    }
+    double result = reduceLanes(vmin(vmin(acc0, acc1), vmin(acc2, acc3)), smin);
+    for (; i < end; ++i) {
+        result = smin(x[i], result);
+    }
+    return result;
+}
+
+template <typename T>
+double chunkMax(const T* x, std::size_t begin, std::size_t end) {
+    Vec acc0 = Vec::broadcast(-INF), acc1 = acc0, acc2 = acc0, acc3 = acc0;
+    std::size_t i = begin;
+    for (; i + 4 * W <= end; i += 4 * W) {
+        acc0 = vmax(Vec::load(x + i), acc0);
+        acc1 = vmax(Vec::load(x + i + W), acc1);
+        acc2 = vmax(Vec::load(x + i + 2 * W), acc2);
+        acc3 = vmax(Vec::load(x + i + 3 * W), acc3);
+    }
+    double result = reduceLanes(vmax(vmax(acc0, acc1), vmax(acc2, acc3)), smax);
+    for (; i < end; ++i) {
+        result = smax(x[i], result);
+    }
+    return result;
+}
+
+// CompensatedSum::add per lane
+inline void twoSum(Vec& sum, Vec& error, Vec x) {
+    Vec t = sum + x;
+    Vec z = t - sum;
+    error = error + ((sum - (t - z)) + (x - z));
+    sum = t;
+}
+
+/**
+ * @brief Compensated sum of term(i) over one reduction block
+ *
+ * Four lane accumulators hide the add latency; lanes are folded in a fixed
+ * order, so the block result depends only on the data.
+ */
+template <typename VecTerm, typename ScalarTerm>
+CompensatedSum blockSum(std::size_t begin, std::size_t end, VecTerm vecTerm, ScalarTerm scalarTerm) {
+    constexpr std::size_t ACC = 4;
+    Vec sum[ACC], error[ACC];
+    for (std::size_t k = 0; k < ACC; ++k) {
+        sum[k] = Vec::broadcast(0.0);
+        error[k] = sum[k];
+    }
+    std::size_t i = begin;
+    for (; i + ACC * W <= end; i += ACC * W) {
+        for (std::size_t k = 0; k < ACC; ++k) {
+            twoSum(sum[k], error[k], vecTerm(i + k * W));
+        }
+    }
+    
+    CompensatedSum result;
+    for (std::size_t k = 0; k < ACC; ++k) {
+        double s[W], e[W];
+        sum[k].store(s);
+        error[k].store(e);
+        for (std::size_t j = 0; j < W; ++j) {
+            result.add(s[j]);
+            result.error += e[j];
+        }
+    }
+    for (; i < end; ++i) {
+        result.add(scalarTerm(i));
+    }
+    return result;
+}
+
+template <typename BlockFn>
+double compensatedReduce(std::size_t n, BlockFn blockFn) {
+    return reduceBlocks(n, CompensatedSum(), blockFn,
+                        [](CompensatedSum& into, const CompensatedSum& block) { into.add(block); }).result();
+}
+
+// Exact pass: counts NaN / Inf lanes and keeps NaN out of min, max and sum
+template <typename T>
+FieldStatistics blockStatisticsExact(const T* x, std::size_t begin, std::size_t end) {
+    // Counts are accumulated as doubles per lane (exact below 2^53)
+    Vec accMin = Vec::broadcast(INF), accMax = Vec::broadcast(-INF);
+    Vec accSum = Vec::broadcast(0.0), accNaN = accSum, accInf = accSum;
+    std::size_t i = begin;
+    for (; i + W <= end; i += W) {
+        Vec v = Vec::load(x + i);
+        accMin = vmin(v, accMin);
+        accMax = vmax(v, accMax);
+        accSum = accSum + zeroNaN(v);
+        accNaN = accNaN + nanLanes(v);
+        accInf = accInf + infLanes(v);
+    }
+    
+    auto add = [](double a, double b) { return a + b; };
+    FieldStatistics stats;
+    stats.min = reduceLanes(accMin, smin);
+    stats.max = reduceLanes(accMax, smax);
+    stats.sum = reduceLanes(accSum, add);
+    stats.numNaN = static_cast<std::size_t>(reduceLanes(accNaN, add));
+    stats.numInf = static_cast<std::size_t>(reduceLanes(accInf, add));
+    for (; i < end; ++i) {
+        double value = static_cast<double>(x[i]);
+        if (std::isnan(value)) {
+            stats.numNaN++;
+            continue;
+        }
+        if (std::isinf(value)) stats.numInf++;
+        stats.min = smin(value, stats.min);
+        stats.max = smax(value, stats.max);
+        stats.sum += value;
+    }
+    stats.count = end - begin;
+    return stats;
+}
+
+/**
+ * @brief Fused statistics, fast path first
+ *
+ * x - x is 0 for finite values and NaN otherwise, so one extra add per
+ * register tells whether a sub-block holds any NaN or Inf. Clean
+ * sub-blocks (the normal case) skip the counting; the rest are rescanned
+ * by the exact pass while still in L1.
+ */
+template <typename T>
+FieldStatistics chunkStatistics(const T* x, std::size_t begin, std::size_t end) {
+    constexpr std::size_t SUB_BLOCK = 2048;
+    FieldStatistics stats;
+    for (std::size_t blockBegin = begin; blockBegin < end; blockBegin += SUB_BLOCK) {
+        const std::size_t blockEnd = std::min(end, blockBegin + SUB_BLOCK);
+        Vec min0 = Vec::broadcast(INF), min1 = min0;
+        Vec max0 = Vec::broadcast(-INF), max1 = max0;
+        Vec sum0 = Vec::broadcast(0.0), sum1 = sum0, bad = sum0;
+        std::size_t i = blockBegin;
+        for (; i + 2 * W <= blockEnd; i += 2 * W) {
+            Vec a = Vec::load(x + i);
+            Vec b = Vec::load(x + i + W);
+            min0 = vmin(a, min0);
+            min1 = vmin(b, min1);
+            max0 = vmax(a, max0);
+            max1 = vmax(b, max1);
+            sum0 = sum0 + a;
+            sum1 = sum1 + b;
+            bad = bad + ((a - a) + (b - b));
+        }
+        
+        double badSum = reduceLanes(bad, [](double p, double q) { return p + q; });
+        for (std::size_t j = i; j < blockEnd; ++j) {
+            badSum += static_cast<double>(x[j]) - static_cast<double>(x[j]);
+        }
+        if (badSum != 0.0) {
+            stats.merge(blockStatisticsExact(x, blockBegin, blockEnd));
+            continue;
+        }
+        
+        FieldStatistics block;
+        block.min = reduceLanes(vmin(min0, min1), smin);
+        block.max = reduceLanes(vmax(max0, max1), smax);
+        block.sum = reduceLanes(sum0 + sum1, [](double p, double q) { return p + q; });
+        for (; i < blockEnd; ++i) {
+            block.min = smin(x[i], block.min);
+            block.max = smax(x[i], block.max);
+            block.sum += x[i];
+        }
+        block.count = blockEnd - blockBegin;
+        stats.merge(block);
+    }
+    return stats;
+}
+
+/**
+ * @brief Lane pattern for interleaved tuples
+ *
+ * A block of numComponents registers holds exactly W tuples, so lane j of
+ * register k always carries component (k * W + j) % numComponents. The
+ * pattern has active on the selected component and inactive elsewhere.
+ */
+struct LanePattern {
+    Vec regs[MAX_COMPONENTS];
+
+    LanePattern(int numComponents, int component, double active, double inactive) {
+        double values[MAX_COMPONENTS * W];
+        for (std::size_t j = 0; j < numComponents * W; ++j) {
+            values[j] = (static_cast<int>(j % numComponents) == component) ? active : inactive;
+        }
+        for (int k = 0; k < numComponents; ++k) {
+            regs[k] = Vec::load(values + k * W);
+        }
+    }
+};
+
+template <typename T>
+void fillImpl(T* x, std::size_t n, double value) {
+    const Vec v = Vec::broadcast(value);
+    transform(x, n, [&](std::size_t i) { v.store(x + i); },
+              [&](std::size_t) { return value; });
+}
+
+template <typename T>
+void scaleImpl(T* x, std::size_t n, double factor) {
+    const Vec f = Vec::broadcast(factor);
+    transform(x, n, [&](std::size_t i) { (Vec::load(x + i) * f).store(x + i); },
+              [&](std::size_t i) { return x[i] * factor; });
+}
+
+template <typename T, typename U>
+void addImpl(T* x, const U* y, std::size_t n) {
+    transform(x, n, [&](std::size_t i) { (Vec::load(x + i) + Vec::load(y + i)).store(x + i); },
+              [&](std::size_t i) { return static_cast<double>(x[i]) + static_cast<double>(y[i]); });
+}
+
+template <typename T, typename U>
+void subtractImpl(T* x, const U* y, std::size_t n) {
+    transform(x, n, [&](std::size_t i) { (Vec::load(x + i) - Vec::load(y + i)).store(x + i); },
+              [&](std::size_t i) { return static_cast<double>(x[i]) - static_cast<double>(y[i]); });
+}
+
+template <typename T>
+void clampImpl(T* x, std::size_t n, double minVal, double maxVal) {
+    // NaN stays NaN: vmax/vmin return their second operand
+    const Vec lo = Vec::broadcast(minVal);
+    const Vec hi = Vec::broadcast(maxVal);
+    transform(x, n, [&](std::size_t i) { vmin(hi, vmax(lo, Vec::load(x + i))).store(x + i); },
+              [&](std::size_t i) { return smin(maxVal, smax(minVal, x[i])); });
+}
+
+template <typename T>
+double minImpl(const T* x, std::size_t n) {
+    return reduceChunks(n, INF, [&](std::size_t begin, std::size_t end) { return chunkMin(x, begin, end); },
+                        smin);
+}
+
+template <typename T>
+double maxImpl(const T* x, std::size_t n) {
+    return reduceChunks(n, -INF, [&](std::size_t begin, std::size_t end) { return chunkMax(x, begin, end); },
+                        smax);
+}
+
+template <typename T>
+double sumImpl(const T* x, std::size_t n) {
+    return compensatedReduce(n, [&](std::size_t begin, std::size_t end) {
+        return blockSum(begin, end, [&](std::size_t i) { return Vec::load(x + i); },
+                        [&](std::size_t i) { return static_cast<double>(x[i]); });
+    });
+}
+
+template <typename T>
+double dotImpl(const T* x, const double* w, std::size_t n) {
+    return compensatedReduce(n, [&](std::size_t begin, std::size_t end) {
+        return blockSum(begin, end, [&](std::size_t i) { return Vec::load(x + i) * Vec::load(w + i); },
+                        [&](std::size_t i) { return static_cast<double>(x[i]) * w[i]; });
+    });
+}
+
+template <typename T>
+double stridedDotImpl(const T* x, std::size_t stride, const double* w, std::size_t n) {
+    if (stride == 1) {
+        return dotImpl(x, w, n);
+    }
+    // Gathered lanes; the strided loads dominate either way
+    return compensatedReduce(n, [&](std::size_t begin, std::size_t end) {
+        return blockSum(begin, end,
+                        [&](std::size_t i) {
+                            double lanes[W];
+                            for (std::size_t j = 0; j < W; ++j) {
+                                lanes[j] = static_cast<double>(x[(i + j) * stride]);
+                            }
+                            return Vec::load(lanes) * Vec::load(w + i);
+                        },
+                        [&](std::size_t i) { return static_cast<double>(x[i * stride]) * w[i]; });
+    });
+}
+
+template <typename T>
+FieldStatistics statisticsImpl(const T* x, std::size_t n) {
+    return reduceBlocks(n, FieldStatistics(),
+                        [&](std::size_t begin, std::size_t end) { return chunkStatistics(x, begin, end); },
+                        [](FieldStatistics& into, const FieldStatistics& block) { into.merge(block); });
+}
+
+template <typename T>
+void fillComponentImpl(T* x, std::size_t numTuples, int numComponents, int component, double value) {
+    // A strided store touches every cache line anyway; only parallelize
+    const std::size_t n = numTuples * numComponents;
+    forEachChunk(n, CACHE_LINE / sizeof(T) * numComponents, [&](std::size_t begin, std::size_t end, int) {
+        for (std::size_t i = begin + component; i < end; i += numComponents) {
+            x[i] = static_cast<T>(value);
+        }
+    });
+}
+
+template <typename T>
+void clampComponentImpl(T* x, std::size_t numTuples, int numComponents, int component,
+                        double minVal, double maxVal) {
+    // Other lanes are clamped to [-inf, inf], which leaves them unchanged
+    const LanePattern lo(numComponents, component, minVal, -INF);
+    const LanePattern hi(numComponents, component, maxVal, INF);
+    const std::size_t block = numComponents * W;
+    const std::size_t n = numTuples * numComponents;
+
+    forEachChunk(n, CACHE_LINE / sizeof(T) * numComponents, [&](std::size_t begin, std::size_t end, int) {
+        std::size_t i = begin;
+        for (; i + block <= end; i += block) {
+            for (int k = 0; k < numComponents; ++k) {
+                T* p = x + i + k * W;
+                vmin(hi.regs[k], vmax(lo.regs[k], Vec::load(p))).store(p);
+            }
+        }
+        for (i += component; i < end; i += numComponents) {
+            x[i] = static_cast<T>(smin(maxVal, smax(minVal, static_cast<double>(x[i]))));
+        }
+    });
+}
+
+template <typename T>
+void componentMinMaxImpl(const T* x, std::size_t numTuples, int numComponents,
+                         double* minOut, double* maxOut) {
+    const std::size_t block = numComponents * W;
+    const std::size_t n = numTuples * numComponents;
+    std::vector<double> partialMin(omp_get_max_threads() * numComponents, INF);
+    std::vector<double> partialMax(omp_get_max_threads() * numComponents, -INF);
+
+    forEachChunk(n, CACHE_LINE / sizeof(T) * numComponents, [&](std::size_t begin, std::size_t end, int thread) {
+        Vec accMin[MAX_COMPONENTS];
+        Vec accMax[MAX_COMPONENTS];
+        for (int k = 0; k < numComponents; ++k) {
+            accMin[k] = Vec::broadcast(INF);
+            accMax[k] = Vec::broadcast(-INF);
+        }
+
+        std::size_t i = begin;
+        for (; i + block <= end; i += block) {
+            for (int k = 0; k < numComponents; ++k) {
+                Vec v = Vec::load(x + i + k * W);
+                accMin[k] = vmin(v, accMin[k]);
+                accMax[k] = vmax(v, accMax[k]);
+            }
+        }
+
+        // Fold lanes back to components
+        double* localMin = &partialMin[thread * numComponents];
+        double* localMax = &partialMax[thread * numComponents];
+        double lanes[W];
+        for (int k = 0; k < numComponents; ++k) {
+            accMin[k].store(lanes);
+            for (std::size_t j = 0; j < W; ++j) {
+                int c = static_cast<int>((k * W + j) % numComponents);
+                localMin[c] = smin(lanes[j], localMin[c]);
+            }
+            accMax[k].store(lanes);
+            for (std::size_t j = 0; j < W; ++j) {
+                int c = static_cast<int>((k * W + j) % numComponents);
+                localMax[c] = smax(lanes[j], localMax[c]);
+            }
+        }
+        for (; i < end; ++i) {
+            int c = static_cast<int>((i - begin) % numComponents);
+            localMin[c] = smin(x[i], localMin[c]);
+            localMax[c] = smax(x[i], localMax[c]);
+        }
+    });
+
+    for (int c = 0; c < numComponents; ++c) {
+        minOut[c] = INF;
+        maxOut[c] = -INF;
+    }
+    for (std::size_t t = 0; t < partialMin.size() / numComponents; ++t) {
+        for (int c = 0; c < numComponents; ++c) {
+            minOut[c] = smin(partialMin[t * numComponents + c], minOut[c]);
+            maxOut[c] = smax(partialMax[t * numComponents + c], maxOut[c]);
+        }
+    }
+}
+
+} // anonymous namespace
+
+const char* getInstructionSet() {
+    return INSTRUCTION_SET;
+}
+
+void fill(double* x, std::size_t n, double value) { fillImpl(x, n, value); }
+void fill(float* x, std::size_t n, double value) { fillImpl(x, n, value); }
+void scale(double* x, std::size_t n, double factor) { scaleImpl(x, n, factor); }
+void scale(float* x, std::size_t n, double factor) { scaleImpl(x, n, factor); }
+void add(double* x, const double* y, std::size_t n) { addImpl(x, y, n); }
+void add(float* x, const float* y, std::size_t n) { addImpl(x, y, n); }
+void add(double* x, const float* y, std::size_t n) { addImpl(x, y, n); }
+void add(float* x, const double* y, std::size_t n) { addImpl(x, y, n); }
+void subtract(double* x, const double* y, std::size_t n) { subtractImpl(x, y, n); }
+void subtract(float* x, const float* y, std::size_t n) { subtractImpl(x, y, n); }
+void subtract(double* x, const float* y, std::size_t n) { subtractImpl(x, y, n); }
+void subtract(float* x, const double* y, std::size_t n) { subtractImpl(x, y, n); }
+void clamp(double* x, std::size_t n, double minVal, double maxVal) { clampImpl(x, n, minVal, maxVal); }
+void clamp(float* x, std::size_t n, double minVal, double maxVal) { clampImpl(x, n, minVal, maxVal); }
+
+double min(const double* x, std::size_t n) { return minImpl(x, n); }
+double min(const float* x, std::size_t n) { return minImpl(x, n); }
+double max(const double* x, std::size_t n) { return maxImpl(x, n); }
+double max(const float* x, std::size_t n) { return maxImpl(x, n); }
+double sum(const double* x, std::size_t n) { return sumImpl(x, n); }
+double sum(const float* x, std::size_t n) { return sumImpl(x, n); }
+double dot(const double* x, const double* w, std::size_t n) { return dotImpl(x, w, n); }
+double dot(const float* x, const double* w, std::size_t n) { return dotImpl(x, w, n); }
+double dot(const double* x, std::size_t stride, const double* w, std::size_t n) {
+    return stridedDotImpl(x, stride, w, n);
+}
+double dot(const float* x, std::size_t stride, const double* w, std::size_t n) {
+    return stridedDotImpl(x, stride, w, n);
+}
+FieldStatistics statistics(const double* x, std::size_t n) { return statisticsImpl(x, n); }
+FieldStatistics statistics(const float* x, std::size_t n) { return statisticsImpl(x, n); }
+
+void fillComponent(double* x, std::size_t numTuples, int numComponents, int component, double value) {
+    fillComponentImpl(x, numTuples, numComponents, component, value);
+}
+void fillComponent(float* x, std::size_t numTuples, int numComponents, int component, double value) {
+    fillComponentImpl(x, numTuples, numComponents, component, value);
+}
+
+void clampComponent(double* x, std::size_t numTuples, int numComponents, int component,
+                    double minVal, double maxVal) {
+    clampComponentImpl(x, numTuples, numComponents, component, minVal, maxVal);
+}
+void clampComponent(float* x, std::size_t numTuples, int numComponents, int component,
+                    double minVal, double maxVal) {
+    clampComponentImpl(x, numTuples, numComponents, component, minVal, maxVal);
+}
+
+void componentMinMax(const double* x, std::size_t numTuples, int numComponents,
+                     double* minOut, double* maxOut) {
+    componentMinMaxImpl(x, numTuples, numComponents, minOut, maxOut);
+}
+void componentMinMax(const float* x, std::size_t numTuples, int numComponents,
+                     double* minOut, double* maxOut) {
+    componentMinMaxImpl(x, numTuples, numComponents, minOut, maxOut);
+}
+
+} // namespace kernels
+} // namespace cfd
@@ -1,50 +1,187 @@
 #include "core/FieldManager.h"
 #include <stdexcept>
 #include <algorithm>
+#include <string>
 
 namespace cfd {
 
-FieldManager::FieldManager() : currentSize(0) {
+FieldManager::FieldManager()
+    : currentSize(0), numScratchFields(0), numScratchInUse(0), scratchBytes(0), peakBytes(0) {
 }
 
-void FieldManager::registerField(const std::string& name, FieldType type, int size) {
-    fields[name] = std::make_unique<Field>(name, type, size);
+FieldId FieldManager::registerField(const std::string& name, FieldType type, label size,
+                                    FieldPrecision precision, FieldLayout layout) {
+    auto it = ids.find(name);
+    FieldId id;
+    if (it != ids.end()) {
+        id = it->second;
+    } else {
+        id = FieldId(static_cast<int>(slots.size()));
+        slots.emplace_back();
+        oldTimes.emplace_back();
+        ids[name] = id;
+    }
+    slots[id.getIndex()] = std::make_unique<Field>(name, type, size, precision, layout, getAllocator());
+    for (size_t level = 0; level < oldTimes[id.getIndex()].size(); ++level) {
+        oldTimes[id.getIndex()][level] = makeOldLevel(*slots[id.getIndex()], static_cast<int>(level) + 1);
+    }
     currentSize = size;
+    updatePeak();
+    return id;
 }
 
-Field& FieldManager::getField(const std::string& name) {
-    auto it = fields.find(name);
-    if (it == fields.end()) {
-        throw std::runtime_error("Field not found: " + name);
+ScalarFieldId FieldManager::registerScalarField(const std::string& name, label size,
+                                                FieldPrecision precision) {
+    return ScalarFieldId(registerField(name, FieldType::SCALAR, size, precision));
+}
+
+VectorFieldId FieldManager::registerVectorField(const std::string& name, label size,
+                                                FieldPrecision precision, FieldLayout layout) {
+    return VectorFieldId(registerField(name, FieldType::VECTOR, size, precision, layout));
+}
+
+FieldId FieldManager::findOrRegisterField(const std::string& name, FieldType type, label size) {
+    auto it = ids.find(name);
+    if (it == ids.end()) {
+        return registerField(name, type, size);
+    }
+    if (slots[it->second.getIndex()]->type != type) {
+        throw std::invalid_argument("Field type mismatch: " + name);
     }
-    return *it->second;
+    return it->second;
 }
 
-const Field& FieldManager::getField(const std::string& name) const {
-    auto it = fields.find(name);
-    if (it == fields.end()) {
+ScalarFieldId FieldManager::findOrRegisterScalarField(const std::string& name, label size) {
+    return ScalarFieldId(findOrRegisterField(name, FieldType::SCALAR, size));
+}
+
+VectorFieldId FieldManager::findOrRegisterVectorField(const std::string& name, label size) {
+    return VectorFieldId(findOrRegisterField(name, FieldType::VECTOR, size));
+}
+
+FieldId FieldManager::getFieldId(const std::string& name) const {
+    auto it = ids.find(name);
+    if (it == ids.end()) {
         throw std::runtime_error("Field not found: " + name);
     }
-    return *it->second;
+    return it->second;
+}
+
+template <FieldType Type>
+TypedFieldId<Type> FieldManager::checkType(FieldId id, const std::string& name) const {
+    if (slots[id.getIndex()]->type != Type) {
+        throw std::invalid_argument("Field type mismatch: " + name);
+    }
+    return TypedFieldId<Type>(id);
+}
+
+ScalarFieldId FieldManager::getScalarFieldId(const std::string& name) const {
+    return checkType<FieldType::SCALAR>(getFieldId(name), name);
+}
+
+VectorFieldId FieldManager::getVectorFieldId(const std::string& name) const {
+    return checkType<FieldType::VECTOR>(getFieldId(name), name);
+}
+
+void FieldManager::throwInvalidId(FieldId id) {
+    throw std::out_of_range("Invalid field id: " + std::to_string(id.getIndex()));
+}
+
+Field& FieldManager::getField(const std::string& name) {
+    return *slots[getFieldId(name).getIndex()];
+}
+
+const Field& FieldManager::getField(const std::string& name) const {
+    return *slots[getFieldId(name).getIndex()];
 }
 
 bool FieldManager::hasField(const std::string& name) const {
-    return fields.find(name) != fields.end();
+    return ids.find(name) != ids.end();
+}
+
+std::unique_ptr<Field> FieldManager::makeOldLevel(const Field& field, int level) const {
+    std::string name = field.name;
+    for (int i = 0; i < level; ++i) {
+        name += "_0";
+    }
+    auto old = std::make_unique<Field>(name, field.type, field.getSize(), field.precision,
+                                       field.layout, getAllocator());
+    // Copy assignment keeps the arena allocator of the new storage
+    old->data = field.data;
+    old->floatData = field.floatData;
+    return old;
+}
+
+void FieldManager::setNumOldTimeLevels(FieldId id, int numOldLevels) {
+    if (!hasField(id)) throwInvalidId(id);
+    if (numOldLevels < 0) {
+        throw std::invalid_argument("Number of old time levels must be non-negative");
+    }
+    auto& levels = oldTimes[id.getIndex()];
+    const int current = static_cast<int>(levels.size());
+    if (numOldLevels < current) {
+        levels.resize(numOldLevels);
+    }
+    for (int level = current + 1; level <= numOldLevels; ++level) {
+        levels.push_back(makeOldLevel(getField(id), level));
+    }
+    updatePeak();
+}
+
+int FieldManager::getNumOldTimeLevels(FieldId id) const {
+    if (!hasField(id)) throwInvalidId(id);
+    return static_cast<int>(oldTimes[id.getIndex()].size());
+}
+
+const Field& FieldManager::getOldField(FieldId id, int level) const {
+    if (level < 1 || level > getNumOldTimeLevels(id)) {
+        throw std::out_of_range("Old time level " + std::to_string(level) + " not kept for field " +
+                                getField(id).name);
+    }
+    return *oldTimes[id.getIndex()][level - 1];
+}
+
+void FieldManager::advanceTimeLevels() {
+    for (size_t i = 0; i < slots.size(); ++i) {
+        auto& levels = oldTimes[i];
+        if (!slots[i] || levels.empty()) continue;
+        
+        // Oldest first: level k takes level k-1, level 1 takes the current
+        // values and the current field inherits the dropped oldest buffer
+        for (size_t level = levels.size() - 1; level > 0; --level) {
+            levels[level]->swapValues(*levels[level - 1]);
+        }
+        levels[0]->swapValues(*slots[i]);
+    }
 }
 
 void FieldManager::removeField(const std::string& name) {
-    fields.erase(name);
+    auto it = ids.find(name);
+    if (it != ids.end()) {
+        slots[it->second.getIndex()].reset();
+        oldTimes[it->second.getIndex()].clear();
+        ids.erase(it);
+    }
 }
 
 void FieldManager::clearAll() {
-    fields.clear();
+    slots.clear();
+    oldTimes.clear();
+    ids.clear();
     currentSize = 0;
+    
+    // Checked-out scratch fields stay counted until they come back
+    for (const auto& field : scratchPool) {
+        scratchBytes -= field->getBytes();
+    }
+    numScratchFields -= static_cast<int>(scratchPool.size());
+    scratchPool.clear();
 }
 
 std::vector<std::string> FieldManager::getFieldNames() const {
     std::vector<std::string> names;
-    names.reserve(fields.size());
-    for (const auto& pair : fields) {
+    names.reserve(ids.size());
+    for (const auto& pair : ids) {
         names.push_back(pair.first);
     }
     return names;
@@ -52,8 +189,8 @@ std::vector<std::string> FieldManager::getFieldNames() const {
 
 std::vector<std::string> FieldManager::getScalarFieldNames() const {
     std::vector<std::string> names;
-    for (const auto& pair : fields) {
-        if (pair.second->type == FieldType::SCALAR) {
+    for (const auto& pair : ids) {
+        if (getField(pair.second).type == FieldType::SCALAR) {
             names.push_back(pair.first);
         }
     }
@@ -62,8 +199,8 @@ std::vector<std::string> FieldManager::getScalarFieldNames() const {
 
 std::vector<std::string> FieldManager::getVectorFieldNames() const {
     std::vector<std::string> names;
-    for (const auto& pair : fields) {
-        if (pair.second->type == FieldType::VECTOR) {
+    for (const auto& pair : ids) {
+        if (getField(pair.second).type == FieldType::VECTOR) {
             names.push_back(pair.first);
         }
     }
@@ -71,20 +208,77 @@ std::vector<std::string> FieldManager::getVectorFieldNames() const {
 }
 
 void FieldManager::fillAll(double value) {
-    for (auto& pair : fields) {
-        pair.second->fill(value);
+    for (auto& field : slots) {
+        if (field) field->fill(value);
     }
 }
 
 void FieldManager::scaleAll(double factor) {
-    for (auto& pair : fields) {
-        pair.second->scale(factor);
+    for (auto& field : slots) {
+        if (field) field->scale(factor);
+    }
+}
+
+void FieldManager::permuteCells(const std::vector<label>& newToOld) {
+    for (auto& field : slots) {
+        if (field) field->permute(newToOld);
+    }
+    for (auto& levels : oldTimes) {
+        for (auto& old : levels) {
+            old->permute(newToOld);
+        }
     }
 }
 
+std::map<std::string, FieldStatistics> FieldManager::computeStatistics() const {
+    // One work item per block of a field, so a few large fields and many
+    // small species fields both spread over all threads
+    struct Block {
+        const double* data;
+        const float* floatData;
+        size_t size;
+        size_t fieldIndex;
+    };
+    std::vector<std::string> names;
+    std::vector<Block> blocks;
+    for (const auto& pair : ids) {
+        const Field& field = getField(pair.second);
+        const size_t numValues = field.getNumValues();
+        for (size_t begin = 0; begin < numValues; begin += kernels::PARALLEL_THRESHOLD) {
+            size_t size = std::min(kernels::PARALLEL_THRESHOLD, numValues - begin);
+            if (field.isFloat()) {
+                blocks.push_back({nullptr, field.floatData.data() + begin, size, names.size()});
+            } else {
+                blocks.push_back({field.data.data() + begin, nullptr, size, names.size()});
+            }
+        }
+        names.push_back(pair.first);
+    }
+    
+    std::vector<FieldStatistics> blockStats(blocks.size());
+    const long numBlocks = static_cast<long>(blocks.size());
+    #pragma omp parallel for schedule(dynamic)
+    for (long b = 0; b < numBlocks; ++b) {
+        blockStats[b] = blocks[b].floatData ? kernels::statistics(blocks[b].floatData, blocks[b].size)
+                                            : kernels::statistics(blocks[b].data, blocks[b].size);
+    }
+    
+    // Merge in block order, independent of the thread count
+    std::vector<FieldStatistics> fieldStats(names.size());
+    for (size_t b = 0; b < blocks.size(); ++b) {
+        fieldStats[blocks[b].fieldIndex].merge(blockStats[b]);
+    }
+    
+    std::map<std::string, FieldStatistics> result;
+    for (size_t i = 0; i < names.size(); ++i) {
+        result.emplace(names[i], fieldStats[i]);
+    }
+    return result;
+}
+
 bool FieldManager::validateAll() const {
-    for (const auto& pair : fields) {
-        if (!pair.second->isValid()) {
+    for (const auto& pair : computeStatistics()) {
+        if (!pair.second.isValid()) {
             return false;
         }
     }
@@ -93,28 +287,191 @@ bool FieldManager::validateAll() const {
 
 std::vector<std::string> FieldManager::getInvalidFields() const {
     std::vector<std::string> invalid;
-    for (const auto& pair : fields) {
-        if (!pair.second->isValid()) {
+    for (const auto& pair : computeStatistics()) {
+        if (!pair.second.isValid()) {
             invalid.push_back(pair.first);
         }
     }
     return invalid;
 }
 
-size_t FieldManager::getTotalMemoryUsage() const {
+size_t FieldManager::getTotalMemoryUsage(FieldMemoryUsage* usage) const {
     size_t total = 0;
-    for (const auto& pair : fields) {
-        total += pair.second->data.size() * sizeof(double);
+    size_t floatValues = 0;
+    int numFloat = 0;
+    for (const auto& field : slots) {
+        if (!field) continue;
+        total += field->getBytes();
+        if (field->isFloat()) {
+            floatValues += field->floatData.size();
+            ++numFloat;
+        }
+    }
+    size_t oldTimeBytes = 0;
+    for (const auto& levels : oldTimes) {
+        for (const auto& old : levels) {
+            oldTimeBytes += old->getBytes();
+        }
+    }
+    total += oldTimeBytes;
+    
+    if (usage) {
+        *usage = FieldMemoryUsage();
+        usage->fieldBytes = total;
+        usage->oldTimeBytes = oldTimeBytes;
+        usage->numFloatFields = numFloat;
+        usage->floatSavedBytes = floatValues * (sizeof(double) - sizeof(float));
+        usage->scratchBytes = scratchBytes;
+        usage->peakBytes = std::max(peakBytes, total + scratchBytes);
+        if (arena) {
+            usage->arenaEnabled = true;
+            usage->arenaCapacity = arena->getCapacity();
+            usage->arenaUsedBytes = arena->getUsedBytes();
+            usage->arenaPeakBytes = arena->getPeakBytes();
+            usage->arenaLargestFreeBlock = arena->getLargestFreeBlock();
+            usage->arenaChunks = arena->getNumChunks();
+            usage->arenaFragmentation = arena->getFragmentation();
+        }
     }
     return total;
 }
 
-void FieldManager::resize(int newSize) {
-    for (auto& pair : fields) {
-        int components = pair.second->getNumComponents();
-        pair.second->data.resize(newSize * components, 0.0);
+void FieldManager::updatePeak() {
+    peakBytes = std::max(peakBytes, getTotalMemoryUsage() + scratchBytes);
+}
+
+void FieldManager::resize(label newSize) {
+    if (numScratchInUse > 0) {
+        throw std::logic_error("Cannot resize fields while scratch fields are checked out");
+    }
+    if (arena) {
+        rebuildArena(newSize, 0);
+        return;
+    }
+    
+    for (auto& field : slots) {
+        if (field) field->resize(newSize);
+    }
+    for (auto& levels : oldTimes) {
+        for (auto& old : levels) {
+            old->resize(newSize);
+        }
+    }
+    scratchBytes = 0;
+    for (auto& field : scratchPool) {
+        field->resize(newSize);
+        scratchBytes += field->getBytes();
+    }
+    currentSize = newSize;
+    updatePeak();
+}
+
+void FieldManager::enableArena(size_t capacityBytes) {
+    if (numScratchInUse > 0) {
+        throw std::logic_error("Cannot enable the field arena while scratch fields are checked out");
+    }
+    rebuildArena(currentSize, capacityBytes);
+}
+
+void FieldManager::compactArena() {
+    if (!arena) return;
+    if (numScratchInUse > 0) {
+        throw std::logic_error("Cannot compact the field arena while scratch fields are checked out");
+    }
+    rebuildArena(currentSize, 0);
+}
+
+void FieldManager::rebuildArena(label newSize, size_t capacityBytes) {
+    // Size the new arena for every field and idle scratch field up front
+    auto slabBytes = [newSize](const Field& field) {
+        size_t valueBytes = field.isFloat() ? sizeof(float) : sizeof(double);
+        size_t bytes = static_cast<size_t>(newSize) * field.getNumComponents() * valueBytes;
+        return (bytes + FieldArena::SLAB_BYTES - 1) / FieldArena::SLAB_BYTES * FieldArena::SLAB_BYTES;
+    };
+    size_t required = 0;
+    for (const auto& field : slots) {
+        if (field) required += slabBytes(*field);
+    }
+    for (const auto& levels : oldTimes) {
+        for (const auto& old : levels) {
+            required += slabBytes(*old);
+        }
     }
+    for (const auto& field : scratchPool) {
+        required += slabBytes(*field);
+    }
+    
+    auto newArena = std::make_unique<FieldArena>(std::max(required, capacityBytes));
+    ArenaAllocator<double> allocator(newArena.get());
+    
+    // The old buffers go back to the old arena (or heap) before it dies
+    for (auto& field : slots) {
+        if (field) field->reallocate(newSize, allocator);
+    }
+    for (auto& levels : oldTimes) {
+        for (auto& old : levels) {
+            old->reallocate(newSize, allocator);
+        }
+    }
+    scratchBytes = 0;
+    for (auto& field : scratchPool) {
+        field->reallocate(newSize, allocator);
+        scratchBytes += field->getBytes();
+    }
+    
+    arena = std::move(newArena);
     currentSize = newSize;
+    updatePeak();
+}
+
+ScratchField FieldManager::checkoutScratch(FieldType type, FieldLayout layout) {
+    const size_t size = static_cast<size_t>(currentSize);
+    for (auto it = scratchPool.begin(); it != scratchPool.end(); ++it) {
+        const Field& candidate = **it;
+        if (candidate.type == type && candidate.layout == layout &&
+            static_cast<size_t>(candidate.getSize()) == size) {
+            std::unique_ptr<Field> field = std::move(*it);
+            scratchPool.erase(it);
+            ++numScratchInUse;
+            return ScratchField(this, std::move(field));
+        }
+    }
+    
+    auto field = std::make_unique<Field>("scratch" + std::to_string(numScratchFields), type,
+                                         currentSize, FieldPrecision::DOUBLE, layout, getAllocator());
+    scratchBytes += field->getBytes();
+    ++numScratchFields;
+    ++numScratchInUse;
+    updatePeak();
+    return ScratchField(this, std::move(field));
+}
+
+void FieldManager::returnScratch(std::unique_ptr<Field> field) {
+    --numScratchInUse;
+    scratchPool.push_back(std::move(field));
+}
+
+ScratchField::ScratchField(ScratchField&& other) noexcept
+    : manager(other.manager), field(std::move(other.field)) {
+    other.manager = nullptr;
+}
+
+ScratchField& ScratchField::operator=(ScratchField&& other) noexcept {
+    if (this != &other) {
+        release();
+        manager = other.manager;
+        field = std::move(other.field);
+        other.manager = nullptr;
+    }
+    return *this;
+}
+
+void ScratchField::release() {
+    if (manager && field) {
+        manager->returnScratch(std::move(field));
+    }
+    manager = nullptr;
+    field.reset();
 }
 
 } // namespace cfd
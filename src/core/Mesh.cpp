@@ -2,71 +2,158 @@
 #include <algorithm>
 #include <stdexcept>
 #include <cmath>
+#include <numeric>
 
 namespace cfd {
 
-Mesh::Mesh() {
+namespace {
+
+/**
+ * @brief Distinct vertices of one cell, gathered from its faces
+ *
+ * Vertex ids are collected into a stack buffer and deduplicated with
+ * sort + unique, so the common case does no heap allocation. Cells whose
+ * faces list more than INLINE_CAPACITY vertices in total spill to the heap.
+ */
+class CellNodeSet {
+public:
+    CellNodeSet(const Mesh& mesh, label cellId) : ids(inlineIds), count(0) {
+        Span<const label> cellFaceIds = mesh.getCellFacesView(cellId);
+        
+        label total = 0;
+        for (label faceId : cellFaceIds) {
+            total += mesh.faceNodes.getRowSize(faceId);
+        }
+        if (total > INLINE_CAPACITY) {
+            overflowIds.resize(total);
+            ids = overflowIds.data();
+        }
+        
+        for (label faceId : cellFaceIds) {
+            for (label nodeId : mesh.getFaceNodesView(faceId)) {
+                ids[count++] = nodeId;
+            }
+        }
+        std::sort(ids, ids + count);
+        count = static_cast<label>(std::unique(ids, ids + count) - ids);
+    }
+    
+    CellNodeSet(const CellNodeSet&) = delete;
+    CellNodeSet& operator=(const CellNodeSet&) = delete;
+    
+    const label* begin() const { return ids; }
+    const label* end() const { return ids + count; }
+    label size() const { return count; }
+    
+private:
+    // Hexahedron: 6 faces x 4 vertices = 24; leaves room for polyhedra
+    static constexpr label INLINE_CAPACITY = 128;
+    
+    label inlineIds[INLINE_CAPACITY];
+    std::vector<label> overflowIds;
+    label* ids;
+    label count;
+};
+
+} // anonymous namespace
+
+void MeshGeometry::resize(label numFaces, label numCells) {
+    for (auto* arr : {&faceAreaX, &faceAreaY, &faceAreaZ,
+                      &faceCentroidX, &faceCentroidY, &faceCentroidZ,
+                      &faceWeight, &faceDeltaCoeff, &faceLaplacianCoeff,
+                      &faceNonOrthX, &faceNonOrthY, &faceNonOrthZ}) {
+        arr->assign(numFaces, 0.0);
+    }
+    for (auto* arr : {&cellCentroidX, &cellCentroidY, &cellCentroidZ,
+                      &cellVolume, &cellInvVolume}) {
+        arr->assign(numCells, 0.0);
+    }
+}
+
+void MeshGeometry::clear() {
+    resize(0, 0);
+}
+
+Mesh::Mesh() : facesOrdered(false), numInternalFaces(0), geometryVersion(0) {
 }
 
 Mesh::~Mesh() {
 }
 
-int Mesh::getNumBoundaryFaces() const {
-    int count = 0;
+label Mesh::getNumBoundaryFaces() const {
+    if (facesOrdered) {
+        return getNumFaces() - numInternalFaces;
+    }
+    
+    label count = 0;
     for (const auto& face : faces) {
         if (face.isBoundary()) count++;
     }
     return count;
 }
 
-int Mesh::getNumInternalFaces() const {
+label Mesh::getNumInternalFaces() const {
+    if (facesOrdered) {
+        return numInternalFaces;
+    }
     return getNumFaces() - getNumBoundaryFaces();
 }
 
-std::vector<int> Mesh::getCellNeighbors(int cellId) const {
+std::vector<label> Mesh::getCellNeighbors(label cellId) const {
     if (cellId < 0 || cellId >= getNumCells()) {
         throw std::out_of_range("Cell ID out of range");
     }
-    return cells[cellId].neighborCells;
+    // No neighbours until buildConnectivity() has covered this cell
+    if (cellId >= cellNeighbors.getNumRows()) {
+        return {};
+    }
+    Span<const label> neighbors = getCellNeighborsView(cellId);
+    return std::vector<label>(neighbors.begin(), neighbors.end());
 }
 
-std::vector<int> Mesh::getNodeCells(int nodeId) const {
+std::vector<label> Mesh::getNodeCells(label nodeId) const {
     if (nodeId < 0 || nodeId >= getNumNodes()) {
         throw std::out_of_range("Node ID out of range");
     }
-    return nodes[nodeId].connectedCells;
+    if (nodeId >= nodeCells.getNumRows()) {
+        return {};
+    }
+    Span<const label> nodeCellIds = getNodeCellsView(nodeId);
+    return std::vector<label>(nodeCellIds.begin(), nodeCellIds.end());
 }
 
-std::vector<int> Mesh::getCellFaces(int cellId) const {
+std::vector<label> Mesh::getCellFaces(label cellId) const {
     if (cellId < 0 || cellId >= getNumCells()) {
         throw std::out_of_range("Cell ID out of range");
     }
-    return cells[cellId].faceIds;
+    Span<const label> faceIds = getCellFacesView(cellId);
+    return std::vector<label>(faceIds.begin(), faceIds.end());
 }
 
-int Mesh::addNode(const Vector3D& position) {
-    int id = static_cast<int>(nodes.size());
+label Mesh::addNode(const Vector3D& position) {
+    label id = toLabel(nodes.size());
     nodes.push_back(Node(id, position));
     return id;
 }
 
-int Mesh::addCell(const std::vector<int>& faceIds) {
-    int id = static_cast<int>(cells.size());
+label Mesh::addCell(const std::vector<label>& faceIds) {
+    label id = toLabel(cells.size());
     Cell cell;
     cell.id = id;
-    cell.faceIds = faceIds;
     cells.push_back(cell);
+    cellFaces.appendRow(faceIds);
     return id;
 }
 
-int Mesh::addFace(const std::vector<int>& nodeIds, int owner, int neighbor) {
-    int id = static_cast<int>(faces.size());
+label Mesh::addFace(const std::vector<label>& nodeIds, label owner, label neighbor) {
+    label id = toLabel(faces.size());
     Face face;
     face.id = id;
-    face.nodeIds = nodeIds;
     face.ownerCell = owner;
     face.neighborCell = neighbor;
     faces.push_back(face);
+    faceNodes.appendRow(nodeIds);
+    facesOrdered = false;
     return id;
 }
 
@@ -74,30 +161,33 @@ void Mesh::addBoundaryPatch(const std::string& name, const std::string& type) {
     boundaries[name] = BoundaryPatch(name, type);
 }
 
-void Mesh::assignFaceToBoundary(int faceId, const std::string& patchName) {
+void Mesh::assignFaceToBoundary(label faceId, const std::string& patchName) {
     if (boundaries.find(patchName) == boundaries.end()) {
         throw std::runtime_error("Boundary patch not found: " + patchName);
     }
     boundaries[patchName].faceIds.push_back(faceId);
+    facesOrdered = false;
 }
 
 Vector3D Mesh::computeFaceCentroid(const Face& face) const {
+    Span<const label> nodeIds = getFaceNodesView(face.id);
     Vector3D centroid(0, 0, 0);
-    for (int nodeId : face.nodeIds) {
+    for (label nodeId : nodeIds) {
         centroid += nodes[nodeId].position;
     }
-    return centroid / static_cast<double>(face.nodeIds.size());
+    return centroid / static_cast<double>(nodeIds.size());
 }
 
 Vector3D Mesh::computeFaceNormal(const Face& face) const {
-    if (face.nodeIds.size() < 3) {
+    Span<const label> nodeIds = getFaceNodesView(face.id);
+    if (nodeIds.size() < 3) {
         return Vector3D(0, 0, 0);
     }
     
     // Use first three nodes to compute normal
-    const Vector3D& p0 = nodes[face.nodeIds[0]].position;
-    const Vector3D& p1 = nodes[face.nodeIds[1]].position;
-    const Vector3D& p2 = nodes[face.nodeIds[2]].position;
+    const Vector3D& p0 = nodes[nodeIds[0]].position;
+    const Vector3D& p1 = nodes[nodeIds[1]].position;
+    const Vector3D& p2 = nodes[nodeIds[2]].position;
     
     Vector3D v1 = p1 - p0;
     Vector3D v2 = p2 - p0;
@@ -106,17 +196,18 @@ Vector3D Mesh::computeFaceNormal(const Face& face) const {
 }
 
 double Mesh::computeFaceArea(const Face& face) const {
-    if (face.nodeIds.size() < 3) {
+    Span<const label> nodeIds = getFaceNodesView(face.id);
+    if (nodeIds.size() < 3) {
         return 0.0;
     }
     
     // Triangulate face and sum areas
     double totalArea = 0.0;
-    const Vector3D& p0 = nodes[face.nodeIds[0]].position;
+    const Vector3D& p0 = nodes[nodeIds[0]].position;
     
-    for (size_t i = 1; i < face.nodeIds.size() - 1; ++i) {
-        const Vector3D& p1 = nodes[face.nodeIds[i]].position;
-        const Vector3D& p2 = nodes[face.nodeIds[i + 1]].position;
+    for (size_t i = 1; i < nodeIds.size() - 1; ++i) {
+        const Vector3D& p1 = nodes[nodeIds[i]].position;
+        const Vector3D& p2 = nodes[nodeIds[i + 1]].position;
         
         Vector3D v1 = p1 - p0;
         Vector3D v2 = p2 - p0;
@@ -126,104 +217,324 @@ double Mesh::computeFaceArea(const Face& face) const {
     return totalArea;
 }
 
-void Mesh::computeFaceGeometry(int faceId) {
+void Mesh::computeFaceGeometry(label faceId) {
     Face& face = faces[faceId];
     face.centroid = computeFaceCentroid(face);
     face.normal = computeFaceNormal(face);
     face.area = computeFaceArea(face);
+    
+    if (faceId < geometry.getNumFaces()) {
+        storeFaceGeometry(faceId);
+    }
+}
+
+void Mesh::storeFaceGeometry(label faceId) {
+    const Face& face = faces[faceId];
+    geometry.faceAreaX[faceId] = face.normal.x * face.area;
+    geometry.faceAreaY[faceId] = face.normal.y * face.area;
+    geometry.faceAreaZ[faceId] = face.normal.z * face.area;
+    geometry.faceCentroidX[faceId] = face.centroid.x;
+    geometry.faceCentroidY[faceId] = face.centroid.y;
+    geometry.faceCentroidZ[faceId] = face.centroid.z;
 }
 
 Vector3D Mesh::computeCellCentroid(const Cell& cell) const {
-    Vector3D centroid(0, 0, 0);
-    int nodeCount = 0;
-    
-    std::set<int> uniqueNodes;
-    for (int faceId : cell.faceIds) {
-        const Face& face = faces[faceId];
-        for (int nodeId : face.nodeIds) {
-            uniqueNodes.insert(nodeId);
-        }
+    CellNodeSet uniqueNodes(*this, cell.id);
+    if (uniqueNodes.size() == 0) {
+        return Vector3D(0, 0, 0);
     }
     
-    for (int nodeId : uniqueNodes) {
+    Vector3D centroid(0, 0, 0);
+    for (label nodeId : uniqueNodes) {
         centroid += nodes[nodeId].position;
-        nodeCount++;
     }
     
-    return centroid / static_cast<double>(nodeCount);
+    return centroid / static_cast<double>(uniqueNodes.size());
 }
 
 double Mesh::computeCellVolume(const Cell& cell) const {
-    // Approximate volume using divergence theorem
-    // V = (1/3) * sum(face_area * distance_to_centroid)
+    // Divergence theorem: V = (1/3) * sum(S_f . (x_f - x_c)) with S_f
+    // pointing out of this cell, i.e. flipped for faces the cell does not own
     double volume = 0.0;
     Vector3D cellCenter = cell.centroid;
     
-    for (int faceId : cell.faceIds) {
+    for (label faceId : getCellFacesView(cell.id)) {
         const Face& face = faces[faceId];
         Vector3D r = face.centroid - cellCenter;
         double contribution = face.area * r.dot(face.normal);
-        volume += contribution;
+        volume += (face.ownerCell == cell.id) ? contribution : -contribution;
     }
     
     return std::abs(volume / 3.0);
 }
 
-void Mesh::computeCellGeometry(int cellId) {
+void Mesh::computeCellGeometry(label cellId) {
     Cell& cell = cells[cellId];
     cell.centroid = computeCellCentroid(cell);
     cell.volume = computeCellVolume(cell);
+    
+    if (cellId < geometry.getNumCells()) {
+        storeCellGeometry(cellId);
+    }
+}
+
+void Mesh::storeCellGeometry(label cellId) {
+    const Cell& cell = cells[cellId];
+    geometry.cellCentroidX[cellId] = cell.centroid.x;
+    geometry.cellCentroidY[cellId] = cell.centroid.y;
+    geometry.cellCentroidZ[cellId] = cell.centroid.z;
+    geometry.cellVolume[cellId] = cell.volume;
+    geometry.cellInvVolume[cellId] = (cell.volume > 0.0) ? 1.0 / cell.volume : 0.0;
+}
+
+void Mesh::storeFaceFactors(label faceId) {
+    const Face& face = faces[faceId];
+    if (face.ownerCell < 0) {
+        geometry.faceWeight[faceId] = 1.0;
+        geometry.faceDeltaCoeff[faceId] = 0.0;
+        geometry.faceLaplacianCoeff[faceId] = 0.0;
+        geometry.faceNonOrthX[faceId] = 0.0;
+        geometry.faceNonOrthY[faceId] = 0.0;
+        geometry.faceNonOrthZ[faceId] = 0.0;
+        return;
+    }
+    
+    const Vector3D& ownerCentroid = cells[face.ownerCell].centroid;
+    const Vector3D& n = face.normal;
+    
+    Vector3D d;
+    double weight = 1.0;
+    if (face.isBoundary()) {
+        d = face.centroid - ownerCentroid;
+    } else {
+        const Vector3D& neighborCentroid = cells[face.neighborCell].centroid;
+        d = neighborCentroid - ownerCentroid;
+        double ownerDistance = n.dot(face.centroid - ownerCentroid);
+        double neighborDistance = n.dot(neighborCentroid - face.centroid);
+        double total = ownerDistance + neighborDistance;
+        weight = (total > 0.0) ? neighborDistance / total : 0.5;
+    }
+    
+    // Limit the delta coefficient on highly skewed faces
+    double normalDistance = std::max(n.dot(d), 0.05 * d.magnitude());
+    double deltaCoeff = (normalDistance > 0.0) ? 1.0 / normalDistance : 0.0;
+    
+    geometry.faceWeight[faceId] = weight;
+    geometry.faceDeltaCoeff[faceId] = deltaCoeff;
+    geometry.faceLaplacianCoeff[faceId] = face.area * deltaCoeff;
+    geometry.faceNonOrthX[faceId] = n.x - d.x * deltaCoeff;
+    geometry.faceNonOrthY[faceId] = n.y - d.y * deltaCoeff;
+    geometry.faceNonOrthZ[faceId] = n.z - d.z * deltaCoeff;
+}
+
+void Mesh::computeFaceFactors() {
+    const label numFaces = getNumFaces();
+    for (auto* arr : {&geometry.faceWeight, &geometry.faceDeltaCoeff, &geometry.faceLaplacianCoeff,
+                      &geometry.faceNonOrthX, &geometry.faceNonOrthY, &geometry.faceNonOrthZ}) {
+        arr->resize(numFaces);
+    }
+    
+    #pragma omp parallel for schedule(static)
+    for (label i = 0; i < numFaces; ++i) {
+        storeFaceFactors(i);
+    }
+    geometryVersion++;
 }
 
 void Mesh::computeAllGeometry() {
-    // Compute face geometry first
-    for (int i = 0; i < getNumFaces(); ++i) {
+    geometry.resize(getNumFaces(), getNumCells());
+    
+    const label numFaces = getNumFaces();
+    const label numCells = getNumCells();
+    
+    // Compute face geometry first; each face only writes its own entries
+    #pragma omp parallel for schedule(static)
+    for (label i = 0; i < numFaces; ++i) {
         computeFaceGeometry(i);
     }
     
-    // Then compute cell geometry
-    for (int i = 0; i < getNumCells(); ++i) {
+    // Then compute cell geometry from the finished faces
+    #pragma omp parallel for schedule(static)
+    for (label i = 0; i < numCells; ++i) {
         computeCellGeometry(i);
     }
+    
+    computeFaceFactors();
+    clearMovedNodes();
+}
+
+void Mesh::setNodePosition(label nodeId, const Vector3D& position) {
+    nodes[nodeId].position = position;
+    markNodeMoved(nodeId);
+}
+
+void Mesh::translateNodes(const std::vector<label>& nodeIds, const Vector3D& offset) {
+    const label count = static_cast<label>(nodeIds.size());
+    
+    #pragma omp parallel for schedule(static)
+    for (label i = 0; i < count; ++i) {
+        nodes[nodeIds[i]].position += offset;
+    }
+    
+    for (label nodeId : nodeIds) {
+        markNodeMoved(nodeId);
+    }
+}
+
+void Mesh::markNodeMoved(label nodeId) {
+    if (nodeMovedFlags.size() != nodes.size()) {
+        nodeMovedFlags.resize(nodes.size(), 0);
+    }
+    if (!nodeMovedFlags[nodeId]) {
+        nodeMovedFlags[nodeId] = 1;
+        movedNodes.push_back(nodeId);
+    }
+}
+
+void Mesh::clearMovedNodes() {
+    for (label nodeId : movedNodes) {
+        nodeMovedFlags[nodeId] = 0;
+    }
+    movedNodes.clear();
+}
+
+label Mesh::updateGeometry() {
+    if (movedNodes.empty()) {
+        return 0;
+    }
+    
+    bool hasGeometry = (geometry.getNumFaces() == getNumFaces() && geometry.getNumCells() == getNumCells());
+    if (!hasGeometry || nodeCells.getNumRows() != getNumNodes()) {
+        computeAllGeometry();
+        return getNumCells();
+    }
+    
+    // Every cell containing a moved node, and the faces of those cells
+    // with at least one moved node. Marks are reset afterwards, so the
+    // cost is proportional to the moved region.
+    cellUpdateMarks.resize(getNumCells(), 0);
+    faceUpdateMarks.resize(getNumFaces(), 0);
+    
+    std::vector<label> dirtyCells;
+    for (label nodeId : movedNodes) {
+        for (label cellId : nodeCells.row(nodeId)) {
+            if (!cellUpdateMarks[cellId]) {
+                cellUpdateMarks[cellId] = 1;
+                dirtyCells.push_back(cellId);
+            }
+        }
+    }
+    
+    std::vector<label> dirtyFaces;
+    for (label cellId : dirtyCells) {
+        for (label faceId : cellFaces.row(cellId)) {
+            if (faceUpdateMarks[faceId]) continue;
+            for (label nodeId : faceNodes.row(faceId)) {
+                if (nodeMovedFlags[nodeId]) {
+                    faceUpdateMarks[faceId] = 1;
+                    dirtyFaces.push_back(faceId);
+                    break;
+                }
+            }
+        }
+    }
+    for (label faceId : dirtyFaces) faceUpdateMarks[faceId] = 0;
+    
+    const label numDirtyFaces = static_cast<label>(dirtyFaces.size());
+    const label numDirtyCells = static_cast<label>(dirtyCells.size());
+    
+    #pragma omp parallel for schedule(static)
+    for (label i = 0; i < numDirtyFaces; ++i) {
+        computeFaceGeometry(dirtyFaces[i]);
+    }
+    
+    #pragma omp parallel for schedule(static)
+    for (label i = 0; i < numDirtyCells; ++i) {
+        computeCellGeometry(dirtyCells[i]);
+    }
+    
+    // Face factors also depend on both cell centroids, so every face of a
+    // moved cell is refreshed
+    std::vector<label> factorFaces;
+    for (label cellId : dirtyCells) {
+        for (label faceId : cellFaces.row(cellId)) {
+            if (!faceUpdateMarks[faceId]) {
+                faceUpdateMarks[faceId] = 1;
+                factorFaces.push_back(faceId);
+            }
+        }
+    }
+    for (label cellId : dirtyCells) cellUpdateMarks[cellId] = 0;
+    for (label faceId : factorFaces) faceUpdateMarks[faceId] = 0;
+    
+    const label numFactorFaces = static_cast<label>(factorFaces.size());
+    #pragma omp parallel for schedule(static)
+    for (label i = 0; i < numFactorFaces; ++i) {
+        storeFaceFactors(factorFaces[i]);
+    }
+    
+    clearMovedNodes();
+    geometryVersion++;
+    return numDirtyCells;
 }
 
 void Mesh::buildCellNeighbors() {
-    // Clear existing connectivity
-    for (auto& cell : cells) {
-        cell.neighborCells.clear();
+    // Count internal faces per cell, then scatter in face order
+    std::vector<label> counts(getNumCells(), 0);
+    for (const auto& face : faces) {
+        if (face.ownerCell >= 0 && face.neighborCell >= 0) {
+            counts[face.ownerCell]++;
+            counts[face.neighborCell]++;
+        }
     }
     
-    // Build neighbor lists from faces
+    cellNeighbors.allocateFromCounts(counts);
+    std::vector<label> cursor(cellNeighbors.offsets.begin(), cellNeighbors.offsets.end() - 1);
     for (const auto& face : faces) {
         if (face.ownerCell >= 0 && face.neighborCell >= 0) {
-            cells[face.ownerCell].neighborCells.push_back(face.neighborCell);
-            cells[face.neighborCell].neighborCells.push_back(face.ownerCell);
+            cellNeighbors.indices[cursor[face.ownerCell]++] = face.neighborCell;
+            cellNeighbors.indices[cursor[face.neighborCell]++] = face.ownerCell;
         }
     }
 }
 
 void Mesh::buildNodeCellConnectivity() {
-    // Clear existing connectivity
-    for (auto& node : nodes) {
-        node.connectedCells.clear();
-    }
+    const label numNodes = getNumNodes();
+    const label numCells = getNumCells();
     
-    // Build node-to-cell connectivity
-    for (int cellId = 0; cellId < getNumCells(); ++cellId) {
-        const Cell& cell = cells[cellId];
-        
-        std::set<int> uniqueNodes;
-        for (int faceId : cell.faceIds) {
-            const Face& face = faces[faceId];
-            for (int nodeId : face.nodeIds) {
-                uniqueNodes.insert(nodeId);
-            }
+    // Pass 1: count distinct cells per node
+    std::vector<label> counts(numNodes, 0);
+    #pragma omp parallel for schedule(static)
+    for (label cellId = 0; cellId < numCells; ++cellId) {
+        CellNodeSet cellNodes(*this, cellId);
+        for (label nodeId : cellNodes) {
+            #pragma omp atomic
+            counts[nodeId]++;
         }
-        
-        for (int nodeId : uniqueNodes) {
-            nodes[nodeId].connectedCells.push_back(cellId);
+    }
+    
+    // Pass 2: scatter cell ids into the allocated rows
+    nodeCells.allocateFromCounts(counts);
+    std::vector<label> cursor(nodeCells.offsets.begin(), nodeCells.offsets.end() - 1);
+    
+    #pragma omp parallel for schedule(static)
+    for (label cellId = 0; cellId < numCells; ++cellId) {
+        CellNodeSet cellNodes(*this, cellId);
+        for (label nodeId : cellNodes) {
+            label slot;
+            #pragma omp atomic capture
+            slot = cursor[nodeId]++;
+            nodeCells.indices[slot] = cellId;
         }
     }
+    
+    // Scatter order depends on thread timing; sort rows so the result is
+    // identical to a serial build (ascending cell id per node)
+    #pragma omp parallel for schedule(static)
+    for (label nodeId = 0; nodeId < numNodes; ++nodeId) {
+        Span<label> row = nodeCells.row(nodeId);
+        std::sort(row.begin(), row.end());
+    }
 }
 
 void Mesh::buildConnectivity() {
@@ -231,10 +542,247 @@ void Mesh::buildConnectivity() {
     buildNodeCellConnectivity();
 }
 
+namespace {
+
+std::vector<label> invertPermutation(const std::vector<label>& newToOld, label size, const char* what) {
+    if (static_cast<label>(newToOld.size()) != size) {
+        throw std::invalid_argument(std::string("Permutation size mismatch for ") + what);
+    }
+    std::vector<label> oldToNew(size, -1);
+    for (label newId = 0; newId < size; ++newId) {
+        label oldId = newToOld[newId];
+        if (oldId < 0 || oldId >= size || oldToNew[oldId] != -1) {
+            throw std::invalid_argument(std::string("Invalid permutation for ") + what);
+        }
+        oldToNew[oldId] = newId;
+    }
+    return oldToNew;
+}
+
+} // anonymous namespace
+
+void Mesh::permute(const std::vector<label>& cellNewToOld,
+                   const std::vector<label>& faceNewToOld,
+                   const std::vector<label>& nodeNewToOld) {
+    const label numCells = getNumCells();
+    const label numFaces = getNumFaces();
+    const label numNodes = getNumNodes();
+    
+    std::vector<label> cellOldToNew = invertPermutation(cellNewToOld, numCells, "cells");
+    std::vector<label> faceOldToNew = invertPermutation(faceNewToOld, numFaces, "faces");
+    std::vector<label> nodeOldToNew = invertPermutation(nodeNewToOld, numNodes, "nodes");
+    
+    bool hadConnectivity = (cellNeighbors.getNumRows() == numCells && numCells > 0);
+    bool hadGeometry = (geometry.getNumFaces() == numFaces && geometry.getNumCells() == numCells);
+    
+    // Nodes
+    std::vector<Node> newNodes(numNodes);
+    for (label newId = 0; newId < numNodes; ++newId) {
+        newNodes[newId] = nodes[nodeNewToOld[newId]];
+        newNodes[newId].id = newId;
+    }
+    nodes.swap(newNodes);
+    
+    // Pending motion follows the nodes
+    std::vector<label> moved;
+    moved.swap(movedNodes);
+    nodeMovedFlags.clear();
+    for (label nodeId : moved) {
+        markNodeMoved(nodeOldToNew[nodeId]);
+    }
+    
+    // Faces and face -> node
+    std::vector<Face> newFaces(numFaces);
+    CSRConnectivity newFaceNodes;
+    newFaceNodes.reserve(numFaces, faceNodes.getNumEntries());
+    for (label newId = 0; newId < numFaces; ++newId) {
+        label oldId = faceNewToOld[newId];
+        Face face = faces[oldId];
+        face.id = newId;
+        face.ownerCell = (face.ownerCell >= 0) ? cellOldToNew[face.ownerCell] : -1;
+        face.neighborCell = (face.neighborCell >= 0) ? cellOldToNew[face.neighborCell] : -1;
+        
+        Span<const label> oldRow = faceNodes.row(oldId);
+        size_t rowStart = newFaceNodes.indices.size();
+        for (label nodeId : oldRow) {
+            newFaceNodes.indices.push_back(nodeOldToNew[nodeId]);
+        }
+        
+        // Keep owner < neighbor; flipping the owner reverses the orientation
+        if (face.neighborCell >= 0 && face.ownerCell > face.neighborCell) {
+            std::swap(face.ownerCell, face.neighborCell);
+            std::reverse(newFaceNodes.indices.begin() + rowStart, newFaceNodes.indices.end());
+            face.normal = face.normal * -1.0;
+        }
+        newFaceNodes.offsets.push_back(static_cast<label>(newFaceNodes.indices.size()));
+        newFaces[newId] = face;
+    }
+    faces.swap(newFaces);
+    faceNodes = std::move(newFaceNodes);
+    
+    // Cells and cell -> face
+    std::vector<Cell> newCells(numCells);
+    CSRConnectivity newCellFaces;
+    newCellFaces.reserve(numCells, cellFaces.getNumEntries());
+    for (label newId = 0; newId < numCells; ++newId) {
+        label oldId = cellNewToOld[newId];
+        newCells[newId] = cells[oldId];
+        newCells[newId].id = newId;
+        for (label faceId : cellFaces.row(oldId)) {
+            newCellFaces.indices.push_back(faceOldToNew[faceId]);
+        }
+        newCellFaces.offsets.push_back(static_cast<label>(newCellFaces.indices.size()));
+    }
+    cells.swap(newCells);
+    cellFaces = std::move(newCellFaces);
+    
+    // Boundary patches
+    for (auto& pair : boundaries) {
+        for (label& faceId : pair.second.faceIds) {
+            faceId = faceOldToNew[faceId];
+        }
+        std::sort(pair.second.faceIds.begin(), pair.second.faceIds.end());
+    }
+    
+    // Derived data
+    if (hadConnectivity) {
+        buildConnectivity();
+    } else {
+        cellNeighbors.clear();
+        nodeCells.clear();
+    }
+    
+    if (hadGeometry) {
+        for (label f = 0; f < numFaces; ++f) {
+            storeFaceGeometry(f);
+        }
+        for (label c = 0; c < numCells; ++c) {
+            storeCellGeometry(c);
+        }
+        computeFaceFactors();
+    } else {
+        geometry.clear();
+        geometryVersion++;
+    }
+    
+    updateFaceOrdering();
+}
+
+std::vector<label> Mesh::computeOrderedFaceList(const std::vector<label>& cellNewToOld) const {
+    const label numFaces = getNumFaces();
+    
+    std::vector<label> cellOldToNew(getNumCells());
+    if (cellNewToOld.empty()) {
+        std::iota(cellOldToNew.begin(), cellOldToNew.end(), 0);
+    } else {
+        cellOldToNew = invertPermutation(cellNewToOld, getNumCells(), "cells");
+    }
+    
+    // Sort key: (group, lower cell, upper cell). Group 0 holds internal
+    // faces, group 1 + p patch p, and the last group unassigned boundaries.
+    std::vector<label> group(numFaces, static_cast<label>(boundaries.size()) + 1);
+    label patchIndex = 1;
+    for (const auto& pair : boundaries) {
+        for (label faceId : pair.second.faceIds) {
+            group[faceId] = patchIndex;
+        }
+        patchIndex++;
+    }
+    
+    struct FaceKey {
+        label group, lower, upper, face;
+        bool operator<(const FaceKey& o) const {
+            if (group != o.group) return group < o.group;
+            if (lower != o.lower) return lower < o.lower;
+            if (upper != o.upper) return upper < o.upper;
+            return face < o.face;
+        }
+    };
+    
+    std::vector<FaceKey> keys(numFaces);
+    for (label f = 0; f < numFaces; ++f) {
+        const Face& face = faces[f];
+        label owner = (face.ownerCell >= 0) ? cellOldToNew[face.ownerCell] : -1;
+        if (face.ownerCell >= 0 && face.neighborCell >= 0) {
+            label neighbor = cellOldToNew[face.neighborCell];
+            keys[f] = {0, std::min(owner, neighbor), std::max(owner, neighbor), f};
+        } else {
+            keys[f] = {group[f], owner, -1, f};
+        }
+    }
+    std::sort(keys.begin(), keys.end());
+    
+    std::vector<label> order(numFaces);
+    for (label i = 0; i < numFaces; ++i) {
+        order[i] = keys[i].face;
+    }
+    return order;
+}
+
+void Mesh::orderFaces() {
+    std::vector<label> cellIdentity(getNumCells());
+    std::vector<label> nodeIdentity(getNumNodes());
+    std::iota(cellIdentity.begin(), cellIdentity.end(), 0);
+    std::iota(nodeIdentity.begin(), nodeIdentity.end(), 0);
+    permute(cellIdentity, computeOrderedFaceList(), nodeIdentity);
+}
+
+bool Mesh::updateFaceOrdering() {
+    const label numFaces = getNumFaces();
+    facesOrdered = false;
+    
+    // Internal faces must form a prefix
+    label internalCount = 0;
+    while (internalCount < numFaces && !faces[internalCount].isBoundary()) {
+        internalCount++;
+    }
+    for (label f = internalCount; f < numFaces; ++f) {
+        if (!faces[f].isBoundary()) {
+            return false;
+        }
+    }
+    
+    // Each patch must be one contiguous, sorted run of boundary faces
+    for (const auto& pair : boundaries) {
+        const std::vector<label>& ids = pair.second.faceIds;
+        for (size_t i = 1; i < ids.size(); ++i) {
+            if (ids[i] != ids[i - 1] + 1) {
+                return false;
+            }
+        }
+        if (!ids.empty() && ids.front() < internalCount) {
+            return false;
+        }
+    }
+    
+    for (auto& pair : boundaries) {
+        BoundaryPatch& patch = pair.second;
+        patch.startFace = patch.faceIds.empty() ? internalCount : patch.faceIds.front();
+        patch.numFaces = static_cast<label>(patch.faceIds.size());
+    }
+    numInternalFaces = internalCount;
+    facesOrdered = true;
+    return true;
+}
+
+label Mesh::computeBandwidth() const {
+    label bandwidth = 0;
+    for (const auto& face : faces) {
+        if (face.ownerCell >= 0 && face.neighborCell >= 0) {
+            bandwidth = std::max(bandwidth, std::abs(face.ownerCell - face.neighborCell));
+        }
+    }
+    return bandwidth;
+}
+
 bool Mesh::validate() const {
+    if (faceNodes.getNumRows() != getNumFaces() || cellFaces.getNumRows() != getNumCells()) {
+        return false;
+    }
+    
     // Check for valid node IDs in faces
     for (const auto& face : faces) {
-        for (int nodeId : face.nodeIds) {
+        for (label nodeId : faceNodes.row(face.id)) {
             if (nodeId < 0 || nodeId >= getNumNodes()) {
                 return false;
             }
@@ -251,7 +799,7 @@ bool Mesh::validate() const {
     
     // Check for valid face IDs in cells
     for (const auto& cell : cells) {
-        for (int faceId : cell.faceIds) {
+        for (label faceId : cellFaces.row(cell.id)) {
             if (faceId < 0 || faceId >= getNumFaces()) {
                 return false;
             }
@@ -16,7 +16,7 @@ void BoundaryExtractor::extractBoundaries(const std::vector<Surface>& surfaces)
 void BoundaryExtractor::extractByNormal(const std::vector<Surface>& surfaces, double angleTolerance) {
     clear();
     
-    int triangleIndex = 0;
+    label triangleIndex = 0;
     
     for (const auto& surface : surfaces) {
         for (const auto& tri : surface.triangles) {
@@ -60,7 +60,7 @@ void BoundaryExtractor::extractByUserDefinition(const std::vector<Surface>& surf
     }
     
     // Assign triangles to regions
-    int triangleIndex = 0;
+    label triangleIndex = 0;
     double angleTolerance = 30.0;  // Default tolerance
     
     for (const auto& surface : surfaces) {
@@ -88,7 +88,7 @@ void BoundaryExtractor::extractByUserDefinition(const std::vector<Surface>& surf
     computeRegionStatistics();
 }
 
-void BoundaryExtractor::assignTriangleToRegion(int triangleIndex, const Triangle& tri, int regionIndex) {
+void BoundaryExtractor::assignTriangleToRegion(label triangleIndex, const Triangle& tri, int regionIndex) {
     regions[regionIndex].triangleIndices.push_back(triangleIndex);
     regions[regionIndex].totalArea += tri.area();
 }
@@ -2,8 +2,8 @@
 
 namespace cfd {
 
-int GeometryReader::getNumTriangles() const {
-    int count = 0;
+label GeometryReader::getNumTriangles() const {
+    label count = 0;
     for (const auto& surface : surfaces) {
         count += surface.getNumTriangles();
     }
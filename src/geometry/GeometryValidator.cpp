@@ -66,15 +66,15 @@ bool GeometryValidator::checkEdgeManifoldness(const std::vector<Surface>& surfac
     bool valid = true;
     
     // Build vertex map
-    std::map<Vector3D, int> vertexMap;
+    std::map<Vector3D, label> vertexMap;
     std::vector<Vector3D> vertices;
     buildVertexMap(surfaces, vertexMap, vertices);
-    totalVertices = static_cast<int>(vertices.size());
+    totalVertices = static_cast<label>(vertices.size());
     
     // Build edge map
     std::map<Edge, int> edgeCount;
     buildEdgeMap(surfaces, vertexMap, edgeCount);
-    totalEdges = static_cast<int>(edgeCount.size());
+    totalEdges = static_cast<label>(edgeCount.size());
     
     // Check edge counts
     for (const auto& pair : edgeCount) {
@@ -103,7 +103,7 @@ bool GeometryValidator::checkClosedVolume(const std::vector<Surface>& surfaces)
     bool valid = true;
     
     // Build vertex map
-    std::map<Vector3D, int> vertexMap;
+    std::map<Vector3D, label> vertexMap;
     std::vector<Vector3D> vertices;
     buildVertexMap(surfaces, vertexMap, vertices);
     
@@ -145,7 +145,7 @@ bool GeometryValidator::checkNormalConsistency(const std::vector<Surface>& surfa
     bool valid = true;
     
     // Build vertex map
-    std::map<Vector3D, int> vertexMap;
+    std::map<Vector3D, label> vertexMap;
     std::vector<Vector3D> vertices;
     buildVertexMap(surfaces, vertexMap, vertices);
     
@@ -155,9 +155,9 @@ bool GeometryValidator::checkNormalConsistency(const std::vector<Surface>& surfa
     for (const auto& surface : surfaces) {
         for (const auto& tri : surface.triangles) {
             // Get vertex indices
-            int v0 = getVertexIndex(tri.vertices[0], vertexMap, vertices);
-            int v1 = getVertexIndex(tri.vertices[1], vertexMap, vertices);
-            int v2 = getVertexIndex(tri.vertices[2], vertexMap, vertices);
+            label v0 = getVertexIndex(tri.vertices[0], vertexMap, vertices);
+            label v1 = getVertexIndex(tri.vertices[1], vertexMap, vertices);
+            label v2 = getVertexIndex(tri.vertices[2], vertexMap, vertices);
             
             // Add normal for each edge
             edgeNormals[Edge(v0, v1)].push_back(tri.normal);
@@ -195,7 +195,7 @@ bool GeometryValidator::checkNormalConsistency(const std::vector<Surface>& surfa
 }
 
 void GeometryValidator::buildVertexMap(const std::vector<Surface>& surfaces,
-                                      std::map<Vector3D, int>& vertexMap,
+                                      std::map<Vector3D, label>& vertexMap,
                                       std::vector<Vector3D>& vertices) {
     vertexMap.clear();
     vertices.clear();
@@ -210,7 +210,7 @@ void GeometryValidator::buildVertexMap(const std::vector<Surface>& surfaces,
 }
 
 void GeometryValidator::buildEdgeMap(const std::vector<Surface>& surfaces,
-                                    const std::map<Vector3D, int>& vertexMap,
+                                    const std::map<Vector3D, label>& vertexMap,
                                     std::map<Edge, int>& edgeCount) {
     edgeCount.clear();
     
@@ -222,9 +222,9 @@ void GeometryValidator::buildEdgeMap(const std::vector<Surface>& surfaces,
             auto it2 = vertexMap.find(tri.vertices[2]);
             
             if (it0 != vertexMap.end() && it1 != vertexMap.end() && it2 != vertexMap.end()) {
-                int v0 = it0->second;
-                int v1 = it1->second;
-                int v2 = it2->second;
+                label v0 = it0->second;
+                label v1 = it1->second;
+                label v2 = it2->second;
                 
                 // Count each edge
                 edgeCount[Edge(v0, v1)]++;
@@ -235,15 +235,15 @@ void GeometryValidator::buildEdgeMap(const std::vector<Surface>& surfaces,
     }
 }
 
-int GeometryValidator::getVertexIndex(const Vector3D& v,
-                                     std::map<Vector3D, int>& vertexMap,
-                                     std::vector<Vector3D>& vertices) {
+label GeometryValidator::getVertexIndex(const Vector3D& v,
+                                       std::map<Vector3D, label>& vertexMap,
+                                       std::vector<Vector3D>& vertices) {
     auto it = vertexMap.find(v);
     if (it != vertexMap.end()) {
         return it->second;
     }
     
-    int index = static_cast<int>(vertices.size());
+    label index = static_cast<label>(vertices.size());
     vertices.push_back(v);
     vertexMap[v] = index;
     return index;
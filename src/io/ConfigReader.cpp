@@ -107,6 +107,7 @@ private:
             return value;
         }
         while (true) {
+            skipWhitespace();
             value.array.push_back(parseValue());
             skipWhitespace();
             if (peek() == ']') {
@@ -211,7 +212,7 @@ private:
         return input_[pos_];
     }
 
-    const std::string& input_;
+    std::string input_;
     size_t pos_ = 0;
 };
 
@@ -312,6 +313,16 @@ ConfigReader ConfigReader::fromFile(const std::string& path) {
                     reader.errors_.push_back("mesh.boundaryLayers must be an integer.");
                 }
             }
+            if (const JsonValue* renumbering = findObject(*mesh, "renumbering")) {
+                if (!loadString(*renumbering, reader.config_.mesh.renumbering)) {
+                    reader.errors_.push_back("mesh.renumbering must be a string.");
+                }
+            }
+            if (const JsonValue* file = findObject(*mesh, "file")) {
+                if (!loadString(*file, reader.config_.mesh.file)) {
+                    reader.errors_.push_back("mesh.file must be a string.");
+                }
+            }
         } else {
             reader.warnings_.push_back("Mesh section missing. Using defaults.");
         }
@@ -391,6 +402,10 @@ ConfigReader ConfigReader::fromFile(const std::string& path) {
         if (reader.config_.mesh.baseSize <= 0.0) {
             reader.errors_.push_back("mesh.baseSize must be greater than zero.");
         }
+        const std::string& renumbering = reader.config_.mesh.renumbering;
+        if (renumbering != "none" && renumbering != "rcm" && renumbering != "morton" && renumbering != "hilbert") {
+            reader.errors_.push_back("mesh.renumbering must be one of none, rcm, morton, hilbert.");
+        }
         if (reader.config_.simulation.endTime < reader.config_.simulation.startTime) {
             reader.errors_.push_back("simulation.endTime must be >= simulation.startTime.");
         }
@@ -420,6 +435,8 @@ std::string ConfigReader::summarize() const {
     summary << "Geometry scale: " << config_.geometry.scale << "\n";
     summary << "Mesh base size: " << config_.mesh.baseSize << "\n";
     summary << "Mesh boundary layers: " << config_.mesh.boundaryLayers << "\n";
+    summary << "Mesh renumbering: " << config_.mesh.renumbering << "\n";
+    summary << "Mesh file: " << config_.mesh.file << "\n";
     summary << "Simulation window: " << config_.simulation.startTime << " -> " << config_.simulation.endTime << "\n";
     summary << "Time step: " << config_.simulation.timeStep << "\n";
     summary << "Output interval: " << config_.simulation.outputInterval << "\n";
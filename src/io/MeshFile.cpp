@@ -0,0 +1,481 @@
+#include "io/MeshFile.h"
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define CFD_HAS_MMAP 1
+#endif
+
+namespace cfd {
+
+constexpr char MeshFile::MAGIC[8];
+
+namespace {
+
+constexpr uint64_t SECTION_ALIGNMENT = 64;
+
+static_assert(std::is_trivially_copyable<MeshFile::Header>::value,
+              "MeshFile::Header must be trivially copyable");
+
+bool isLittleEndianHost() {
+    uint32_t value = 1;
+    unsigned char firstByte;
+    std::memcpy(&firstByte, &value, 1);
+    return firstByte == 1;
+}
+
+/**
+ * @brief Appends 64-byte aligned sections and records them in the header
+ */
+class SectionWriter {
+public:
+    SectionWriter(std::ofstream& out_, MeshFile::Header& header_)
+        : out(out_), header(header_), position(sizeof(MeshFile::Header)) {}
+
+    void write(MeshFile::Section section, const void* data, uint64_t bytes) {
+        static const char zeros[SECTION_ALIGNMENT] = {};
+        uint64_t padding = (SECTION_ALIGNMENT - position % SECTION_ALIGNMENT) % SECTION_ALIGNMENT;
+        out.write(zeros, static_cast<std::streamsize>(padding));
+        position += padding;
+
+        header.sectionOffset[section] = position;
+        header.sectionBytes[section] = bytes;
+        if (bytes > 0) {
+            out.write(static_cast<const char*>(data), static_cast<std::streamsize>(bytes));
+        }
+        position += bytes;
+    }
+
+    template <typename Container>
+    void writeArray(MeshFile::Section section, const Container& values) {
+        write(section, values.data(), values.size() * sizeof(typename Container::value_type));
+    }
+
+private:
+    std::ofstream& out;
+    MeshFile::Header& header;
+    uint64_t position;
+};
+
+/**
+ * @brief Read-only view of a whole file (mmap where available)
+ */
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& path) : bytes(nullptr), length(0) {
+#ifdef CFD_HAS_MMAP
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::runtime_error("Unable to open mesh file: " + path);
+        }
+        struct stat info;
+        if (::fstat(fd, &info) != 0) {
+            ::close(fd);
+            throw std::runtime_error("Unable to stat mesh file: " + path);
+        }
+        length = static_cast<size_t>(info.st_size);
+        if (length > 0) {
+            void* addr = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (addr == MAP_FAILED) {
+                ::close(fd);
+                throw std::runtime_error("Unable to map mesh file: " + path);
+            }
+            ::madvise(addr, length, MADV_SEQUENTIAL);
+            bytes = static_cast<const unsigned char*>(addr);
+        }
+        ::close(fd);
+#else
+        std::ifstream in(path, std::ios::binary | std::ios::ate);
+        if (!in) {
+            throw std::runtime_error("Unable to open mesh file: " + path);
+        }
+        length = static_cast<size_t>(in.tellg());
+        buffer.resize(length);
+        in.seekg(0);
+        in.read(reinterpret_cast<char*>(buffer.data()), static_cast<std::streamsize>(length));
+        bytes = buffer.data();
+#endif
+    }
+
+    ~MappedFile() {
+#ifdef CFD_HAS_MMAP
+        if (bytes) {
+            ::munmap(const_cast<unsigned char*>(bytes), length);
+        }
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const unsigned char* data() const { return bytes; }
+    size_t size() const { return length; }
+
+private:
+    const unsigned char* bytes;
+    size_t length;
+#ifndef CFD_HAS_MMAP
+    std::vector<unsigned char> buffer;
+#endif
+};
+
+// Typed pointer to a section, checked against the expected element count
+template <typename T>
+const T* sectionData(const MappedFile& file, const MeshFile::Header& header,
+                     MeshFile::Section section, uint64_t count) {
+    uint64_t offset = header.sectionOffset[section];
+    uint64_t bytes = header.sectionBytes[section];
+    if (bytes != count * sizeof(T) || offset + bytes > file.size() || offset % alignof(T) != 0) {
+        throw std::runtime_error("Corrupt mesh file: bad section " + std::to_string(section));
+    }
+    return reinterpret_cast<const T*>(file.data() + offset);
+}
+
+template <typename T, typename Container>
+void copySection(const MappedFile& file, const MeshFile::Header& header,
+                 MeshFile::Section section, uint64_t count, Container& out) {
+    const T* src = sectionData<T>(file, header, section, count);
+    out.assign(src, src + count);
+}
+
+// Offsets must start at 0 and never decrease (their count and last value
+// are checked against the section sizes), and every index must lie in
+// [0, numTargets): a corrupt table would otherwise read out of bounds
+void checkConnectivity(const CSRConnectivity& table, uint64_t numTargets, const char* name) {
+    bool valid = table.offsets.front() == 0;
+    for (size_t r = 1; r < table.offsets.size(); ++r) {
+        valid &= table.offsets[r] >= table.offsets[r - 1];
+    }
+    for (label index : table.indices) {
+        valid &= index >= 0 && static_cast<uint64_t>(index) < numTargets;
+    }
+    if (!valid) {
+        throw std::runtime_error(std::string("Corrupt mesh file: invalid ") + name + " connectivity");
+    }
+}
+
+template <typename T>
+void appendPod(std::vector<char>& blob, const T& value) {
+    const char* p = reinterpret_cast<const char*>(&value);
+    blob.insert(blob.end(), p, p + sizeof(T));
+}
+
+template <typename T>
+T readPod(const unsigned char*& cursor, const unsigned char* end) {
+    if (cursor + sizeof(T) > end) {
+        throw std::runtime_error("Corrupt mesh file: truncated patch table");
+    }
+    T value;
+    std::memcpy(&value, cursor, sizeof(T));
+    cursor += sizeof(T);
+    return value;
+}
+
+} // anonymous namespace
+
+void MeshFile::write(const Mesh& mesh, const std::string& path) {
+    if (!isLittleEndianHost()) {
+        throw std::runtime_error("MeshFile only supports little-endian hosts");
+    }
+
+    const label numNodes = mesh.getNumNodes();
+    const label numFaces = mesh.getNumFaces();
+    const label numCells = mesh.getNumCells();
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error("Unable to create mesh file: " + path);
+    }
+
+    Header header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = FORMAT_VERSION;
+    header.endianTag = ENDIAN_TAG;
+    header.labelBytes = sizeof(label);
+    header.numNodes = numNodes;
+    header.numFaces = numFaces;
+    header.numCells = numCells;
+    header.numPatches = mesh.boundaries.size();
+
+    bool hasConnectivity = (mesh.cellNeighbors.getNumRows() == numCells &&
+                            mesh.nodeCells.getNumRows() == numNodes);
+    bool hasGeometry = (mesh.geometry.getNumFaces() == numFaces &&
+                        mesh.geometry.getNumCells() == numCells);
+    bool hasFaceFactors = hasGeometry && static_cast<label>(mesh.geometry.faceWeight.size()) == numFaces;
+    if (mesh.hasOrderedFaces()) header.flags |= FLAG_FACES_ORDERED;
+    if (hasConnectivity) header.flags |= FLAG_CONNECTIVITY;
+    if (hasGeometry) header.flags |= FLAG_GEOMETRY;
+    if (hasFaceFactors) header.flags |= FLAG_FACE_FACTORS;
+
+    // Header is rewritten once the section table is known
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    SectionWriter writer(out, header);
+
+    std::vector<double> positions(3 * static_cast<size_t>(numNodes));
+    for (label n = 0; n < numNodes; ++n) {
+        const Vector3D& p = mesh.nodes[n].position;
+        const size_t i = 3 * static_cast<size_t>(n);  // No label overflow
+        positions[i] = p.x;
+        positions[i + 1] = p.y;
+        positions[i + 2] = p.z;
+    }
+    writer.writeArray(NODE_POSITIONS, positions);
+
+    std::vector<label> owner(numFaces), neighbor(numFaces);
+    std::vector<double> normal(3 * static_cast<size_t>(numFaces)), area(numFaces);
+    for (label f = 0; f < numFaces; ++f) {
+        const Face& face = mesh.faces[f];
+        owner[f] = face.ownerCell;
+        neighbor[f] = face.neighborCell;
+        const size_t i = 3 * static_cast<size_t>(f);
+        normal[i] = face.normal.x;
+        normal[i + 1] = face.normal.y;
+        normal[i + 2] = face.normal.z;
+        area[f] = face.area;
+    }
+    writer.writeArray(FACE_OWNER, owner);
+    writer.writeArray(FACE_NEIGHBOR, neighbor);
+
+    writer.writeArray(FACE_NODE_OFFSETS, mesh.faceNodes.offsets);
+    writer.writeArray(FACE_NODE_INDICES, mesh.faceNodes.indices);
+    writer.writeArray(CELL_FACE_OFFSETS, mesh.cellFaces.offsets);
+    writer.writeArray(CELL_FACE_INDICES, mesh.cellFaces.indices);
+    const CSRConnectivity empty;
+    writer.writeArray(CELL_NEIGHBOR_OFFSETS, hasConnectivity ? mesh.cellNeighbors.offsets : empty.offsets);
+    writer.writeArray(CELL_NEIGHBOR_INDICES, hasConnectivity ? mesh.cellNeighbors.indices : empty.indices);
+    writer.writeArray(NODE_CELL_OFFSETS, hasConnectivity ? mesh.nodeCells.offsets : empty.offsets);
+    writer.writeArray(NODE_CELL_INDICES, hasConnectivity ? mesh.nodeCells.indices : empty.indices);
+
+    writer.writeArray(FACE_NORMAL, normal);
+    writer.writeArray(FACE_AREA, area);
+
+    // SoA geometry; rebuilt from the per-element values if never computed
+    MeshGeometry derived;
+    const MeshGeometry* geometry = &mesh.geometry;
+    if (!hasGeometry) {
+        derived.resize(numFaces, numCells);
+        for (label f = 0; f < numFaces; ++f) {
+            const Face& face = mesh.faces[f];
+            derived.faceAreaX[f] = face.normal.x * face.area;
+            derived.faceAreaY[f] = face.normal.y * face.area;
+            derived.faceAreaZ[f] = face.normal.z * face.area;
+            derived.faceCentroidX[f] = face.centroid.x;
+            derived.faceCentroidY[f] = face.centroid.y;
+            derived.faceCentroidZ[f] = face.centroid.z;
+        }
+        for (label c = 0; c < numCells; ++c) {
+            const Cell& cell = mesh.cells[c];
+            derived.cellCentroidX[c] = cell.centroid.x;
+            derived.cellCentroidY[c] = cell.centroid.y;
+            derived.cellCentroidZ[c] = cell.centroid.z;
+            derived.cellVolume[c] = cell.volume;
+            derived.cellInvVolume[c] = (cell.volume > 0.0) ? 1.0 / cell.volume : 0.0;
+        }
+        geometry = &derived;
+    }
+    writer.writeArray(FACE_AREA_X, geometry->faceAreaX);
+    writer.writeArray(FACE_AREA_Y, geometry->faceAreaY);
+    writer.writeArray(FACE_AREA_Z, geometry->faceAreaZ);
+    writer.writeArray(FACE_CENTROID_X, geometry->faceCentroidX);
+    writer.writeArray(FACE_CENTROID_Y, geometry->faceCentroidY);
+    writer.writeArray(FACE_CENTROID_Z, geometry->faceCentroidZ);
+    writer.writeArray(CELL_CENTROID_X, geometry->cellCentroidX);
+    writer.writeArray(CELL_CENTROID_Y, geometry->cellCentroidY);
+    writer.writeArray(CELL_CENTROID_Z, geometry->cellCentroidZ);
+    writer.writeArray(CELL_VOLUME, geometry->cellVolume);
+    writer.writeArray(CELL_INV_VOLUME, geometry->cellInvVolume);
+    const MeshGeometry noFactors;
+    const MeshGeometry& factors = hasFaceFactors ? mesh.geometry : noFactors;
+    writer.writeArray(FACE_WEIGHT, factors.faceWeight);
+    writer.writeArray(FACE_DELTA_COEFF, factors.faceDeltaCoeff);
+    writer.writeArray(FACE_LAPLACIAN_COEFF, factors.faceLaplacianCoeff);
+    writer.writeArray(FACE_NON_ORTH_X, factors.faceNonOrthX);
+    writer.writeArray(FACE_NON_ORTH_Y, factors.faceNonOrthY);
+    writer.writeArray(FACE_NON_ORTH_Z, factors.faceNonOrthZ);
+
+    // Patch table: per patch {uint32 nameLen, uint32 typeLen, uint64 numIds,
+    // name bytes, type bytes, int32 ids[numIds]}
+    std::vector<char> patches;
+    for (const auto& pair : mesh.boundaries) {
+        const BoundaryPatch& patch = pair.second;
+        appendPod(patches, static_cast<uint32_t>(patch.name.size()));
+        appendPod(patches, static_cast<uint32_t>(patch.type.size()));
+        appendPod(patches, static_cast<uint64_t>(patch.faceIds.size()));
+        patches.insert(patches.end(), patch.name.begin(), patch.name.end());
+        patches.insert(patches.end(), patch.type.begin(), patch.type.end());
+        for (label faceId : patch.faceIds) {
+            appendPod(patches, faceId);
+        }
+    }
+    writer.writeArray(PATCHES, patches);
+
+    out.seekp(0);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    if (!out) {
+        throw std::runtime_error("Failed writing mesh file: " + path);
+    }
+}
+
+Mesh MeshFile::read(const std::string& path) {
+    if (!isLittleEndianHost()) {
+        throw std::runtime_error("MeshFile only supports little-endian hosts");
+    }
+
+    MappedFile file(path);
+    if (file.size() < sizeof(Header)) {
+        throw std::runtime_error("Not a mesh file (too small): " + path);
+    }
+
+    Header header;
+    std::memcpy(&header, file.data(), sizeof(Header));
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) {
+        throw std::runtime_error("Not a mesh file (bad magic): " + path);
+    }
+    if (header.version != FORMAT_VERSION) {
+        throw std::runtime_error("Unsupported mesh file version " + std::to_string(header.version));
+    }
+    if (header.endianTag != ENDIAN_TAG) {
+        throw std::runtime_error("Mesh file byte order does not match this host");
+    }
+    if (header.labelBytes != sizeof(label)) {
+        throw std::runtime_error("Mesh file label size does not match this build");
+    }
+
+    const uint64_t numNodes = header.numNodes;
+    const uint64_t numFaces = header.numFaces;
+    const uint64_t numCells = header.numCells;
+    const uint64_t maxCount = static_cast<uint64_t>(std::numeric_limits<label>::max());
+    if (numNodes > maxCount || numFaces > maxCount || numCells > maxCount) {
+        throw std::runtime_error("Mesh file is too large for this build's label type");
+    }
+
+    Mesh mesh;
+
+    // Topology
+    copySection<label>(file, header, FACE_NODE_OFFSETS, numFaces + 1, mesh.faceNodes.offsets);
+    copySection<label>(file, header, FACE_NODE_INDICES, mesh.faceNodes.offsets.back(), mesh.faceNodes.indices);
+    copySection<label>(file, header, CELL_FACE_OFFSETS, numCells + 1, mesh.cellFaces.offsets);
+    copySection<label>(file, header, CELL_FACE_INDICES, mesh.cellFaces.offsets.back(), mesh.cellFaces.indices);
+    if (header.flags & FLAG_CONNECTIVITY) {
+        copySection<label>(file, header, CELL_NEIGHBOR_OFFSETS, numCells + 1, mesh.cellNeighbors.offsets);
+        copySection<label>(file, header, CELL_NEIGHBOR_INDICES, mesh.cellNeighbors.offsets.back(), mesh.cellNeighbors.indices);
+        copySection<label>(file, header, NODE_CELL_OFFSETS, numNodes + 1, mesh.nodeCells.offsets);
+        copySection<label>(file, header, NODE_CELL_INDICES, mesh.nodeCells.offsets.back(), mesh.nodeCells.indices);
+        checkConnectivity(mesh.cellNeighbors, numCells, "cell-neighbour");
+        checkConnectivity(mesh.nodeCells, numCells, "node-cell");
+    }
+    checkConnectivity(mesh.faceNodes, numNodes, "face-node");
+    checkConnectivity(mesh.cellFaces, numFaces, "cell-face");
+
+    // SoA geometry
+    MeshGeometry& geometry = mesh.geometry;
+    copySection<double>(file, header, FACE_AREA_X, numFaces, geometry.faceAreaX);
+    copySection<double>(file, header, FACE_AREA_Y, numFaces, geometry.faceAreaY);
+    copySection<double>(file, header, FACE_AREA_Z, numFaces, geometry.faceAreaZ);
+    copySection<double>(file, header, FACE_CENTROID_X, numFaces, geometry.faceCentroidX);
+    copySection<double>(file, header, FACE_CENTROID_Y, numFaces, geometry.faceCentroidY);
+    copySection<double>(file, header, FACE_CENTROID_Z, numFaces, geometry.faceCentroidZ);
+    copySection<double>(file, header, CELL_CENTROID_X, numCells, geometry.cellCentroidX);
+    copySection<double>(file, header, CELL_CENTROID_Y, numCells, geometry.cellCentroidY);
+    copySection<double>(file, header, CELL_CENTROID_Z, numCells, geometry.cellCentroidZ);
+    copySection<double>(file, header, CELL_VOLUME, numCells, geometry.cellVolume);
+    copySection<double>(file, header, CELL_INV_VOLUME, numCells, geometry.cellInvVolume);
+
+    // Per-element records
+    const double* positions = sectionData<double>(file, header, NODE_POSITIONS, 3 * numNodes);
+    mesh.nodes.resize(numNodes);
+    #pragma omp parallel for schedule(static)
+    for (uint64_t n = 0; n < numNodes; ++n) {
+        mesh.nodes[n] = Node(static_cast<label>(n),
+                             Vector3D(positions[3 * n], positions[3 * n + 1], positions[3 * n + 2]));
+    }
+
+    const label* owner = sectionData<label>(file, header, FACE_OWNER, numFaces);
+    const label* neighbor = sectionData<label>(file, header, FACE_NEIGHBOR, numFaces);
+    const double* normal = sectionData<double>(file, header, FACE_NORMAL, 3 * numFaces);
+    const double* area = sectionData<double>(file, header, FACE_AREA, numFaces);
+    const label numCellLabels = static_cast<label>(numCells);
+    for (uint64_t f = 0; f < numFaces; ++f) {
+        if (owner[f] < 0 || owner[f] >= numCellLabels || neighbor[f] < -1 || neighbor[f] >= numCellLabels) {
+            throw std::runtime_error("Corrupt mesh file: face " + std::to_string(f) + " has an invalid cell");
+        }
+    }
+    mesh.faces.resize(numFaces);
+    #pragma omp parallel for schedule(static)
+    for (uint64_t f = 0; f < numFaces; ++f) {
+        Face& face = mesh.faces[f];
+        face.id = static_cast<label>(f);
+        face.ownerCell = owner[f];
+        face.neighborCell = neighbor[f];
+        face.normal = Vector3D(normal[3 * f], normal[3 * f + 1], normal[3 * f + 2]);
+        face.centroid = Vector3D(geometry.faceCentroidX[f], geometry.faceCentroidY[f], geometry.faceCentroidZ[f]);
+        face.area = area[f];
+    }
+
+    mesh.cells.resize(numCells);
+    #pragma omp parallel for schedule(static)
+    for (uint64_t c = 0; c < numCells; ++c) {
+        Cell& cell = mesh.cells[c];
+        cell.id = static_cast<label>(c);
+        cell.centroid = Vector3D(geometry.cellCentroidX[c], geometry.cellCentroidY[c], geometry.cellCentroidZ[c]);
+        cell.volume = geometry.cellVolume[c];
+    }
+
+    if (!(header.flags & FLAG_GEOMETRY)) {
+        geometry.clear();
+    } else if (header.flags & FLAG_FACE_FACTORS) {
+        copySection<double>(file, header, FACE_WEIGHT, numFaces, geometry.faceWeight);
+        copySection<double>(file, header, FACE_DELTA_COEFF, numFaces, geometry.faceDeltaCoeff);
+        copySection<double>(file, header, FACE_LAPLACIAN_COEFF, numFaces, geometry.faceLaplacianCoeff);
+        copySection<double>(file, header, FACE_NON_ORTH_X, numFaces, geometry.faceNonOrthX);
+        copySection<double>(file, header, FACE_NON_ORTH_Y, numFaces, geometry.faceNonOrthY);
+        copySection<double>(file, header, FACE_NON_ORTH_Z, numFaces, geometry.faceNonOrthZ);
+    } else {
+        mesh.computeFaceFactors();
+    }
+
+    // Boundary patches
+    const char* patchBytes = sectionData<char>(file, header, PATCHES, header.sectionBytes[PATCHES]);
+    const unsigned char* cursor = reinterpret_cast<const unsigned char*>(patchBytes);
+    const unsigned char* end = cursor + header.sectionBytes[PATCHES];
+    for (uint64_t p = 0; p < header.numPatches; ++p) {
+        uint32_t nameLength = readPod<uint32_t>(cursor, end);
+        uint32_t typeLength = readPod<uint32_t>(cursor, end);
+        uint64_t numIds = readPod<uint64_t>(cursor, end);
+        const uint64_t available = static_cast<uint64_t>(end - cursor);
+        if (static_cast<uint64_t>(nameLength) + typeLength > available ||
+            numIds > (available - nameLength - typeLength) / sizeof(label)) {
+            throw std::runtime_error("Corrupt mesh file: truncated patch table");
+        }
+        std::string name(reinterpret_cast<const char*>(cursor), nameLength);
+        cursor += nameLength;
+        std::string type(reinterpret_cast<const char*>(cursor), typeLength);
+        cursor += typeLength;
+
+        BoundaryPatch& patch = mesh.boundaries[name];
+        patch = BoundaryPatch(name, type);
+        patch.faceIds.resize(numIds);
+        std::memcpy(patch.faceIds.data(), cursor, numIds * sizeof(label));
+        cursor += numIds * sizeof(label);
+        for (label faceId : patch.faceIds) {
+            if (faceId < 0 || static_cast<uint64_t>(faceId) >= numFaces) {
+                throw std::runtime_error("Corrupt mesh file: patch " + name + " has an invalid face");
+            }
+        }
+    }
+
+    if (header.flags & FLAG_FACES_ORDERED) {
+        mesh.updateFaceOrdering();
+    }
+    return mesh;
+}
+
+} // namespace cfd
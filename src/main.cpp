@@ -1,10 +1,14 @@
+#include <chrono>
 #include <cstdlib>
 #include <iostream>
 #include <memory>
 #include <string>
 
+#include "geometry/STLReader.h"
 #include "io/ConfigReader.h"
 #include "io/Logger.h"
+#include "io/MeshFile.h"
+#include "mesh/MeshGenerator.h"
 
 #ifdef _OPENMP
 #include <omp.h>
@@ -85,7 +89,31 @@ int runMeshGeneration(const std::string& configFile) {
         return 1;
     }
     cfd::Logger::instance().info("Config summary:\n" + reader.summarize());
-    cfd::Logger::instance().info("Mesh generation pipeline not yet implemented.");
+    const cfd::EngineConfig& config = reader.config();
+
+    cfd::STLReader geometry;
+    if (!geometry.loadFile(config.geometry.file)) {
+        cfd::Logger::instance().error("Failed to load geometry: " + config.geometry.file);
+        return 1;
+    }
+    geometry.scale(config.geometry.scale);
+
+    cfd::MeshParams params;
+    params.baseSize = config.mesh.baseSize;
+    params.numBoundaryLayers = config.mesh.boundaryLayers;
+    params.renumbering = config.mesh.renumbering;
+
+    cfd::MeshGenerator generator;
+    generator.setGeometry(geometry.getSurfaces());
+    generator.setMeshParameters(params);
+    if (!generator.generate()) {
+        cfd::Logger::instance().error("Mesh generation failed: " + generator.getLastError());
+        return 1;
+    }
+
+    const cfd::Mesh& mesh = generator.getMesh();
+    cfd::MeshFile::write(mesh, config.mesh.file);
+    cfd::Logger::instance().info("Wrote " + std::to_string(mesh.getNumCells()) + " cells to " + config.mesh.file);
     return 0;
 }
 
@@ -104,6 +132,13 @@ int runSimulation(const std::string& configFile, int numThreads) {
     }
     cfd::Logger::instance().info("Config summary:\n" + reader.summarize());
     cfd::Logger::instance().info("Threads: " + (numThreads > 0 ? std::to_string(numThreads) : "auto"));
+
+    const std::string& meshFile = reader.config().mesh.file;
+    auto loadStart = std::chrono::steady_clock::now();
+    cfd::Mesh mesh = cfd::MeshFile::read(meshFile);
+    double loadTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - loadStart).count();
+    cfd::Logger::instance().info("Loaded mesh " + meshFile + ": " + std::to_string(mesh.getNumCells()) + " cells, " +
+                                 std::to_string(mesh.getNumFaces()) + " faces in " + std::to_string(loadTime) + " s");
     cfd::Logger::instance().info("Simulation pipeline not yet implemented.");
     return 0;
 }
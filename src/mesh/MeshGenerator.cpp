@@ -1,4 +1,5 @@
 #include "mesh/MeshGenerator.h"
+#include "mesh/MeshSpatialIndex.h"
 #include <algorithm>
 #include <cmath>
 #include <set>
@@ -45,18 +46,45 @@ bool MeshGenerator::generate() {
         }
     }
     
-    // Step 4: Refine regions
+    // Build connectivity
+    buildCellConnectivity();
+    
+    // Compute geometry
+    mesh.computeAllGeometry();
+    
+    // Step 4: Refine regions (marks cells using the geometry above)
+    refinementCells.clear();
     if (!params.refinementRegions.empty()) {
         if (!refineRegions()) {
             return false;
         }
     }
     
-    // Build connectivity
-    buildCellConnectivity();
+    // Renumber for cache locality
+    try {
+        MeshRenumbering renumbering(MeshRenumbering::parseMethod(params.renumbering));
+        renumberingReport = renumbering.renumber(mesh);
+    } catch (const std::exception& e) {
+        lastError = e.what();
+        return false;
+    }
     
-    // Compute geometry
-    mesh.computeAllGeometry();
+    // Marked cells follow the new numbering
+    if (!renumberingReport.cellNewToOld.empty() && !refinementCells.empty()) {
+        std::vector<label> oldToNew(mesh.getNumCells());
+        for (label c = 0; c < mesh.getNumCells(); ++c) {
+            oldToNew[renumberingReport.cellNewToOld[c]] = c;
+        }
+        for (label& cellId : refinementCells) {
+            cellId = oldToNew[cellId];
+        }
+        std::sort(refinementCells.begin(), refinementCells.end());
+    }
+    
+    // Internal faces first, boundary patches as contiguous ranges
+    if (!mesh.hasOrderedFaces()) {
+        mesh.orderFaces();
+    }
     
     generated = true;
     return true;
@@ -67,14 +95,14 @@ bool MeshGenerator::generateSurfaceMesh() {
     extractUniqueVertices();
     
     // Create boundary faces from surface triangles
-    int faceId = 0;
+    label faceId = 0;
     for (const auto& surface : surfaces) {
         for (const auto& tri : surface.triangles) {
             // Find node indices for triangle vertices
-            std::vector<int> nodeIds;
+            std::vector<label> nodeIds;
             for (int i = 0; i < 3; ++i) {
                 // Find matching node
-                for (int j = 0; j < mesh.getNumNodes(); ++j) {
+                for (label j = 0; j < mesh.getNumNodes(); ++j) {
                     if ((mesh.getNode(j).position - tri.vertices[i]).magnitude() < 1e-9) {
                         nodeIds.push_back(j);
                         break;
@@ -102,7 +130,7 @@ bool MeshGenerator::generateVolumeMesh() {
     Vector3D minBound(1e10, 1e10, 1e10);
     Vector3D maxBound(-1e10, -1e10, -1e10);
     
-    for (int i = 0; i < mesh.getNumNodes(); ++i) {
+    for (label i = 0; i < mesh.getNumNodes(); ++i) {
         const Vector3D& pos = mesh.getNode(i).position;
         minBound.x = std::min(minBound.x, pos.x);
         minBound.y = std::min(minBound.y, pos.y);
@@ -124,7 +152,7 @@ bool MeshGenerator::generateVolumeMesh() {
     nz = std::min(nz, 10);
     
     // Add internal nodes
-    int baseNodeCount = mesh.getNumNodes();
+    label baseNodeCount = mesh.getNumNodes();
     for (int i = 1; i < nx - 1; ++i) {
         for (int j = 1; j < ny - 1; ++j) {
             for (int k = 1; k < nz - 1; ++k) {
@@ -144,8 +172,8 @@ bool MeshGenerator::generateVolumeMesh() {
         for (int j = 0; j < ny - 2; ++j) {
             for (int k = 0; k < nz - 2; ++k) {
                 // Create a cell (placeholder - just store face IDs)
-                std::vector<int> faceIds;
-                int cellId = mesh.addCell(faceIds);
+                std::vector<label> faceIds;
+                label cellId = mesh.addCell(faceIds);
             }
         }
     }
@@ -176,16 +204,22 @@ bool MeshGenerator::refineRegions() {
     // Simplified refinement
     // In production, would subdivide cells in refinement regions
     
+    // Region queries on cell centroids; generate() has computed geometry
+    MeshSpatialIndex index(mesh);
+    
+    std::vector<char> marked(mesh.getNumCells(), 0);
     for (const auto& region : params.refinementRegions) {
         // Find cells in refinement region
-        for (int i = 0; i < mesh.getNumCells(); ++i) {
-            const Cell& cell = mesh.getCell(i);
-            double dist = (cell.centroid - region.center).magnitude();
-            
-            if (dist < region.radius) {
-                // Mark for refinement (placeholder)
-                // Real implementation would subdivide the cell
-            }
+        for (label i : index.findCellsInRadius(region.center, region.radius)) {
+            // Mark for refinement (placeholder)
+            // Real implementation would subdivide the cell
+            marked[i] = 1;
+        }
+    }
+    
+    for (label i = 0; i < mesh.getNumCells(); ++i) {
+        if (marked[i]) {
+            refinementCells.push_back(i);
         }
     }
     
@@ -214,6 +248,104 @@ void MeshGenerator::buildCellConnectivity() {
     mesh.buildConnectivity();
 }
 
+Mesh MeshGenerator::createBoxMesh(int nx, int ny, int nz,
+                                  const Vector3D& minCorner, const Vector3D& maxCorner) {
+    Mesh box;
+    
+    auto nodeId = [&](label i, label j, label k) { return i + (nx + 1) * (j + (ny + 1) * k); };
+    auto cellId = [&](label i, label j, label k) { return i + nx * (j + ny * k); };
+    
+    const label numXFaces = static_cast<label>(nx + 1) * ny * nz;
+    const label numYFaces = static_cast<label>(nx) * (ny + 1) * nz;
+    auto xFaceId = [&](label i, label j, label k) { return i + (nx + 1) * (j + ny * k); };
+    auto yFaceId = [&](label i, label j, label k) { return numXFaces + i + nx * (j + (ny + 1) * k); };
+    auto zFaceId = [&](label i, label j, label k) { return numXFaces + numYFaces + i + nx * (j + ny * k); };
+    
+    const label numNodes = static_cast<label>(nx + 1) * (ny + 1) * (nz + 1);
+    const label numCells = static_cast<label>(nx) * ny * nz;
+    const label numFaces = numXFaces + numYFaces + static_cast<label>(nx) * ny * (nz + 1);
+    box.nodes.reserve(numNodes);
+    box.faces.reserve(numFaces);
+    box.cells.reserve(numCells);
+    box.faceNodes.reserve(numFaces, 4 * numFaces);
+    box.cellFaces.reserve(numCells, 6 * numCells);
+    
+    Vector3D spacing((maxCorner.x - minCorner.x) / nx,
+                     (maxCorner.y - minCorner.y) / ny,
+                     (maxCorner.z - minCorner.z) / nz);
+    for (int k = 0; k <= nz; ++k) {
+        for (int j = 0; j <= ny; ++j) {
+            for (int i = 0; i <= nx; ++i) {
+                box.addNode(Vector3D(minCorner.x + i * spacing.x,
+                                     minCorner.y + j * spacing.y,
+                                     minCorner.z + k * spacing.z));
+            }
+        }
+    }
+    
+    const char* patchNames[6] = {"xmin", "xmax", "ymin", "ymax", "zmin", "zmax"};
+    for (const char* name : patchNames) {
+        box.addBoundaryPatch(name, "wall");
+    }
+    
+    // Nodes are ordered so the normal points along +axis. Interior faces are
+    // owned by the lower cell; low-side boundary faces are reversed so their
+    // normal points out of the domain.
+    std::vector<label> quad(4);
+    auto addQuad = [&](label lo, label hi, const char* loPatch, const char* hiPatch) {
+        if (lo >= 0 && hi >= 0) {
+            box.addFace(quad, lo, hi);
+        } else if (hi >= 0) {
+            std::reverse(quad.begin(), quad.end());
+            box.assignFaceToBoundary(box.addFace(quad, hi, -1), loPatch);
+        } else {
+            box.assignFaceToBoundary(box.addFace(quad, lo, -1), hiPatch);
+        }
+    };
+    
+    for (int k = 0; k < nz; ++k) {
+        for (int j = 0; j < ny; ++j) {
+            for (int i = 0; i <= nx; ++i) {
+                quad = {nodeId(i, j, k), nodeId(i, j + 1, k), nodeId(i, j + 1, k + 1), nodeId(i, j, k + 1)};
+                addQuad(i > 0 ? cellId(i - 1, j, k) : -1, i < nx ? cellId(i, j, k) : -1, "xmin", "xmax");
+            }
+        }
+    }
+    for (int k = 0; k < nz; ++k) {
+        for (int j = 0; j <= ny; ++j) {
+            for (int i = 0; i < nx; ++i) {
+                quad = {nodeId(i, j, k), nodeId(i, j, k + 1), nodeId(i + 1, j, k + 1), nodeId(i + 1, j, k)};
+                addQuad(j > 0 ? cellId(i, j - 1, k) : -1, j < ny ? cellId(i, j, k) : -1, "ymin", "ymax");
+            }
+        }
+    }
+    for (int k = 0; k <= nz; ++k) {
+        for (int j = 0; j < ny; ++j) {
+            for (int i = 0; i < nx; ++i) {
+                quad = {nodeId(i, j, k), nodeId(i + 1, j, k), nodeId(i + 1, j + 1, k), nodeId(i, j + 1, k)};
+                addQuad(k > 0 ? cellId(i, j, k - 1) : -1, k < nz ? cellId(i, j, k) : -1, "zmin", "zmax");
+            }
+        }
+    }
+    
+    std::vector<label> hexFaces(6);
+    for (int k = 0; k < nz; ++k) {
+        for (int j = 0; j < ny; ++j) {
+            for (int i = 0; i < nx; ++i) {
+                hexFaces = {xFaceId(i, j, k), xFaceId(i + 1, j, k),
+                            yFaceId(i, j, k), yFaceId(i, j + 1, k),
+                            zFaceId(i, j, k), zFaceId(i, j, k + 1)};
+                box.addCell(hexFaces);
+            }
+        }
+    }
+    
+    box.buildConnectivity();
+    box.computeAllGeometry();
+    box.orderFaces();
+    return box;
+}
+
 MeshQualityMetrics MeshGenerator::getQualityMetrics() const {
     MeshQualityMetrics metrics;
     
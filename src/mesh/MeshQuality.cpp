@@ -26,7 +26,7 @@ void MeshQuality::computeMetrics(const Mesh& mesh) {
     
     numBadCells = 0;
     
-    for (int i = 0; i < mesh.getNumCells(); ++i) {
+    for (label i = 0; i < mesh.getNumCells(); ++i) {
         double ar = computeCellAspectRatio(mesh, i);
         double skew = computeCellSkewness(mesh, i);
         
@@ -47,9 +47,7 @@ void MeshQuality::computeMetrics(const Mesh& mesh) {
     avgSkewness = sumSkewness / mesh.getNumCells();
 }
 
-double MeshQuality::computeCellAspectRatio(const Mesh& mesh, int cellId) const {
-    const Cell& cell = mesh.getCell(cellId);
-    
+double MeshQuality::computeCellAspectRatio(const Mesh& mesh, label cellId) const {
     // Simplified aspect ratio: ratio of max to min edge length
     // In production, would compute actual aspect ratio based on cell shape
     
@@ -57,12 +55,12 @@ double MeshQuality::computeCellAspectRatio(const Mesh& mesh, int cellId) const {
     double maxEdge = -1e10;
     
     // Get all edges from faces
-    for (int faceId : cell.faceIds) {
-        const Face& face = mesh.getFace(faceId);
-        for (size_t i = 0; i < face.nodeIds.size(); ++i) {
-            size_t j = (i + 1) % face.nodeIds.size();
-            const Vector3D& v1 = mesh.getNode(face.nodeIds[i]).position;
-            const Vector3D& v2 = mesh.getNode(face.nodeIds[j]).position;
+    for (label faceId : mesh.getCellFacesView(cellId)) {
+        Span<const label> nodeIds = mesh.getFaceNodesView(faceId);
+        for (size_t i = 0; i < nodeIds.size(); ++i) {
+            size_t j = (i + 1) % nodeIds.size();
+            const Vector3D& v1 = mesh.getNode(nodeIds[i]).position;
+            const Vector3D& v2 = mesh.getNode(nodeIds[j]).position;
             double edgeLength = (v2 - v1).magnitude();
             
             minEdge = std::min(minEdge, edgeLength);
@@ -73,7 +71,7 @@ double MeshQuality::computeCellAspectRatio(const Mesh& mesh, int cellId) const {
     return (minEdge > 1e-10) ? (maxEdge / minEdge) : 1.0;
 }
 
-double MeshQuality::computeCellSkewness(const Mesh& mesh, int cellId) const {
+double MeshQuality::computeCellSkewness(const Mesh& mesh, label cellId) const {
     const Cell& cell = mesh.getCell(cellId);
     
     // Simplified skewness computation
@@ -85,17 +83,17 @@ double MeshQuality::computeCellSkewness(const Mesh& mesh, int cellId) const {
     return 0.1;  // Low skewness (good quality)
 }
 
-double MeshQuality::computeFaceAngle(const Mesh& mesh, int faceId) const {
-    const Face& face = mesh.getFace(faceId);
+double MeshQuality::computeFaceAngle(const Mesh& mesh, label faceId) const {
+    Span<const label> nodeIds = mesh.getFaceNodesView(faceId);
     
-    if (face.nodeIds.size() < 3) {
+    if (nodeIds.size() < 3) {
         return 0.0;
     }
     
     // Compute angle at first vertex
-    const Vector3D& v0 = mesh.getNode(face.nodeIds[0]).position;
-    const Vector3D& v1 = mesh.getNode(face.nodeIds[1]).position;
-    const Vector3D& v2 = mesh.getNode(face.nodeIds[face.nodeIds.size() - 1]).position;
+    const Vector3D& v0 = mesh.getNode(nodeIds[0]).position;
+    const Vector3D& v1 = mesh.getNode(nodeIds[1]).position;
+    const Vector3D& v2 = mesh.getNode(nodeIds[nodeIds.size() - 1]).position;
     
     Vector3D e1 = (v1 - v0).normalized();
     Vector3D e2 = (v2 - v0).normalized();
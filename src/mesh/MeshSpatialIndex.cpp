@@ -0,0 +1,297 @@
+#include "mesh/MeshSpatialIndex.h"
+#include <algorithm>
+#include <numeric>
+#include <queue>
+#include <stdexcept>
+#include <utility>
+
+namespace cfd {
+
+namespace {
+
+constexpr int PARALLEL_SUBTREE_CELLS = 4096;
+
+void expandBox(BoundingBox& box, const BoundingBox& other) {
+    box.expand(other.min);
+    box.expand(other.max);
+}
+
+double boxDistanceSquared(const BoundingBox& box, const Vector3D& point) {
+    double dist2 = 0.0;
+    for (int d = 0; d < 3; ++d) {
+        double excess = 0.0;
+        if (point[d] < box.min[d]) {
+            excess = box.min[d] - point[d];
+        } else if (point[d] > box.max[d]) {
+            excess = point[d] - box.max[d];
+        }
+        dist2 += excess * excess;
+    }
+    return dist2;
+}
+
+bool boxContains(const BoundingBox& box, const Vector3D& point) {
+    return point.x >= box.min.x && point.x <= box.max.x &&
+           point.y >= box.min.y && point.y <= box.max.y &&
+           point.z >= box.min.z && point.z <= box.max.z;
+}
+
+} // anonymous namespace
+
+label MeshSpatialIndex::countTreeNodes(label numCells) {
+    if (numCells <= LEAF_SIZE) {
+        return 1;
+    }
+    label numLeft = numCells / 2;
+    return 1 + countTreeNodes(numLeft) + countTreeNodes(numCells - numLeft);
+}
+
+void MeshSpatialIndex::build(const Mesh& mesh) {
+    clear();
+    const label numCells = mesh.getNumCells();
+    if (numCells == 0) {
+        return;
+    }
+
+    cellIds.resize(numCells);
+    std::iota(cellIds.begin(), cellIds.end(), 0);
+    centroids.resize(numCells);
+    cellBoxes.resize(numCells);
+    nodes.resize(countTreeNodes(numCells));
+
+    // Centroids in cell order while partitioning
+    #pragma omp parallel for schedule(static)
+    for (label c = 0; c < numCells; ++c) {
+        centroids[c] = mesh.cells[c].centroid;
+    }
+
+    // Subtree sizes are fixed by the median split, so each task writes
+    // into its own preorder slots
+    #pragma omp parallel
+    {
+        #pragma omp single
+        buildSubtree(0, 0, numCells);
+    }
+
+    refit(mesh);
+}
+
+void MeshSpatialIndex::buildSubtree(label nodeIndex, label begin, label end) {
+    TreeNode& node = nodes[nodeIndex];
+    node.begin = begin;
+    node.end = end;
+
+    const label count = end - begin;
+    if (count <= LEAF_SIZE) {
+        node.rightChild = -1;
+        return;
+    }
+
+    // Split at the median centroid along the longest extent
+    BoundingBox extent;
+    for (label i = begin; i < end; ++i) {
+        extent.expand(centroids[cellIds[i]]);
+    }
+    Vector3D size = extent.size();
+    int axis = (size.x >= size.y && size.x >= size.z) ? 0 : (size.y >= size.z ? 1 : 2);
+
+    const label numLeft = count / 2;
+    const label mid = begin + numLeft;
+    std::nth_element(cellIds.begin() + begin, cellIds.begin() + mid, cellIds.begin() + end,
+                     [&](label a, label b) {
+                         double ka = centroids[a][axis];
+                         double kb = centroids[b][axis];
+                         return (ka != kb) ? (ka < kb) : (a < b);
+                     });
+
+    const label leftChild = nodeIndex + 1;
+    node.rightChild = leftChild + countTreeNodes(numLeft);
+    const label rightChild = node.rightChild;
+
+    if (count > PARALLEL_SUBTREE_CELLS) {
+        #pragma omp task
+        buildSubtree(leftChild, begin, mid);
+        #pragma omp task
+        buildSubtree(rightChild, mid, end);
+        #pragma omp taskwait
+    } else {
+        buildSubtree(leftChild, begin, mid);
+        buildSubtree(rightChild, mid, end);
+    }
+}
+
+void MeshSpatialIndex::refit(const Mesh& mesh) {
+    if (mesh.getNumCells() != getNumCells()) {
+        throw std::invalid_argument("MeshSpatialIndex::refit: cell count changed since build");
+    }
+    computeCellBounds(mesh);
+    refitNodes();
+}
+
+void MeshSpatialIndex::computeCellBounds(const Mesh& mesh) {
+    const label numCells = getNumCells();
+
+    #pragma omp parallel for schedule(static)
+    for (label i = 0; i < numCells; ++i) {
+        const label cellId = cellIds[i];
+        const Vector3D& centroid = mesh.cells[cellId].centroid;
+        BoundingBox box;
+        box.expand(centroid);
+        for (label faceId : mesh.getCellFacesView(cellId)) {
+            for (label nodeId : mesh.getFaceNodesView(faceId)) {
+                box.expand(mesh.nodes[nodeId].position);
+            }
+        }
+        centroids[i] = centroid;
+        cellBoxes[i] = box;
+    }
+}
+
+void MeshSpatialIndex::refitNodes() {
+    const label numNodes = getNumTreeNodes();
+
+    #pragma omp parallel for schedule(static)
+    for (label n = 0; n < numNodes; ++n) {
+        TreeNode& node = nodes[n];
+        if (!node.isLeaf()) continue;
+        node.box = BoundingBox();
+        for (label i = node.begin; i < node.end; ++i) {
+            expandBox(node.box, cellBoxes[i]);
+        }
+    }
+
+    // Children follow their parent in preorder
+    for (label n = numNodes - 1; n >= 0; --n) {
+        TreeNode& node = nodes[n];
+        if (node.isLeaf()) continue;
+        node.box = nodes[n + 1].box;
+        expandBox(node.box, nodes[node.rightChild].box);
+    }
+}
+
+void MeshSpatialIndex::clear() {
+    nodes.clear();
+    cellIds.clear();
+    centroids.clear();
+    cellBoxes.clear();
+}
+
+std::vector<label> MeshSpatialIndex::findCellsInRadius(const Vector3D& point, double radius) const {
+    std::vector<label> result;
+    if (nodes.empty() || radius <= 0.0) {
+        return result;
+    }
+
+    const double radius2 = radius * radius;
+    std::vector<label> stack(1, 0);
+    while (!stack.empty()) {
+        const label nodeIndex = stack.back();
+        const TreeNode& node = nodes[nodeIndex];
+        stack.pop_back();
+        if (boxDistanceSquared(node.box, point) >= radius2) continue;
+
+        if (node.isLeaf()) {
+            for (label i = node.begin; i < node.end; ++i) {
+                if ((centroids[i] - point).magnitudeSquared() < radius2) {
+                    result.push_back(cellIds[i]);
+                }
+            }
+        } else {
+            stack.push_back(node.rightChild);
+            stack.push_back(nodeIndex + 1);
+        }
+    }
+
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+std::vector<label> MeshSpatialIndex::findNearestCells(const Vector3D& point, int k) const {
+    std::vector<label> result;
+    if (nodes.empty() || k <= 0) {
+        return result;
+    }
+
+    // Best-first descent; stop once no box can beat the k-th candidate
+    typedef std::pair<double, label> Entry;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> frontier;
+    std::priority_queue<Entry> best;  // Max-heap of (distance^2, cell)
+    frontier.push(Entry(boxDistanceSquared(nodes[0].box, point), 0));
+
+    while (!frontier.empty()) {
+        Entry top = frontier.top();
+        frontier.pop();
+        if (static_cast<label>(best.size()) == k && top.first > best.top().first) break;
+
+        const TreeNode& node = nodes[top.second];
+        if (node.isLeaf()) {
+            for (label i = node.begin; i < node.end; ++i) {
+                Entry candidate((centroids[i] - point).magnitudeSquared(), cellIds[i]);
+                if (static_cast<label>(best.size()) < k) {
+                    best.push(candidate);
+                } else if (candidate < best.top()) {
+                    best.pop();
+                    best.push(candidate);
+                }
+            }
+        } else {
+            frontier.push(Entry(boxDistanceSquared(nodes[top.second + 1].box, point), top.second + 1));
+            frontier.push(Entry(boxDistanceSquared(nodes[node.rightChild].box, point), node.rightChild));
+        }
+    }
+
+    result.resize(best.size());
+    for (label i = static_cast<label>(result.size()) - 1; i >= 0; --i) {
+        result[i] = best.top().second;
+        best.pop();
+    }
+    return result;
+}
+
+label MeshSpatialIndex::findCell(const Mesh& mesh, const Vector3D& point) const {
+    if (nodes.empty()) {
+        return -1;
+    }
+
+    std::vector<label> stack(1, 0);
+    while (!stack.empty()) {
+        const label nodeIndex = stack.back();
+        const TreeNode& node = nodes[nodeIndex];
+        stack.pop_back();
+        if (!boxContains(node.box, point)) continue;
+
+        if (node.isLeaf()) {
+            for (label i = node.begin; i < node.end; ++i) {
+                if (boxContains(cellBoxes[i], point) && cellContains(mesh, cellIds[i], point)) {
+                    return cellIds[i];
+                }
+            }
+        } else {
+            stack.push_back(node.rightChild);
+            stack.push_back(nodeIndex + 1);
+        }
+    }
+    return -1;
+}
+
+bool MeshSpatialIndex::cellContains(const Mesh& mesh, label cellId, const Vector3D& point, double tolerance) {
+    Span<const label> cellFaces = mesh.getCellFacesView(cellId);
+    if (cellFaces.empty()) {
+        return false;
+    }
+
+    // Inside if the point is behind every outward face plane
+    for (label faceId : cellFaces) {
+        const Face& face = mesh.faces[faceId];
+        double side = (point - face.centroid).dot(face.normal);
+        if (face.ownerCell != cellId) {
+            side = -side;
+        }
+        if (side > tolerance) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace cfd
@@ -0,0 +1,411 @@
+#include "solver/AMGPreconditioner.h"
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace cfd {
+
+void CSRMatrix::multiply(const double* x, double* y) const {
+    #pragma omp parallel for schedule(static)
+    for (label i = 0; i < numRows; ++i) {
+        double sum = 0.0;
+        for (label k = rowStart[i]; k < rowStart[i + 1]; ++k) {
+            sum += values[k] * x[columns[k]];
+        }
+        y[i] = sum;
+    }
+}
+
+void CSRMatrix::getDiagonal(double* diagonal) const {
+    for (label i = 0; i < numRows; ++i) {
+        diagonal[i] = 0.0;
+        for (label k = rowStart[i]; k < rowStart[i + 1]; ++k) {
+            if (columns[k] == i) diagonal[i] = values[k];
+        }
+    }
+}
+
+size_t CSRMatrix::getMemoryUsage() const {
+    return (rowStart.capacity() + columns.capacity()) * sizeof(label) + values.capacity() * sizeof(double);
+}
+
+namespace {
+
+// Fine-level operator with the diagonal merged into each row
+CSRMatrix toCSR(const FVMatrix& A) {
+    const FVAddressing& addr = A.getAddressing();
+    CSRMatrix M;
+    M.numRows = M.numCols = A.getNumCells();
+    M.rowStart.assign(M.numRows + 1, 0);
+    M.columns.reserve(addr.rows.getNumEntries() + M.numRows);
+    M.values.reserve(addr.rows.getNumEntries() + M.numRows);
+    for (label c = 0; c < M.numRows; ++c) {
+        bool diagonalDone = false;
+        for (label k = addr.rows.offsets[c]; k < addr.rows.offsets[c + 1]; ++k) {
+            if (!diagonalDone && addr.rows.indices[k] > c) {
+                M.columns.push_back(c);
+                M.values.push_back(A.diag[c]);
+                diagonalDone = true;
+            }
+            M.columns.push_back(addr.rows.indices[k]);
+            M.values.push_back(A.offDiag[addr.rowCoeffs[k]]);
+        }
+        if (!diagonalDone) {
+            M.columns.push_back(c);
+            M.values.push_back(A.diag[c]);
+        }
+        M.rowStart[c + 1] = static_cast<label>(M.columns.size());
+    }
+    return M;
+}
+
+CSRMatrix transpose(const CSRMatrix& A) {
+    CSRMatrix T;
+    T.numRows = A.numCols;
+    T.numCols = A.numRows;
+    T.rowStart.assign(T.numRows + 1, 0);
+    for (label col : A.columns) {
+        T.rowStart[col + 1]++;
+    }
+    for (label i = 0; i < T.numRows; ++i) {
+        T.rowStart[i + 1] += T.rowStart[i];
+    }
+    T.columns.resize(A.columns.size());
+    T.values.resize(A.values.size());
+    std::vector<label> cursor(T.rowStart.begin(), T.rowStart.end() - 1);
+    for (label i = 0; i < A.numRows; ++i) {
+        for (label k = A.rowStart[i]; k < A.rowStart[i + 1]; ++k) {
+            label pos = cursor[A.columns[k]]++;
+            T.columns[pos] = i;  // Rows visited in order: columns stay ascending
+            T.values[pos] = A.values[k];
+        }
+    }
+    return T;
+}
+
+// C = A B (Gustavson: one dense accumulator row)
+CSRMatrix multiply(const CSRMatrix& A, const CSRMatrix& B) {
+    CSRMatrix C;
+    C.numRows = A.numRows;
+    C.numCols = B.numCols;
+    C.rowStart.assign(C.numRows + 1, 0);
+    std::vector<label> marker(B.numCols, -1);
+    std::vector<double> accumulator(B.numCols, 0.0);
+    std::vector<label> rowColumns;
+    for (label i = 0; i < A.numRows; ++i) {
+        rowColumns.clear();
+        for (label ka = A.rowStart[i]; ka < A.rowStart[i + 1]; ++ka) {
+            const label j = A.columns[ka];
+            const double a = A.values[ka];
+            for (label kb = B.rowStart[j]; kb < B.rowStart[j + 1]; ++kb) {
+                const label col = B.columns[kb];
+                if (marker[col] != i) {
+                    marker[col] = i;
+                    accumulator[col] = 0.0;
+                    rowColumns.push_back(col);
+                }
+                accumulator[col] += a * B.values[kb];
+            }
+        }
+        std::sort(rowColumns.begin(), rowColumns.end());
+        for (label col : rowColumns) {
+            C.columns.push_back(col);
+            C.values.push_back(accumulator[col]);
+        }
+        C.rowStart[i + 1] = static_cast<label>(C.columns.size());
+    }
+    return C;
+}
+
+// Gershgorin bound on the spectral radius of D^-1 A
+double estimateSpectralRadius(const CSRMatrix& A, const std::vector<double>& invDiagonal) {
+    double radius = 0.0;
+    for (label i = 0; i < A.numRows; ++i) {
+        double rowSum = 0.0;
+        for (label k = A.rowStart[i]; k < A.rowStart[i + 1]; ++k) {
+            rowSum += std::abs(A.values[k]);
+        }
+        radius = std::max(radius, rowSum * std::abs(invDiagonal[i]));
+    }
+    return radius > 0.0 ? radius : 1.0;
+}
+
+/**
+ * @brief Greedy aggregation along strong couplings; returns the number of
+ * aggregates and fills aggregate[i]
+ *
+ * 1. A node whose strong neighbours are all free seeds an aggregate with
+ *    them.
+ * 2. Remaining nodes join the aggregate they are most strongly coupled to.
+ * 3. Leftovers form aggregates with their free strong neighbours.
+ */
+label aggregate(const CSRMatrix& A, const std::vector<double>& diagonal, double threshold,
+                std::vector<label>& aggregate) {
+    const label n = A.numRows;
+    auto strong = [&](label i, label k) {
+        const label j = A.columns[k];
+        return j != i && std::abs(A.values[k]) >= threshold * std::sqrt(std::abs(diagonal[i] * diagonal[j]));
+    };
+
+    aggregate.assign(n, -1);
+    label numAggregates = 0;
+    for (label i = 0; i < n; ++i) {
+        if (aggregate[i] >= 0) continue;
+        bool free = true;
+        bool hasStrong = false;
+        for (label k = A.rowStart[i]; k < A.rowStart[i + 1] && free; ++k) {
+            if (!strong(i, k)) continue;
+            hasStrong = true;
+            free = aggregate[A.columns[k]] < 0;
+        }
+        if (!free || !hasStrong) continue;
+        aggregate[i] = numAggregates;
+        for (label k = A.rowStart[i]; k < A.rowStart[i + 1]; ++k) {
+            if (strong(i, k)) aggregate[A.columns[k]] = numAggregates;
+        }
+        numAggregates++;
+    }
+
+    std::vector<label> seeded = aggregate;
+    for (label i = 0; i < n; ++i) {
+        if (seeded[i] >= 0) continue;
+        double best = 0.0;
+        for (label k = A.rowStart[i]; k < A.rowStart[i + 1]; ++k) {
+            if (strong(i, k) && seeded[A.columns[k]] >= 0 && std::abs(A.values[k]) > best) {
+                best = std::abs(A.values[k]);
+                aggregate[i] = seeded[A.columns[k]];
+            }
+        }
+    }
+
+    for (label i = 0; i < n; ++i) {
+        if (aggregate[i] >= 0) continue;
+        aggregate[i] = numAggregates;
+        for (label k = A.rowStart[i]; k < A.rowStart[i + 1]; ++k) {
+            if (strong(i, k) && aggregate[A.columns[k]] < 0) aggregate[A.columns[k]] = numAggregates;
+        }
+        numAggregates++;
+    }
+    return numAggregates;
+}
+
+// P = (I - omega D^-1 A) P0, with P0 the piecewise-constant aggregate basis
+CSRMatrix smoothedProlongation(const CSRMatrix& A, const std::vector<double>& invDiagonal,
+                               const std::vector<label>& aggregate, label numAggregates, double omega) {
+    CSRMatrix P;
+    P.numRows = A.numRows;
+    P.numCols = numAggregates;
+    P.rowStart.assign(P.numRows + 1, 0);
+    std::vector<label> marker(numAggregates, -1);
+    std::vector<double> accumulator(numAggregates, 0.0);
+    std::vector<label> rowColumns;
+    for (label i = 0; i < A.numRows; ++i) {
+        rowColumns.clear();
+        auto addEntry = [&](label col, double value) {
+            if (marker[col] != i) {
+                marker[col] = i;
+                accumulator[col] = 0.0;
+                rowColumns.push_back(col);
+            }
+            accumulator[col] += value;
+        };
+        addEntry(aggregate[i], 1.0);
+        for (label k = A.rowStart[i]; k < A.rowStart[i + 1]; ++k) {
+            addEntry(aggregate[A.columns[k]], -omega * invDiagonal[i] * A.values[k]);
+        }
+        std::sort(rowColumns.begin(), rowColumns.end());
+        for (label col : rowColumns) {
+            if (accumulator[col] == 0.0) continue;
+            P.columns.push_back(col);
+            P.values.push_back(accumulator[col]);
+        }
+        P.rowStart[i + 1] = static_cast<label>(P.columns.size());
+    }
+    return P;
+}
+
+} // anonymous namespace
+
+void AMGPreconditioner::clear() {
+    levels.clear();
+    coarseFactor.clear();
+    coarseWork.clear();
+}
+
+void AMGPreconditioner::setup(const FVMatrix& A) {
+    clear();
+    levels.emplace_back();
+    levels.back().A = toCSR(A);
+
+    std::vector<double> diagonal;
+    std::vector<label> aggregates;
+    double threshold = strongThreshold;
+    while (true) {
+        Level& L = levels.back();
+        const label n = L.A.numRows;
+        diagonal.resize(n);
+        L.A.getDiagonal(diagonal.data());
+        L.invDiagonal.resize(n);
+        for (label i = 0; i < n; ++i) {
+            L.invDiagonal[i] = (diagonal[i] != 0.0) ? 1.0 / diagonal[i] : 0.0;
+        }
+        const double radius = estimateSpectralRadius(L.A, L.invDiagonal);
+        L.smootherWeight = 4.0 / (3.0 * radius);
+        L.x.assign(n, 0.0);
+        L.b.assign(n, 0.0);
+        L.residual.assign(n, 0.0);
+
+        if (n <= coarsestSize || static_cast<int>(levels.size()) >= maxLevels) break;
+        const label numAggregates = aggregate(L.A, diagonal, threshold, aggregates);
+        if (numAggregates >= n || numAggregates == 0) break;  // No coarsening progress
+
+        L.P = smoothedProlongation(L.A, L.invDiagonal, aggregates, numAggregates, L.smootherWeight);
+        L.R = transpose(L.P);
+        CSRMatrix coarse = multiply(L.R, multiply(L.A, L.P));
+        levels.emplace_back();
+        levels.back().A = std::move(coarse);
+
+        // Smoothed prolongation widens the coarse stencils: halve the
+        // threshold per level so that their weaker far couplings aggregate
+        threshold *= 0.5;
+    }
+    factorCoarsest();
+}
+
+void AMGPreconditioner::factorCoarsest() {
+    const CSRMatrix& A = levels.back().A;
+    const label n = A.numRows;
+    coarseFactor.assign(static_cast<size_t>(n) * n, 0.0);
+    coarseWork.assign(n, 0.0);
+    double maxDiagonal = 0.0;
+    for (label i = 0; i < n; ++i) {
+        for (label k = A.rowStart[i]; k < A.rowStart[i + 1]; ++k) {
+            coarseFactor[static_cast<size_t>(i) * n + A.columns[k]] = A.values[k];
+            if (A.columns[k] == i) maxDiagonal = std::max(maxDiagonal, std::abs(A.values[k]));
+        }
+    }
+
+    // Lower-triangular Cholesky in place; a (near) zero pivot marks the
+    // null space of a singular operator and its row is left at zero
+    double* F = coarseFactor.data();
+    for (label j = 0; j < n; ++j) {
+        double pivot = F[static_cast<size_t>(j) * n + j];
+        for (label k = 0; k < j; ++k) {
+            pivot -= F[static_cast<size_t>(j) * n + k] * F[static_cast<size_t>(j) * n + k];
+        }
+        if (pivot <= 1e-10 * maxDiagonal) {
+            for (label i = j; i < n; ++i) F[static_cast<size_t>(i) * n + j] = 0.0;
+            continue;
+        }
+        const double ljj = std::sqrt(pivot);
+        F[static_cast<size_t>(j) * n + j] = ljj;
+        for (label i = j + 1; i < n; ++i) {
+            double value = F[static_cast<size_t>(i) * n + j];
+            for (label k = 0; k < j; ++k) {
+                value -= F[static_cast<size_t>(i) * n + k] * F[static_cast<size_t>(j) * n + k];
+            }
+            F[static_cast<size_t>(i) * n + j] = value / ljj;
+        }
+    }
+    // Keep only the lower triangle
+    for (label i = 0; i < n; ++i) {
+        for (label j = i + 1; j < n; ++j) F[static_cast<size_t>(i) * n + j] = 0.0;
+    }
+}
+
+void AMGPreconditioner::solveCoarsest(const double* b, double* x) const {
+    const label n = levels.back().A.numRows;
+    const double* F = coarseFactor.data();
+    double* y = coarseWork.data();
+    for (label i = 0; i < n; ++i) {
+        const double lii = F[static_cast<size_t>(i) * n + i];
+        double value = b[i];
+        for (label k = 0; k < i; ++k) value -= F[static_cast<size_t>(i) * n + k] * y[k];
+        y[i] = (lii != 0.0) ? value / lii : 0.0;
+    }
+    for (label i = n - 1; i >= 0; --i) {
+        const double lii = F[static_cast<size_t>(i) * n + i];
+        double value = y[i];
+        for (label k = i + 1; k < n; ++k) value -= F[static_cast<size_t>(k) * n + i] * x[k];
+        x[i] = (lii != 0.0) ? value / lii : 0.0;
+    }
+}
+
+void AMGPreconditioner::smooth(const Level& L, int sweeps, bool zeroGuess) const {
+    const label n = L.A.numRows;
+    double* x = L.x.data();
+    double* r = L.residual.data();
+    const double* b = L.b.data();
+    const double omega = L.smootherWeight;
+    if (zeroGuess) {
+        // The first sweep from x = 0 needs no product
+        const double weight = (sweeps > 0) ? omega : 0.0;
+        #pragma omp parallel for schedule(static)
+        for (label i = 0; i < n; ++i) {
+            x[i] = weight * L.invDiagonal[i] * b[i];
+        }
+        sweeps--;
+    }
+    for (int sweep = 0; sweep < sweeps; ++sweep) {
+        L.A.multiply(x, r);
+        #pragma omp parallel for schedule(static)
+        for (label i = 0; i < n; ++i) {
+            x[i] += omega * L.invDiagonal[i] * (b[i] - r[i]);
+        }
+    }
+}
+
+void AMGPreconditioner::cycle(int level) const {
+    const Level& L = levels[level];
+    const label n = L.A.numRows;
+    if (level + 1 == static_cast<int>(levels.size())) {
+        solveCoarsest(L.b.data(), L.x.data());
+        return;
+    }
+
+    smooth(L, numSmoothingSweeps, true);
+
+    // Restrict the residual, correct from the coarse level
+    L.A.multiply(L.x.data(), L.residual.data());
+    #pragma omp parallel for schedule(static)
+    for (label i = 0; i < n; ++i) {
+        L.residual[i] = L.b[i] - L.residual[i];
+    }
+    const Level& coarse = levels[level + 1];
+    L.R.multiply(L.residual.data(), coarse.b.data());
+    cycle(level + 1);
+    L.P.multiply(coarse.x.data(), L.residual.data());
+    #pragma omp parallel for schedule(static)
+    for (label i = 0; i < n; ++i) {
+        L.x[i] += L.residual[i];
+    }
+
+    smooth(L, numSmoothingSweeps, false);
+}
+
+void AMGPreconditioner::apply(const double* r, double* z) const {
+    const Level& fine = levels.front();
+    std::copy(r, r + fine.A.numRows, fine.b.begin());
+    cycle(0);
+    std::copy(fine.x.begin(), fine.x.end(), z);
+}
+
+double AMGPreconditioner::getOperatorComplexity() const {
+    if (levels.empty()) return 0.0;
+    double total = 0.0;
+    for (const Level& L : levels) {
+        total += L.A.getNumEntries();
+    }
+    return total / levels.front().A.getNumEntries();
+}
+
+size_t AMGPreconditioner::getMemoryUsage() const {
+    size_t bytes = coarseFactor.capacity() * sizeof(double);
+    for (const Level& L : levels) {
+        bytes += L.A.getMemoryUsage() + L.P.getMemoryUsage() + L.R.getMemoryUsage();
+        bytes += (L.invDiagonal.capacity() + L.x.capacity() + L.b.capacity() + L.residual.capacity()) * sizeof(double);
+    }
+    return bytes;
+}
+
+} // namespace cfd
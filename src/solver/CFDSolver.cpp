@@ -1,11 +1,16 @@
 #include "solver/CFDSolver.h"
 #include "turbulence/KEpsilonModel.h"
+#include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <limits>
+#include <stdexcept>
 
 namespace cfd {
 
 CFDSolver::CFDSolver() 
-    : mesh(nullptr), currentTime(0.0), currentIteration(0) {
+    : mesh(nullptr), currentTime(0.0), currentIteration(0), lastTimeStep(0.0), proposedTimeStep(0.0),
+      smallestTimeStep(0.0), minCellSize(0.0) {
 }
 
 CFDSolver::~CFDSolver() {
@@ -16,15 +21,26 @@ void CFDSolver::initialize(const Mesh& mesh_, const SimulationConfig& config_) {
     config = config_;
     currentTime = config.startTime;
     currentIteration = 0;
+    lastTimeStep = config.timeStep;
+    proposedTimeStep = config.timeStep;
+    smallestTimeStep = std::numeric_limits<double>::max();
+    timeStepController = TimeStepController(config.timeStepLimits);
+    
+    double minVolume = std::numeric_limits<double>::max();
+    for (label i = 0; i < mesh->getNumCells(); ++i) {
+        minVolume = std::min(minVolume, mesh->geometry.cellVolume[i]);
+    }
+    minCellSize = (mesh->getNumCells() > 0) ? std::cbrt(minVolume) : 0.0;
     
     // Initialize field manager
-    fields.registerField("velocity", FieldType::VECTOR, mesh->getNumCells());
-    fields.registerField("pressure", FieldType::SCALAR, mesh->getNumCells());
-    fields.registerField("temperature", FieldType::SCALAR, mesh->getNumCells());
-    fields.registerField("density", FieldType::SCALAR, mesh->getNumCells());
+    velocityId = fields.registerVectorField("velocity", mesh->getNumCells());
+    pressureId = fields.registerScalarField("pressure", mesh->getNumCells());
+    temperatureId = fields.registerScalarField("temperature", mesh->getNumCells());
+    densityId = fields.registerScalarField("density", mesh->getNumCells());
     
     // Create physics modules
     fluidSolver = std::make_unique<FluidDynamics>();
+    fluidSolver->setMatrixFree(config.matrixFree);
     fluidSolver->initialize(*mesh, fields);
     
     thermo = std::make_unique<ThermodynamicProperties>();
@@ -38,6 +54,7 @@ void CFDSolver::initialize(const Mesh& mesh_, const SimulationConfig& config_) {
     combustionModel = std::make_unique<CombustionModel>();
     CombustionConfig combConfig;
     combustionModel->initialize(combConfig);
+    combustionModel->setMesh(*mesh);
     
     chemistryIntegrator = std::make_unique<ChemistryIntegrator>();
     
@@ -45,12 +62,12 @@ void CFDSolver::initialize(const Mesh& mesh_, const SimulationConfig& config_) {
 }
 
 void CFDSolver::setInitialConditions(const InitialConditions& ic) {
-    Field& temperature = fields.getField("temperature");
-    Field& pressure = fields.getField("pressure");
-    Field& velocity = fields.getField("velocity");
-    Field& density = fields.getField("density");
+    Field& temperature = fields.getField(temperatureId);
+    Field& pressure = fields.getField(pressureId);
+    Field& velocity = fields.getField(velocityId);
+    Field& density = fields.getField(densityId);
     
-    for (int i = 0; i < mesh->getNumCells(); ++i) {
+    for (label i = 0; i < mesh->getNumCells(); ++i) {
         temperature(i) = ic.temperature;
         pressure(i) = ic.pressure;
         velocity(i, 0) = ic.velocity.x;
@@ -58,30 +75,90 @@ void CFDSolver::setInitialConditions(const InitialConditions& ic) {
         velocity(i, 2) = ic.velocity.z;
         density(i) = ic.pressure / (287.0 * ic.temperature);  // Ideal gas
     }
+    if (!speciesIds.empty() && ic.massFractions.size() != speciesIds.size()) {
+        throw std::invalid_argument("Initial mass fractions do not match the species");
+    }
+    for (size_t s = 0; s < speciesIds.size(); ++s) {
+        fields.getField(speciesIds[s]).fill(ic.massFractions[s]);
+    }
+    
+    // One old level (phi^n) for the transported fields, starting from the
+    // initial conditions; the per-step rotation swaps storage only
+    for (FieldId id : {FieldId(velocityId), FieldId(pressureId), FieldId(temperatureId), FieldId(densityId)}) {
+        fields.setNumOldTimeLevels(id, 1);
+    }
+}
+
+void CFDSolver::setSpark(const SparkConfig& spark) {
+    combustionModel->initializeSpark(spark, currentTime);
+}
+
+void CFDSolver::addSpecies(const Species& species) {
+    thermo->addSpecies(species);
+    speciesIds.push_back(fields.registerScalarField("Y_" + species.getName(), mesh->getNumCells(),
+                                                    FieldPrecision::FLOAT));
 }
 
 bool CFDSolver::solve() {
     std::cout << "Starting CFD simulation...\n";
     std::cout << "Time range: " << config.startTime << " to " << config.endTime << " s\n";
-    std::cout << "Time step: " << config.timeStep << " s\n";
+    if (config.adaptiveTimeStep) {
+        std::cout << "Time step: adaptive, max Courant " << config.timeStepLimits.maxCourant
+                  << ", initial " << config.timeStep << " s\n";
+    } else {
+        std::cout << "Time step: " << config.timeStep << " s\n";
+    }
     
-    double nextOutputTime = currentTime + config.outputInterval;
+    // Output and checkpoint times as multiples of their intervals from the
+    // start, so that they do not drift
+    int outputCount = 1;
+    int checkpointCount = 1;
+    double nextOutputTime = config.startTime + config.outputInterval;
+    double nextCheckpointTime = config.startTime + config.checkpointInterval;
     
-    while (currentTime < config.endTime) {
-        // Advance one time step
-        advanceTimeStep(config.timeStep);
+    while (!timeStepController.isSyncReached(currentTime, config.endTime)) {
+        // Advance one time step; adaptive steps land exactly on the next
+        // output, checkpoint, end or ignition time. Sync times that coincide
+        // with the current one up to rounding are skipped: they are reached
+        double dt = config.timeStep;
+        bool landsOnSync = false;
+        double syncTime = config.endTime;
+        for (double t : {nextOutputTime, nextCheckpointTime, combustionModel->getNextEventTime(currentTime)}) {
+            if (!timeStepController.isSyncReached(currentTime, t)) {
+                syncTime = std::min(syncTime, t);
+            }
+        }
+        if (config.adaptiveTimeStep) {
+            // Nothing measured before the first step: it uses config.timeStep
+            const bool firstStep = (currentIteration == 0);
+            const double courant = firstStep ? 0.0 : fluidSolver->getMaxCourantNumber();
+            double limit = physicsTimeStepLimit();
+            if (firstStep) limit = std::min(limit, config.timeStep);
+            proposedTimeStep = timeStepController.proposeTimeStep(lastTimeStep, courant, proposedTimeStep, limit);
+            dt = timeStepController.fitToSyncTime(currentTime, proposedTimeStep, syncTime, landsOnSync);
+        }
+        advanceTimeStep(dt);
+        if (landsOnSync) {
+            currentTime = syncTime;
+        }
+        lastTimeStep = dt;
+        smallestTimeStep = std::min(smallestTimeStep, dt);
         
         // Output if needed
-        if (currentTime >= nextOutputTime) {
+        if (timeStepController.isSyncReached(currentTime, nextOutputTime)) {
             writeOutput(currentTime);
-            nextOutputTime += config.outputInterval;
+            nextOutputTime = config.startTime + (++outputCount) * config.outputInterval;
+        }
+        if (timeStepController.isSyncReached(currentTime, nextCheckpointTime)) {
+            writeCheckpoint(currentTime);
+            nextCheckpointTime = config.startTime + (++checkpointCount) * config.checkpointInterval;
         }
         
         currentIteration++;
         
         if (currentIteration % 100 == 0) {
             std::cout << "Iteration " << currentIteration 
-                     << ", Time = " << currentTime << " s\n";
+                     << ", Time = " << currentTime << " s, dt = " << dt << " s\n";
         }
     }
     
@@ -89,9 +166,24 @@ bool CFDSolver::solve() {
     return true;
 }
 
+double CFDSolver::physicsTimeStepLimit() const {
+    double limit = std::numeric_limits<double>::max();
+    if (combustionModel) {
+        limit = std::min(limit, combustionModel->getMaxTimeStep(currentTime, minCellSize));
+    }
+    if (chemistryIntegrator) {
+        limit = std::min(limit, chemistryIntegrator->getMaxTimeStep());
+    }
+    return limit;
+}
+
 void CFDSolver::advanceTimeStep(double dt) {
     // Operator splitting approach
     
+    // Last step's solution becomes the old time level; the current fields
+    // are rewritten below
+    fields.advanceTimeLevels();
+    
     // 1. Solve fluid dynamics
     fluidSolver->computeMomentum(fields, dt);
     fluidSolver->solvePressureCorrection(fields);
@@ -103,12 +195,16 @@ void CFDSolver::advanceTimeStep(double dt) {
         turbulenceModel->solve(fields, dt);
     }
     
-    // 3. Solve combustion
+    // 3. Solve combustion; the spark deposits into the new temperature
     if (combustionModel) {
+        combustionModel->applySpark(fields, currentTime);
         combustionModel->solve(fields, dt);
     }
     
-    // 4. Solve chemistry (if species present)
+    // 4. Solve chemistry (if species present). Not wired up yet: species
+    // fields only feed the thermodynamics, and chemistry imposes no
+    // time-step limit until integrate() is called here per cell
+    chemistryIntegrator->beginStep();
     // chemistryIntegrator->integrate(...)
     
     // 5. Update thermodynamic properties
@@ -122,13 +218,35 @@ void CFDSolver::advanceTimeStep(double dt) {
 
 void CFDSolver::updateThermodynamics() {
     // Update density from equation of state
-    Field& temperature = fields.getField("temperature");
-    Field& pressure = fields.getField("pressure");
-    Field& density = fields.getField("density");
+    const Field& temperature = fields.getField(temperatureId);
+    const Field& pressure = fields.getField(pressureId);
+    Field& density = fields.getField(densityId);
+    const label numCells = mesh->getNumCells();
     
-    for (int i = 0; i < mesh->getNumCells(); ++i) {
-        std::vector<double> Y;  // Mass fractions (placeholder)
-        density(i) = thermo->getDensity(temperature(i), pressure(i), Y);
+    // Mass fractions in species order; none gives the air molecular weight
+    speciesFields.clear();
+    for (ScalarFieldId id : speciesIds) {
+        speciesFields.push_back(&fields.getField(id));
+    }
+    
+    // Batched over all cells. The kernel reads and writes double arrays, so
+    // FLOAT-stored fields go through double scratch copies (scalar fields
+    // are laid out the same in either layout)
+    if (!temperature.isFloat() && !pressure.isFloat() && !density.isFloat()) {
+        thermo->computeDensity(temperature.data.data(), pressure.data.data(), speciesFields,
+                               0, numCells, density.data.data());
+        return;
+    }
+    ScratchField T = fields.checkoutScratch(FieldType::SCALAR);
+    ScratchField p = fields.checkoutScratch(FieldType::SCALAR);
+    ScratchField rho = fields.checkoutScratch(FieldType::SCALAR);
+    for (label i = 0; i < numCells; ++i) {
+        (*T)(i) = temperature.value(i);
+        (*p)(i) = pressure.value(i);
+    }
+    thermo->computeDensity(T->data.data(), p->data.data(), speciesFields, 0, numCells, rho->data.data());
+    for (label i = 0; i < numCells; ++i) {
+        density.setValue(i, 0, (*rho)(i));
     }
 }
 
@@ -148,4 +266,9 @@ void CFDSolver::writeOutput(double time) {
     // Would write VTK files here
 }
 
+void CFDSolver::writeCheckpoint(double time) {
+    std::cout << "Writing checkpoint at t = " << time << " s\n";
+    // Would write restart files here
+}
+
 } // namespace cfd
@@ -0,0 +1,174 @@
+#include "solver/FVMatrix.h"
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace cfd {
+
+void FVAddressing::build(const Mesh& mesh) {
+    numCells = mesh.getNumCells();
+    internalFaces.clear();
+    lowerAddr.clear();
+    upperAddr.clear();
+    boundaryFaces.clear();
+
+    std::vector<label> rowCounts(numCells, 0);
+    std::vector<label> boundaryCounts(numCells, 0);
+    for (label f = 0; f < mesh.getNumFaces(); ++f) {
+        const Face& face = mesh.faces[f];
+        if (face.isBoundary()) {
+            boundaryFaces.push_back(f);
+            boundaryCounts[face.ownerCell]++;
+        } else {
+            internalFaces.push_back(f);
+            lowerAddr.push_back(face.ownerCell);
+            upperAddr.push_back(face.neighborCell);
+            rowCounts[face.ownerCell]++;
+            rowCounts[face.neighborCell]++;
+        }
+    }
+
+    // Rows: internal face i puts upper (index i) in the owner row and
+    // lower (index nI + i) in the neighbour row
+    const label nI = getNumInternalFaces();
+    rows.allocateFromCounts(rowCounts);
+    rowCoeffs.assign(rows.indices.size(), -1);
+    std::vector<label> cursor(rows.offsets.begin(), rows.offsets.end() - 1);
+    for (label i = 0; i < nI; ++i) {
+        label k = cursor[lowerAddr[i]]++;
+        rows.indices[k] = upperAddr[i];
+        rowCoeffs[k] = i;
+        k = cursor[upperAddr[i]]++;
+        rows.indices[k] = lowerAddr[i];
+        rowCoeffs[k] = nI + i;
+    }
+
+    // Ascending columns within each row
+    std::vector<std::pair<label, label>> entries;
+    for (label c = 0; c < numCells; ++c) {
+        const label begin = rows.offsets[c];
+        const label end = rows.offsets[c + 1];
+        entries.clear();
+        for (label k = begin; k < end; ++k) {
+            entries.emplace_back(rows.indices[k], rowCoeffs[k]);
+        }
+        std::sort(entries.begin(), entries.end());
+        for (label k = begin; k < end; ++k) {
+            rows.indices[k] = entries[k - begin].first;
+            rowCoeffs[k] = entries[k - begin].second;
+        }
+    }
+
+    cellBoundaryFaces.allocateFromCounts(boundaryCounts);
+    cursor.assign(cellBoundaryFaces.offsets.begin(), cellBoundaryFaces.offsets.end() - 1);
+    for (label b = 0; b < getNumBoundaryFaces(); ++b) {
+        cellBoundaryFaces.indices[cursor[mesh.faces[boundaryFaces[b]].ownerCell]++] = b;
+    }
+}
+
+bool FVAddressing::matches(const Mesh& mesh) const {
+    return numCells == mesh.getNumCells() &&
+           getNumInternalFaces() + getNumBoundaryFaces() == mesh.getNumFaces();
+}
+
+size_t FVAddressing::getMemoryUsage() const {
+    return (internalFaces.capacity() + lowerAddr.capacity() + upperAddr.capacity() +
+            boundaryFaces.capacity() + rowCoeffs.capacity()) * sizeof(label) +
+           rows.getMemoryUsage() + cellBoundaryFaces.getMemoryUsage();
+}
+
+void FVMatrix::setAddressing(const FVAddressing& addressing_) {
+    addressing = &addressing_;
+    diag.resize(addressing->getNumCells());
+    source.resize(addressing->getNumCells());
+    offDiag.resize(2 * static_cast<size_t>(addressing->getNumInternalFaces()));
+    boundaryDiag.resize(addressing->getNumBoundaryFaces());
+    boundarySource.resize(addressing->getNumBoundaryFaces());
+}
+
+void FVMatrix::zero() {
+    std::fill(diag.begin(), diag.end(), 0.0);
+    std::fill(offDiag.begin(), offDiag.end(), 0.0);
+    std::fill(source.begin(), source.end(), 0.0);
+    std::fill(boundaryDiag.begin(), boundaryDiag.end(), 0.0);
+    std::fill(boundarySource.begin(), boundarySource.end(), 0.0);
+}
+
+void FVMatrix::clear() {
+    AlignedVector<double>().swap(diag);
+    AlignedVector<double>().swap(offDiag);
+    AlignedVector<double>().swap(source);
+    AlignedVector<double>().swap(boundaryDiag);
+    AlignedVector<double>().swap(boundarySource);
+}
+
+void FVMatrix::collectDiagonal() {
+    const label numCells = getNumCells();
+    const label nI = addressing->getNumInternalFaces();
+    const CSRConnectivity& rows = addressing->rows;
+    const CSRConnectivity& boundary = addressing->cellBoundaryFaces;
+    const label* rowCoeffs = addressing->rowCoeffs.data();
+
+    #pragma omp parallel for schedule(static)
+    for (label c = 0; c < numCells; ++c) {
+        double d = diag[c];
+        for (label k = rows.offsets[c]; k < rows.offsets[c + 1]; ++k) {
+            // The transposed coefficient: lower for an owner row, upper for
+            // a neighbour row
+            label j = rowCoeffs[k];
+            d -= offDiag[j < nI ? j + nI : j - nI];
+        }
+        double s = source[c];
+        for (label k = boundary.offsets[c]; k < boundary.offsets[c + 1]; ++k) {
+            d += boundaryDiag[boundary.indices[k]];
+            s += boundarySource[boundary.indices[k]];
+        }
+        diag[c] = d;
+        source[c] = s;
+    }
+}
+
+void FVMatrix::multiply(const double* x, double* y) const {
+    const label numCells = getNumCells();
+    const CSRConnectivity& rows = addressing->rows;
+    const label* rowCoeffs = addressing->rowCoeffs.data();
+
+    #pragma omp parallel for schedule(static)
+    for (label c = 0; c < numCells; ++c) {
+        double sum = diag[c] * x[c];
+        for (label k = rows.offsets[c]; k < rows.offsets[c + 1]; ++k) {
+            sum += offDiag[rowCoeffs[k]] * x[rows.indices[k]];
+        }
+        y[c] = sum;
+    }
+}
+
+void FVMatrix::residual(const double* x, double* r) const {
+    multiply(x, r);
+    const label numCells = getNumCells();
+    #pragma omp parallel for schedule(static)
+    for (label c = 0; c < numCells; ++c) {
+        r[c] = source[c] - r[c];
+    }
+}
+
+bool FVMatrix::isSymmetric(double tolerance) const {
+    const size_t nI = offDiag.size() / 2;
+    for (size_t i = 0; i < nI; ++i) {
+        if (std::abs(offDiag[i] - offDiag[nI + i]) > tolerance * std::abs(offDiag[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void FVMatrix::getDiagonal(double* diagonal) const {
+    std::copy(diag.begin(), diag.end(), diagonal);
+}
+
+size_t FVMatrix::getMemoryUsage() const {
+    return (diag.capacity() + offDiag.capacity() + source.capacity() + boundaryDiag.capacity() +
+            boundarySource.capacity()) * sizeof(double);
+}
+
+} // namespace cfd
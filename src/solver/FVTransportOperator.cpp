@@ -0,0 +1,73 @@
+#include "solver/FVTransportOperator.h"
+#include <algorithm>
+
+namespace cfd {
+
+void FVTransportOperator::setAddressing(const Mesh& mesh_, const FVAddressing& addressing_) {
+    mesh = &mesh_;
+    addressing = &addressing_;
+    diag.resize(addressing->getNumCells());
+}
+
+void FVTransportOperator::update(const double* massFlux_, const double* diffusivity_) {
+    massFlux = massFlux_;
+    diffusivity = diffusivity_;
+
+    const MeshGeometry& g = mesh->geometry;
+    const FVAddressing& addr = *addressing;
+    const label nI = addr.getNumInternalFaces();
+    const label numCells = getSize();
+
+    #pragma omp parallel for schedule(static)
+    for (label c = 0; c < numCells; ++c) {
+        // Minus the transposed coefficient: lower in an owner row, upper in
+        // a neighbour row
+        double d = 0.0;
+        for (label k = addr.rows.offsets[c]; k < addr.rows.offsets[c + 1]; ++k) {
+            const label j = addr.rowCoeffs[k];
+            const bool owner = j < nI;
+            const label f = addr.internalFaces[owner ? j : j - nI];
+            const label nb = addr.rows.indices[k];
+            const double w = g.faceWeight[f];
+            const double gammaF = owner ? w * diffusivity[c] + (1.0 - w) * diffusivity[nb]
+                                        : w * diffusivity[nb] + (1.0 - w) * diffusivity[c];
+            const double D = gammaF * g.faceLaplacianCoeff[f];
+            d += owner ? D + std::max(massFlux[f], 0.0) : D - std::min(massFlux[f], 0.0);
+        }
+        for (label k = addr.cellBoundaryFaces.offsets[c]; k < addr.cellBoundaryFaces.offsets[c + 1]; ++k) {
+            d += massFlux[addr.boundaryFaces[addr.cellBoundaryFaces.indices[k]]];
+        }
+        diag[c] = d;
+    }
+}
+
+void FVTransportOperator::apply(const double* x, double* y) const {
+    const MeshGeometry& g = mesh->geometry;
+    const FVAddressing& addr = *addressing;
+    const label nI = addr.getNumInternalFaces();
+    const label numCells = getSize();
+
+    #pragma omp parallel for schedule(static)
+    for (label c = 0; c < numCells; ++c) {
+        double sum = diag[c] * x[c];
+        for (label k = addr.rows.offsets[c]; k < addr.rows.offsets[c + 1]; ++k) {
+            const label j = addr.rowCoeffs[k];
+            const bool owner = j < nI;
+            const label f = addr.internalFaces[owner ? j : j - nI];
+            const label nb = addr.rows.indices[k];
+            const double w = g.faceWeight[f];
+            const double gammaF = owner ? w * diffusivity[c] + (1.0 - w) * diffusivity[nb]
+                                        : w * diffusivity[nb] + (1.0 - w) * diffusivity[c];
+            const double D = gammaF * g.faceLaplacianCoeff[f];
+            const double coeff = owner ? -D + std::min(massFlux[f], 0.0) : -D - std::max(massFlux[f], 0.0);
+            sum += coeff * x[nb];
+        }
+        y[c] = sum;
+    }
+}
+
+void FVTransportOperator::getDiagonal(double* diagonal) const {
+    std::copy(diag.begin(), diag.end(), diagonal);
+}
+
+} // namespace cfd
@@ -1,28 +1,63 @@
 #include "solver/FluidDynamics.h"
+#include "core/Reduction.h"
 #include <cmath>
 #include <algorithm>
 
 namespace cfd {
 
+namespace {
+
+// Values at the start of the step: level 1 if the field keeps old time
+// levels (the current field is then the new level being written)
+const Field& startOfStep(const FieldManager& fields, FieldId id) {
+    return fields.getNumOldTimeLevels(id) > 0 ? fields.getOldField(id) : fields.getField(id);
+}
+
+} // anonymous namespace
+
 FluidDynamics::FluidDynamics() 
-    : mesh(nullptr), thermo(nullptr), maxCourantNumber(0.0) {
+    : mesh(nullptr), thermo(nullptr), maxCourantNumber(0.0), timeStep(0.0), matrixFree(false),
+      hasFixedPressure(false), pressureGeometryVersion(0) {
 }
 
 void FluidDynamics::initialize(const Mesh& mesh_, FieldManager& fields) {
     mesh = &mesh_;
     
     // Register required fields if not already present
-    if (!fields.hasField("velocity")) {
-        fields.registerField("velocity", FieldType::VECTOR, mesh->getNumCells());
-    }
-    if (!fields.hasField("pressure")) {
-        fields.registerField("pressure", FieldType::SCALAR, mesh->getNumCells());
+    velocityId = fields.findOrRegisterVectorField("velocity", mesh->getNumCells());
+    pressureId = fields.findOrRegisterScalarField("pressure", mesh->getNumCells());
+    densityId = fields.findOrRegisterScalarField("density", mesh->getNumCells());
+    temperatureId = fields.findOrRegisterScalarField("temperature", mesh->getNumCells());
+    
+    // Sparsity pattern and coefficient storage, once per mesh
+    addressing.build(*mesh);
+    if (matrixFree) {
+        momentumOperator.setAddressing(*mesh, addressing);
+    } else {
+        momentumMatrix.setAddressing(addressing);
     }
-    if (!fields.hasField("density")) {
-        fields.registerField("density", FieldType::SCALAR, mesh->getNumCells());
+    pressureMatrix.setAddressing(addressing);
+    massFlux.assign(mesh->getNumFaces(), 0.0);
+    cellViscosity.assign(mesh->getNumCells(), 0.0);
+    pressureCorrection.assign(mesh->getNumCells(), 0.0);
+    pressureAMG.clear();
+    
+    std::vector<unsigned char> isOutlet(mesh->getNumFaces(), 0);
+    std::vector<unsigned char> isClosed(mesh->getNumFaces(), 0);
+    for (const auto& pair : mesh->boundaries) {
+        const std::string& type = pair.second.type;
+        for (label f : pair.second.faceIds) {
+            isOutlet[f] = (type == "outlet");
+            isClosed[f] = (type == "wall" || type == "symmetry");
+        }
     }
-    if (!fields.hasField("temperature")) {
-        fields.registerField("temperature", FieldType::SCALAR, mesh->getNumCells());
+    fixedPressureFace.resize(addressing.getNumBoundaryFaces());
+    closedFace.resize(addressing.getNumBoundaryFaces());
+    hasFixedPressure = false;
+    for (label b = 0; b < addressing.getNumBoundaryFaces(); ++b) {
+        fixedPressureFace[b] = isOutlet[addressing.boundaryFaces[b]];
+        closedFace[b] = isClosed[addressing.boundaryFaces[b]];
+        hasFixedPressure = hasFixedPressure || fixedPressureFace[b];
     }
 }
 
@@ -30,17 +65,34 @@ void FluidDynamics::setThermodynamicProperties(ThermodynamicProperties* thermo_)
     thermo = thermo_;
 }
 
+void FluidDynamics::setMatrixFree(bool matrixFree_) {
+    matrixFree = matrixFree_;
+    if (!mesh) return;
+    
+    // Keep storage for the representation in use only
+    if (matrixFree) {
+        momentumMatrix.clear();
+        momentumOperator.setAddressing(*mesh, addressing);
+    } else {
+        AlignedVector<double>().swap(momentumOperator.diag);
+        momentumMatrix.setAddressing(addressing);
+    }
+}
+
+const LinearOperator& FluidDynamics::getMomentumSystem() const {
+    if (matrixFree) return momentumOperator;
+    return momentumMatrix;
+}
+
 void FluidDynamics::computeMomentum(FieldManager& fields, double dt) {
     // Simplified momentum equation solver
     // In production, would assemble and solve full momentum matrix
     
-    Field& velocity = fields.getField("velocity");
-    Field& pressure = fields.getField("pressure");
-    Field& density = fields.getField("density");
+    const Field& velocity = startOfStep(fields, velocityId);
     
     // Compute Courant number
     maxCourantNumber = 0.0;
-    for (int i = 0; i < mesh->getNumCells(); ++i) {
+    for (label i = 0; i < mesh->getNumCells(); ++i) {
         const Cell& cell = mesh->getCell(i);
         double u = std::sqrt(velocity(i, 0)*velocity(i, 0) + 
                             velocity(i, 1)*velocity(i, 1) + 
@@ -50,72 +102,274 @@ void FluidDynamics::computeMomentum(FieldManager& fields, double dt) {
         maxCourantNumber = std::max(maxCourantNumber, Co);
     }
     
+    timeStep = dt;
+    computeMassFlux(fields);
+    computeViscosity(fields);
+    if (matrixFree) {
+        updateMomentumOperator(fields, dt);
+    } else {
+        assembleMomentumMatrix(fields, dt);
+    }
+    
     // Placeholder: would solve momentum equations here
 }
 
 void FluidDynamics::solvePressureCorrection(FieldManager& fields) {
-    // SIMPLE algorithm pressure correction
-    // Placeholder implementation
+    // SIMPLE pressure correction: -laplacian(p') = -div(massFlux) / dt,
+    // solved by PCG with the AMG preconditioner
+    
+    const Field& pressureOld = startOfStep(fields, pressureId);
+    Field& pressure = fields.getField(pressureId);
+    const label numCells = mesh->getNumCells();
+    
+    // The coefficients and the hierarchy follow the geometry; while the
+    // mesh is static only the source is refilled
+    if (!pressureAMG.isSetUp() || pressureGeometryVersion != mesh->getGeometryVersion()) {
+        assemblePressureMatrix();
+        pressureAMG.setup(pressureMatrix);
+        pressureGeometryVersion = mesh->getGeometryVersion();
+    }
+    assemblePressureSource(timeStep);
     
-    Field& pressure = fields.getField("pressure");
+    // Without a fixed-pressure boundary p' is defined up to a constant:
+    // make the source compatible and pick the zero-mean solution
+    double* source = pressureMatrix.source.data();
+    double* correction = pressureCorrection.data();
+    if (!hasFixedPressure) {
+        const double mean = reproducibleSum(numCells, [&](size_t c) { return source[c]; }) / numCells;
+        for (label c = 0; c < numCells; ++c) source[c] -= mean;
+    }
+    std::fill(pressureCorrection.begin(), pressureCorrection.end(), 0.0);
+    pressurePerformance = pressureSolver.solve(pressureMatrix, pressureAMG, source, correction);
+    if (!hasFixedPressure) {
+        const double mean = reproducibleSum(numCells, [&](size_t c) { return correction[c]; }) / numCells;
+        for (label c = 0; c < numCells; ++c) correction[c] -= mean;
+    }
     
-    // Would assemble and solve pressure Poisson equation
-    // For now, just ensure positive pressure
-    for (int i = 0; i < mesh->getNumCells(); ++i) {
-        pressure(i) = std::max(pressure(i), 1000.0);
+    // Keep pressure physical
+    for (label i = 0; i < numCells; ++i) {
+        pressure(i) = std::max(pressureOld(i) + correction[i], 1000.0);
     }
 }
 
 void FluidDynamics::updateVelocity(FieldManager& fields) {
-    // Update velocity based on pressure correction
-    // Placeholder implementation
+    // U = U_old - dt / rho grad(p'), with a Gauss gradient of the
+    // correction (p'_f = 0 on outlets, the owner value on other boundaries)
     
-    Field& velocity = fields.getField("velocity");
-    Field& pressure = fields.getField("pressure");
+    const Field& velocityOld = startOfStep(fields, velocityId);
+    const Field& density = startOfStep(fields, densityId);
+    Field& velocity = fields.getField(velocityId);
+    const MeshGeometry& g = mesh->geometry;
+    const FVAddressing& addr = addressing;
+    const label nI = addr.getNumInternalFaces();
+    const double* correction = pressureCorrection.data();
+    const label numCells = mesh->getNumCells();
     
-    // Would apply pressure gradient correction to velocity
+    #pragma omp parallel for schedule(static)
+    for (label c = 0; c < numCells; ++c) {
+        double grad[3] = {0.0, 0.0, 0.0};
+        for (label k = addr.rows.offsets[c]; k < addr.rows.offsets[c + 1]; ++k) {
+            // Owner row of internal face j, or the neighbour row (area reversed)
+            const label j = addr.rowCoeffs[k];
+            const label f = addr.internalFaces[j < nI ? j : j - nI];
+            const double sign = (j < nI) ? 1.0 : -1.0;
+            const double w = g.faceWeight[f];
+            const double pf = (j < nI) ? w * correction[c] + (1.0 - w) * correction[addr.rows.indices[k]]
+                                       : w * correction[addr.rows.indices[k]] + (1.0 - w) * correction[c];
+            grad[0] += sign * pf * g.faceAreaX[f];
+            grad[1] += sign * pf * g.faceAreaY[f];
+            grad[2] += sign * pf * g.faceAreaZ[f];
+        }
+        for (label k = addr.cellBoundaryFaces.offsets[c]; k < addr.cellBoundaryFaces.offsets[c + 1]; ++k) {
+            const label b = addr.cellBoundaryFaces.indices[k];
+            const label f = addr.boundaryFaces[b];
+            const double pf = fixedPressureFace[b] ? 0.0 : correction[c];
+            grad[0] += pf * g.faceAreaX[f];
+            grad[1] += pf * g.faceAreaY[f];
+            grad[2] += pf * g.faceAreaZ[f];
+        }
+        const double scale = timeStep / (density.value(c) * g.cellVolume[c]);
+        for (int d = 0; d < 3; ++d) {
+            velocity(c, d) = velocityOld.value(c, d) - scale * grad[d];
+        }
+    }
 }
 
 void FluidDynamics::solveEnergy(FieldManager& fields, double dt) {
     // Energy equation solver
     // Placeholder implementation
     
-    Field& temperature = fields.getField("temperature");
-    Field& density = fields.getField("density");
+    const Field& temperatureOld = startOfStep(fields, temperatureId);
+    Field& temperature = fields.getField(temperatureId);
     
     // Would solve energy transport equation
     // For now, ensure physical temperature range
-    for (int i = 0; i < mesh->getNumCells(); ++i) {
-        temperature(i) = std::max(temperature(i), 200.0);
-        temperature(i) = std::min(temperature(i), 3000.0);
+    for (label i = 0; i < mesh->getNumCells(); ++i) {
+        temperature(i) = std::min(std::max(temperatureOld(i), 200.0), 3000.0);
+    }
+}
+
+double FluidDynamics::computeConvectiveFlux(label faceId, const Field& phi, const Field& velocity) {
+    // Upwind scheme; the face velocity is linearly interpolated
+    const MeshGeometry& g = mesh->geometry;
+    const Face& face = mesh->faces[faceId];
+    const label owner = face.ownerCell;
+    const label neighbor = face.neighborCell;
+    
+    double uFace[3];
+    for (int d = 0; d < 3; ++d) {
+        uFace[d] = velocity(owner, d);
+        if (neighbor >= 0) {
+            double w = g.faceWeight[faceId];
+            uFace[d] = w * uFace[d] + (1.0 - w) * velocity(neighbor, d);
+        }
+    }
+    double flux = uFace[0] * g.faceAreaX[faceId] + uFace[1] * g.faceAreaY[faceId] +
+                  uFace[2] * g.faceAreaZ[faceId];
+    
+    // Boundary faces take the owner value (zero gradient)
+    double phiUpwind = (flux >= 0.0 || neighbor < 0) ? phi.value(owner) : phi.value(neighbor);
+    return flux * phiUpwind;
+}
+
+double FluidDynamics::computeDiffusiveFlux(label faceId, const Field& phi) {
+    // Central differencing for diffusive flux. The non-orthogonal part,
+    // |S_f| * (faceNonOrth . grad(phi)_f), is left to deferred correction.
+    const Face& face = mesh->faces[faceId];
+    if (face.isBoundary()) {
+        return 0.0;  // Zero gradient
+    }
+    
+    return face.area * mesh->geometry.faceDeltaCoeff[faceId] *
+           (phi.value(face.neighborCell) - phi.value(face.ownerCell));
+}
+
+void FluidDynamics::computeMassFlux(const FieldManager& fields) {
+    // Start-of-step values; open boundary faces take the owner value
+    const Field& velocity = startOfStep(fields, velocityId);
+    const Field& density = startOfStep(fields, densityId);
+    const MeshGeometry& g = mesh->geometry;
+    const label numFaces = mesh->getNumFaces();
+    
+    #pragma omp parallel for schedule(static)
+    for (label f = 0; f < numFaces; ++f) {
+        const Face& face = mesh->faces[f];
+        const label P = face.ownerCell;
+        const label N = face.isBoundary() ? P : face.neighborCell;
+        const double w = g.faceWeight[f];
+        double rhoU[3];
+        for (int d = 0; d < 3; ++d) {
+            rhoU[d] = w * density.value(P) * velocity.value(P, d) +
+                      (1.0 - w) * density.value(N) * velocity.value(N, d);
+        }
+        massFlux[f] = rhoU[0] * g.faceAreaX[f] + rhoU[1] * g.faceAreaY[f] + rhoU[2] * g.faceAreaZ[f];
+    }
+    
+    // Walls and symmetry planes carry no flux
+    const label numBoundaryFaces = addressing.getNumBoundaryFaces();
+    for (label b = 0; b < numBoundaryFaces; ++b) {
+        if (closedFace[b]) massFlux[addressing.boundaryFaces[b]] = 0.0;
     }
 }
 
-double FluidDynamics::computeConvectiveFlux(int faceId, const Field& phi, const Field& velocity) {
-    // Upwind scheme for convective flux
-    // Placeholder
-    return 0.0;
+void FluidDynamics::computeViscosity(const FieldManager& fields) {
+    // Cell values; faces interpolate them
+    const Field& temperature = startOfStep(fields, temperatureId);
+    static const std::vector<const Field*> noSpecies;
+    const label numCells = mesh->getNumCells();
+    
+    if (thermo && !temperature.isFloat()) {
+        thermo->computeViscosity(temperature.data.data(), noSpecies, 0, numCells, cellViscosity.data());
+        return;
+    }
+    static const std::vector<double> noMassFractions;
+    #pragma omp parallel for schedule(static)
+    for (label c = 0; c < numCells; ++c) {
+        cellViscosity[c] = thermo ? thermo->getViscosity(temperature.value(c), noMassFractions) : 1.8e-5;
+    }
 }
 
-double FluidDynamics::computeDiffusiveFlux(int faceId, const Field& phi) {
-    // Central differencing for diffusive flux
-    // Placeholder
-    return 0.0;
+void FluidDynamics::assembleMomentumMatrix(const FieldManager& fields, double dt) {
+    // rho V / dt + upwind convection - laplacian(mu): the coefficients are
+    // shared by all velocity components
+    const Field& density = startOfStep(fields, densityId);
+    const MeshGeometry& g = mesh->geometry;
+    
+    FVMatrix& A = momentumMatrix;
+    A.zero();
+    A.fillInternalFaces([&](label, label f, double& upper, double& lower) {
+        const Face& face = mesh->faces[f];
+        const double w = g.faceWeight[f];
+        const double muF = w * cellViscosity[face.ownerCell] + (1.0 - w) * cellViscosity[face.neighborCell];
+        const double D = muF * g.faceLaplacianCoeff[f];
+        const double F = massFlux[f];
+        upper = -D + std::min(F, 0.0);
+        lower = -D - std::max(F, 0.0);
+    });
+    // Zero gradient: the outgoing (or incoming) flux carries the owner value
+    A.fillBoundaryFaces([&](label, label f, double& diag, double&) {
+        diag = massFlux[f];
+    });
+    A.collectDiagonal();
+    
+    const label numCells = mesh->getNumCells();
+    #pragma omp parallel for schedule(static)
+    for (label c = 0; c < numCells; ++c) {
+        A.diag[c] += density.value(c) * g.cellVolume[c] / dt;
+    }
 }
 
-void FluidDynamics::assembleMomentumMatrix() {
-    // Assemble momentum equation matrix
-    // Placeholder
+void FluidDynamics::updateMomentumOperator(const FieldManager& fields, double dt) {
+    const Field& density = startOfStep(fields, densityId);
+    const MeshGeometry& g = mesh->geometry;
+    
+    FVTransportOperator& A = momentumOperator;
+    A.update(massFlux.data(), cellViscosity.data());
+    
+    const label numCells = mesh->getNumCells();
+    #pragma omp parallel for schedule(static)
+    for (label c = 0; c < numCells; ++c) {
+        A.diag[c] += density.value(c) * g.cellVolume[c] / dt;
+    }
 }
 
 void FluidDynamics::assemblePressureMatrix() {
-    // Assemble pressure Poisson equation matrix
-    // Placeholder
+    // -laplacian(p') = -div(massFlux) / dt: the correction p' makes the face
+    // fluxes F - dt |S_f| deltaCoeff (p'_N - p'_P) conservative. The
+    // coefficients are geometric only (dt is in the source), so the matrix
+    // stays the same while the mesh is static. Symmetric.
+    const MeshGeometry& g = mesh->geometry;
+    FVMatrix& A = pressureMatrix;
+    A.zero();
+    A.fillInternalFaces([&](label, label f, double& upper, double& lower) {
+        upper = lower = -g.faceLaplacianCoeff[f];
+    });
+    // Fixed pressure (p' = 0) at outlets; elsewhere zero gradient
+    A.fillBoundaryFaces([&](label b, label f, double& diag, double&) {
+        diag = fixedPressureFace[b] ? g.faceLaplacianCoeff[f] : 0.0;
+    });
+    A.collectDiagonal();
 }
 
-void FluidDynamics::correctVelocity() {
-    // Apply pressure correction to velocity
-    // Placeholder
+void FluidDynamics::assemblePressureSource(double dt) {
+    // Net outflow of each cell through its internal and boundary faces
+    const FVAddressing& addr = addressing;
+    const label nI = addr.getNumInternalFaces();
+    const label numCells = mesh->getNumCells();
+    const double invDt = 1.0 / dt;
+    double* source = pressureMatrix.source.data();
+    #pragma omp parallel for schedule(static)
+    for (label c = 0; c < numCells; ++c) {
+        double outflow = 0.0;
+        for (label k = addr.rows.offsets[c]; k < addr.rows.offsets[c + 1]; ++k) {
+            const label j = addr.rowCoeffs[k];
+            outflow += (j < nI) ? massFlux[addr.internalFaces[j]] : -massFlux[addr.internalFaces[j - nI]];
+        }
+        for (label k = addr.cellBoundaryFaces.offsets[c]; k < addr.cellBoundaryFaces.offsets[c + 1]; ++k) {
+            outflow += massFlux[addr.boundaryFaces[addr.cellBoundaryFaces.indices[k]]];
+        }
+        source[c] = -outflow * invDt;
+    }
 }
 
 } // namespace cfd
@@ -0,0 +1,142 @@
+#include "solver/LinearSolver.h"
+#include "core/FieldKernels.h"
+#include <cmath>
+
+namespace cfd {
+
+void JacobiPreconditioner::setup(const LinearOperator& A) {
+    invDiagonal.resize(A.getSize());
+    A.getDiagonal(invDiagonal.data());
+    for (double& d : invDiagonal) {
+        d = (d != 0.0) ? 1.0 / d : 0.0;
+    }
+}
+
+void JacobiPreconditioner::apply(const double* r, double* z) const {
+    const label n = static_cast<label>(invDiagonal.size());
+    #pragma omp parallel for schedule(static)
+    for (label i = 0; i < n; ++i) {
+        z[i] = invDiagonal[i] * r[i];
+    }
+}
+
+SolverPerformance PCGSolver::solve(const LinearOperator& A, const Preconditioner& M, const double* b, double* x) {
+    const label n = A.getSize();
+    r.resize(n);
+    z.resize(n);
+    p.resize(n);
+    q.resize(n);
+
+    SolverPerformance performance;
+    const double normB = std::sqrt(kernels::dot(b, b, n));
+    if (normB == 0.0) {
+        for (label i = 0; i < n; ++i) x[i] = 0.0;
+        performance.converged = true;
+        return performance;
+    }
+
+    A.apply(x, r.data());
+    #pragma omp parallel for schedule(static)
+    for (label i = 0; i < n; ++i) {
+        r[i] = b[i] - r[i];
+    }
+    double residual = std::sqrt(kernels::dot(r.data(), r.data(), n)) / normB;
+    performance.initialResidual = residual;
+
+    double rz = 0.0;
+    while (residual > relativeTolerance && performance.iterations < maxIterations) {
+        M.apply(r.data(), z.data());
+        const double rzNew = kernels::dot(r.data(), z.data(), n);
+        const double beta = (performance.iterations == 0) ? 0.0 : rzNew / rz;
+        rz = rzNew;
+        #pragma omp parallel for schedule(static)
+        for (label i = 0; i < n; ++i) {
+            p[i] = z[i] + beta * p[i];
+        }
+
+        A.apply(p.data(), q.data());
+        const double pq = kernels::dot(p.data(), q.data(), n);
+        if (pq <= 0.0) {
+            break;  // Not positive definite along p (or exactly converged)
+        }
+        const double alpha = rz / pq;
+        #pragma omp parallel for schedule(static)
+        for (label i = 0; i < n; ++i) {
+            x[i] += alpha * p[i];
+            r[i] -= alpha * q[i];
+        }
+        residual = std::sqrt(kernels::dot(r.data(), r.data(), n)) / normB;
+        performance.iterations++;
+    }
+
+    performance.finalResidual = residual;
+    performance.converged = residual <= relativeTolerance;
+    return performance;
+}
+
+SolverPerformance BiCGStabSolver::solve(const LinearOperator& A, const Preconditioner& M, const double* b, double* x) {
+    const label n = A.getSize();
+    for (AlignedVector<double>* work : {&r, &r0, &p, &v, &s, &t, &pHat, &sHat}) {
+        work->assign(n, 0.0);
+    }
+
+    SolverPerformance performance;
+    const double normB = std::sqrt(kernels::dot(b, b, n));
+    if (normB == 0.0) {
+        for (label i = 0; i < n; ++i) x[i] = 0.0;
+        performance.converged = true;
+        return performance;
+    }
+
+    A.apply(x, r.data());
+    #pragma omp parallel for schedule(static)
+    for (label i = 0; i < n; ++i) {
+        r[i] = b[i] - r[i];
+        r0[i] = r[i];
+    }
+    double residual = std::sqrt(kernels::dot(r.data(), r.data(), n)) / normB;
+    performance.initialResidual = residual;
+
+    double rho = 1.0, alpha = 1.0, omega = 1.0;
+    while (residual > relativeTolerance && performance.iterations < maxIterations) {
+        const double rhoNew = kernels::dot(r0.data(), r.data(), n);
+        if (rhoNew == 0.0) {
+            break;  // Breakdown: r orthogonal to the shadow residual
+        }
+        const double beta = (rhoNew / rho) * (alpha / omega);
+        rho = rhoNew;
+        #pragma omp parallel for schedule(static)
+        for (label i = 0; i < n; ++i) {
+            p[i] = r[i] + beta * (p[i] - omega * v[i]);
+        }
+
+        M.apply(p.data(), pHat.data());
+        A.apply(pHat.data(), v.data());
+        alpha = rho / kernels::dot(r0.data(), v.data(), n);
+        #pragma omp parallel for schedule(static)
+        for (label i = 0; i < n; ++i) {
+            s[i] = r[i] - alpha * v[i];
+        }
+
+        M.apply(s.data(), sHat.data());
+        A.apply(sHat.data(), t.data());
+        const double tt = kernels::dot(t.data(), t.data(), n);
+        omega = (tt > 0.0) ? kernels::dot(t.data(), s.data(), n) / tt : 0.0;
+        #pragma omp parallel for schedule(static)
+        for (label i = 0; i < n; ++i) {
+            x[i] += alpha * pHat[i] + omega * sHat[i];
+            r[i] = s[i] - omega * t[i];
+        }
+        residual = std::sqrt(kernels::dot(r.data(), r.data(), n)) / normB;
+        performance.iterations++;
+        if (omega == 0.0) {
+            break;  // Stagnation
+        }
+    }
+
+    performance.finalResidual = residual;
+    performance.converged = residual <= relativeTolerance;
+    return performance;
+}
+
+} // namespace cfd
@@ -1,14 +1,73 @@
 #include "solver/ThermodynamicProperties.h"
 #include <cmath>
 #include <algorithm>
+#include <stdexcept>
 
 namespace cfd {
 
+namespace {
+
+// Cells per block of the batched functions (stack buffers of this size)
+constexpr label THERMO_BLOCK = 256;
+
+// NASA polynomial of species s at T, range chosen per cell with selects so
+// that the cell loop vectorizes. a points at the 14 coefficients (low
+// range, then high range).
+inline double nasaCoeff(const double* a, int k, double T, double Tmid) {
+    return (T < Tmid) ? a[k] : a[7 + k];
+}
+
+inline double cpOverR(const double* a, double T, double Tmid) {
+    return nasaCoeff(a, 0, T, Tmid) + T * (nasaCoeff(a, 1, T, Tmid) + T * (nasaCoeff(a, 2, T, Tmid) +
+           T * (nasaCoeff(a, 3, T, Tmid) + T * nasaCoeff(a, 4, T, Tmid))));
+}
+
+inline double hOverR(const double* a, double T, double Tmid) {
+    return T * (nasaCoeff(a, 0, T, Tmid) + T * (nasaCoeff(a, 1, T, Tmid) / 2.0 + T * (nasaCoeff(a, 2, T, Tmid) / 3.0 +
+           T * (nasaCoeff(a, 3, T, Tmid) / 4.0 + T * nasaCoeff(a, 4, T, Tmid) / 5.0)))) + nasaCoeff(a, 5, T, Tmid);
+}
+
+void checkSpeciesFields(const std::vector<const Field*>& Y, label end) {
+    for (const Field* field : Y) {
+        if (!field || field->getNumComponents() != 1 || static_cast<label>(field->getSize()) < end) {
+            throw std::invalid_argument("Species mass fractions must be scalar fields covering the cell range");
+        }
+    }
+}
+
+// Run blockFn(blockBegin, blockSize) over [begin, end) in parallel blocks
+template <typename BlockFn>
+void forEachBlock(label begin, label end, BlockFn blockFn) {
+    const label numBlocks = (end > begin) ? (end - begin + THERMO_BLOCK - 1) / THERMO_BLOCK : 0;
+    #pragma omp parallel for schedule(static)
+    for (label b = 0; b < numBlocks; ++b) {
+        const label blockBegin = begin + b * THERMO_BLOCK;
+        blockFn(blockBegin, std::min(THERMO_BLOCK, end - blockBegin));
+    }
+}
+
+template <typename T, typename Term>
+void addWeighted(const T* y, label n, Term term, double* sum) {
+    #pragma omp simd
+    for (label i = 0; i < n; ++i) {
+        sum[i] += static_cast<double>(y[i]) * term(i);
+    }
+}
+
+} // anonymous namespace
+
 ThermodynamicProperties::ThermodynamicProperties() {
 }
 
 void ThermodynamicProperties::addSpecies(const Species& spec) {
     species.push_back(spec);
+    speciesInvMW.push_back(1.0 / spec.getMolecularWeight());
+    speciesR.push_back(R_universal / spec.getMolecularWeight());
+    speciesTmid.push_back(spec.getTmid());
+    const std::vector<double>& low = spec.getNASACoeffsLowT();
+    const std::vector<double>& high = spec.getNASACoeffsHighT();
+    speciesNASA.insert(speciesNASA.end(), low.begin(), low.end());
+    speciesNASA.insert(speciesNASA.end(), high.begin(), high.end());
 }
 
 double ThermodynamicProperties::getMolecularWeight(const std::vector<double>& Y) const {
@@ -53,11 +112,7 @@ double ThermodynamicProperties::getViscosity(double T, const std::vector<double>
 double ThermodynamicProperties::computeViscosityWilke(double T, const std::vector<double>& Y) const {
     // Simplified Wilke's mixing rule
     // For now, use Sutherland's law for air as approximation
-    double T0 = 273.15;  // K
-    double mu0 = 1.716e-5;  // Pa·s
-    double S = 110.4;  // K
-    
-    return getSutherlandViscosity(T, T0, mu0, S);
+    return getSutherlandViscosity(T, sutherlandT0, sutherlandMu0, sutherlandS);
 }
 
 double ThermodynamicProperties::getSutherlandViscosity(double T, double T0, double mu0, double S) const {
@@ -79,6 +134,80 @@ double ThermodynamicProperties::computeTemperature(double rho, double p, const s
     return p / (rho * R_specific);
 }
 
+template <typename SpeciesTerm>
+void ThermodynamicProperties::accumulateBlock(const double* T, const std::vector<const Field*>& Y, label begin,
+                                              label n, SpeciesTerm term, double* sum) const {
+    // Species beyond either list are ignored, as in the per-cell functions
+    const int numSpecies = static_cast<int>(std::min(species.size(), Y.size()));
+    for (label i = 0; i < n; ++i) sum[i] = 0.0;
+    for (int s = 0; s < numSpecies; ++s) {
+        const Field& field = *Y[s];
+        auto speciesTerm = [&](label i) { return term(s, T[begin + i]); };
+        if (field.isFloat()) {
+            addWeighted(field.floatData.data() + begin, n, speciesTerm, sum);
+        } else {
+            addWeighted(field.data.data() + begin, n, speciesTerm, sum);
+        }
+    }
+}
+
+void ThermodynamicProperties::computeDensity(const double* T, const double* p, const std::vector<const Field*>& Y,
+                                             label begin, label end, double* rho) const {
+    checkSpeciesFields(Y, end);
+    const double* invMW = speciesInvMW.data();
+    forEachBlock(begin, end, [&](label blockBegin, label n) {
+        double invMWMix[THERMO_BLOCK];
+        accumulateBlock(T, Y, blockBegin, n, [invMW](int s, double) { return invMW[s]; }, invMWMix);
+        #pragma omp simd
+        for (label i = 0; i < n; ++i) {
+            const label c = blockBegin + i;
+            const double MW = (invMWMix[i] > 1e-10) ? (1.0 / invMWMix[i]) : 28.97;  // Default to air MW
+            rho[c] = p[c] / ((R_universal / MW) * T[c]);
+        }
+    });
+}
+
+void ThermodynamicProperties::computeCp(const double* T, const std::vector<const Field*>& Y, label begin, label end,
+                                        double* cp) const {
+    checkSpeciesFields(Y, end);
+    const double* nasa = speciesNASA.data();
+    const double* Tmid = speciesTmid.data();
+    const double* R = speciesR.data();
+    forEachBlock(begin, end, [&](label blockBegin, label n) {
+        accumulateBlock(T, Y, blockBegin, n, [=](int s, double Tc) {
+            return R[s] * cpOverR(nasa + 14 * s, Tc, Tmid[s]);
+        }, cp + blockBegin);
+    });
+}
+
+void ThermodynamicProperties::computeEnthalpy(const double* T, const std::vector<const Field*>& Y, label begin,
+                                              label end, double* h) const {
+    checkSpeciesFields(Y, end);
+    const double* nasa = speciesNASA.data();
+    const double* Tmid = speciesTmid.data();
+    const double* R = speciesR.data();
+    forEachBlock(begin, end, [&](label blockBegin, label n) {
+        accumulateBlock(T, Y, blockBegin, n, [=](int s, double Tc) {
+            return R[s] * hOverR(nasa + 14 * s, Tc, Tmid[s]);
+        }, h + blockBegin);
+    });
+}
+
+void ThermodynamicProperties::computeViscosity(const double* T, const std::vector<const Field*>& Y, label begin,
+                                               label end, double* mu) const {
+    // Sutherland's law for air, as getViscosity(); (T/T0)^1.5 as r sqrt(r)
+    // so that the loop vectorizes
+    checkSpeciesFields(Y, end);
+    forEachBlock(begin, end, [&](label blockBegin, label n) {
+        #pragma omp simd
+        for (label i = 0; i < n; ++i) {
+            const label c = blockBegin + i;
+            const double r = T[c] / sutherlandT0;
+            mu[c] = sutherlandMu0 * r * std::sqrt(r) * (sutherlandT0 + sutherlandS) / (T[c] + sutherlandS);
+        }
+    });
+}
+
 double ThermodynamicProperties::getSpeciesCp(int speciesIndex, double T) const {
     if (speciesIndex >= 0 && speciesIndex < static_cast<int>(species.size())) {
         return species[speciesIndex].getCp(T);
@@ -0,0 +1,45 @@
+#include "solver/TimeStepController.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace cfd {
+
+double TimeStepController::courantLimitedStep(double lastDt, double courant) const {
+    if (courant <= 0.0) {
+        return std::numeric_limits<double>::max();  // Fluid at rest: no limit
+    }
+    return lastDt * limits.maxCourant / courant;
+}
+
+double TimeStepController::proposeTimeStep(double lastDt, double courant, double lastProposal,
+                                           double physicsLimit) const {
+    double dt = std::min({courantLimitedStep(lastDt, courant), lastProposal * limits.maxGrowth, physicsLimit,
+                          limits.maxTimeStep});
+    return std::max(dt, limits.minTimeStep);
+}
+
+double TimeStepController::fitToSyncTime(double time, double dt, double syncTime, bool& landsOnSync) const {
+    // Land on the sync time; split the approach instead of leaving a sliver.
+    // dt >= minTimeStep and the landing window is syncTolerance() wide, so
+    // neither the step nor what is left after it is below minTimeStep.
+    const double remaining = syncTime - time;
+    const double tolerance = syncTolerance(syncTime);
+    landsOnSync = false;
+    if (remaining <= tolerance) {
+        return dt;  // Already reached
+    }
+    if (dt >= remaining - tolerance) {
+        dt = remaining;
+        landsOnSync = true;
+    } else if (dt > 0.5 * remaining) {
+        dt = 0.5 * remaining;
+    }
+    return dt;
+}
+
+double TimeStepController::syncTolerance(double syncTime) const {
+    return std::max(limits.minTimeStep, 16.0 * std::numeric_limits<double>::epsilon() * std::abs(syncTime));
+}
+
+} // namespace cfd
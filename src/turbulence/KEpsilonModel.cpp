@@ -10,15 +10,21 @@ KEpsilonModel::KEpsilonModel() {
 void KEpsilonModel::initialize(const Mesh& mesh_, FieldManager& fields) {
     mesh = &mesh_;
     
-    // Register turbulence fields
+    // Register turbulence fields, stored in float (the model computes in
+    // double); fields registered beforehand keep their precision
     if (!fields.hasField("k")) {
-        fields.registerField("k", FieldType::SCALAR, mesh->getNumCells());
-        fields.getField("k").fill(0.1);  // Initial turbulent kinetic energy
+        kId = fields.registerScalarField("k", mesh->getNumCells(), FieldPrecision::FLOAT);
+        fields.getField(kId).fill(0.1);  // Initial turbulent kinetic energy
+    } else {
+        kId = fields.getScalarFieldId("k");
     }
     if (!fields.hasField("epsilon")) {
-        fields.registerField("epsilon", FieldType::SCALAR, mesh->getNumCells());
-        fields.getField("epsilon").fill(0.01);  // Initial dissipation rate
+        epsilonId = fields.registerScalarField("epsilon", mesh->getNumCells(), FieldPrecision::FLOAT);
+        fields.getField(epsilonId).fill(0.01);  // Initial dissipation rate
+    } else {
+        epsilonId = fields.getScalarFieldId("epsilon");
     }
+    densityId = fields.findOrRegisterScalarField("density", mesh->getNumCells());
     
     turbulentViscosity.resize(mesh->getNumCells(), 0.0);
 }
@@ -42,14 +48,13 @@ void KEpsilonModel::solveKEquation(FieldManager& fields, double dt) {
     // P = production term (from velocity gradients)
     // In production, would solve full transport equation
     
-    Field& k = fields.getField("k");
-    Field& epsilon = fields.getField("epsilon");
+    Field& k = fields.getField(kId);
+    Field& epsilon = fields.getField(epsilonId);
     
-    for (int i = 0; i < mesh->getNumCells(); ++i) {
+    for (label i = 0; i < mesh->getNumCells(); ++i) {
         double P = 0.01;  // Placeholder production term
-        double dk_dt = P - epsilon(i);
-        k(i) += dk_dt * dt;
-        k(i) = std::max(k(i), 1e-10);  // Ensure positive
+        double dk_dt = P - epsilon.value(i);
+        k.setValue(i, 0, std::max(k.value(i) + dk_dt * dt, 1e-10));  // Ensure positive
     }
 }
 
@@ -57,27 +62,31 @@ void KEpsilonModel::solveEpsilonEquation(FieldManager& fields, double dt) {
     // Simplified epsilon equation: deps/dt = (C1*P - C2*eps) * eps/k
     // In production, would solve full transport equation
     
-    Field& k = fields.getField("k");
-    Field& epsilon = fields.getField("epsilon");
+    Field& k = fields.getField(kId);
+    Field& epsilon = fields.getField(epsilonId);
     
-    for (int i = 0; i < mesh->getNumCells(); ++i) {
+    for (label i = 0; i < mesh->getNumCells(); ++i) {
         double P = 0.01;  // Placeholder production term
-        double deps_dt = (C1 * P - C2 * epsilon(i)) * epsilon(i) / std::max(k(i), 1e-10);
-        epsilon(i) += deps_dt * dt;
-        epsilon(i) = std::max(epsilon(i), 1e-10);  // Ensure positive
+        double eps = epsilon.value(i);
+        double deps_dt = (C1 * P - C2 * eps) * eps / std::max(k.value(i), 1e-10);
+        epsilon.setValue(i, 0, std::max(eps + deps_dt * dt, 1e-10));  // Ensure positive
     }
 }
 
 void KEpsilonModel::updateTurbulentViscosity(FieldManager& fields) {
-    // mu_t = rho * Cmu * k^2 / epsilon
+    // mu_t = rho * Cmu * k^2 / epsilon, with the start-of-step density:
+    // when an old level is kept, the current density holds the recycled
+    // buffer until the thermodynamics update rewrites it
     
-    Field& k = fields.getField("k");
-    Field& epsilon = fields.getField("epsilon");
-    Field& density = fields.getField("density");
+    const Field& k = fields.getField(kId);
+    const Field& epsilon = fields.getField(epsilonId);
+    const Field& density = fields.getNumOldTimeLevels(densityId) > 0 ? fields.getOldField(densityId)
+                                                                      : fields.getField(densityId);
     
-    for (int i = 0; i < mesh->getNumCells(); ++i) {
-        double rho = density(i);
-        turbulentViscosity[i] = rho * Cmu * k(i) * k(i) / std::max(epsilon(i), 1e-10);
+    for (label i = 0; i < mesh->getNumCells(); ++i) {
+        double rho = density.value(i);
+        double ki = k.value(i);
+        turbulentViscosity[i] = rho * Cmu * ki * ki / std::max(epsilon.value(i), 1e-10);
     }
 }
 
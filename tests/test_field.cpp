@@ -1,7 +1,14 @@
 #include <gtest/gtest.h>
 #include "core/Field.h"
 #include "core/FieldManager.h"
+#include "core/FieldIntegrals.h"
+#include "mesh/MeshGenerator.h"
 #include <cmath>
+#include <limits>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <omp.h>
 
 using namespace cfd;
 
@@ -222,3 +229,650 @@ TEST(FieldManagerTest, RemoveField) {
     manager.removeField("temp");
     EXPECT_FALSE(manager.hasField("temp"));
 }
+
+TEST(FieldTest, LabelRange) {
+#ifdef CFD_LABEL_64
+    EXPECT_EQ(sizeof(label), 8u);
+#else
+    EXPECT_EQ(sizeof(label), 4u);
+#endif
+    EXPECT_EQ(toLabel(42), 42);
+    EXPECT_EQ(toLabel(static_cast<size_t>(LABEL_MAX)), LABEL_MAX);
+    EXPECT_THROW(toLabel(static_cast<size_t>(LABEL_MAX) + 1), std::overflow_error);
+    
+    // Tensor components are laid out per cell
+    Field tensor("stress", FieldType::TENSOR, 4);
+    EXPECT_EQ(&tensor(3, 8) - tensor.data.data(), 35);
+    EXPECT_EQ(tensor.getSize(), 4);
+}
+
+TEST(FieldTest, KernelsMatchScalarLoops) {
+    // Sizes cover SIMD tails and the OpenMP threshold
+    for (size_t n : {1u, 7u, 37u, 1000u, 70001u}) {
+        Field field("phi", FieldType::VECTOR, static_cast<label>(n));
+        Field other("psi", FieldType::VECTOR, static_cast<label>(n));
+        for (size_t i = 0; i < field.data.size(); ++i) {
+            field.data[i] = std::sin(0.37 * i) * 10.0 + (i % 3);
+            other.data[i] = std::cos(0.11 * i);
+        }
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(field.data.data()) % 64, 0u);
+        
+        std::vector<double> ref(field.data.begin(), field.data.end());
+        double refMin = ref[0], refMax = ref[0], refSum = 0.0;
+        double compMin[3] = {ref[0], ref[1], ref[2]};
+        double compMax[3] = {ref[0], ref[1], ref[2]};
+        for (size_t i = 0; i < ref.size(); ++i) {
+            refMin = std::min(refMin, ref[i]);
+            refMax = std::max(refMax, ref[i]);
+            refSum += ref[i];
+            compMin[i % 3] = std::min(compMin[i % 3], ref[i]);
+            compMax[i % 3] = std::max(compMax[i % 3], ref[i]);
+        }
+        EXPECT_DOUBLE_EQ(field.min(), refMin);
+        EXPECT_DOUBLE_EQ(field.max(), refMax);
+        EXPECT_NEAR(field.mean(), refSum / ref.size(), 1e-12);
+        for (int c = 0; c < 3; ++c) {
+            EXPECT_DOUBLE_EQ(field.minComponent(c), compMin[c]);
+            EXPECT_DOUBLE_EQ(field.maxComponent(c), compMax[c]);
+        }
+        
+        field.add(other);
+        field.scale(0.5);
+        field.subtract(other);
+        field.clampComponent(1, -1.0, 1.0);
+        for (size_t i = 0; i < ref.size(); ++i) {
+            double expected = (ref[i] + other.data[i]) * 0.5 - other.data[i];
+            if (i % 3 == 1) expected = std::max(-1.0, std::min(1.0, expected));
+            ASSERT_DOUBLE_EQ(field.data[i], expected) << "n=" << n << " i=" << i;
+        }
+        
+        field.fillComponent(2, 7.0);
+        field.clamp(-2.0, 2.0);
+        EXPECT_DOUBLE_EQ(field.maxComponent(2), 2.0);
+        EXPECT_LE(field.max(), 2.0);
+        EXPECT_GE(field.min(), -2.0);
+    }
+}
+
+TEST(FieldTest, FusedStatistics) {
+    Field field("Y", FieldType::SCALAR, 100003);
+    for (label i = 0; i < field.getSize(); ++i) {
+        field(i) = 0.001 * (i % 1000) - 0.2;
+    }
+    field(17) = std::nan("");
+    field(99999) = std::nan("");
+    field(50000) = std::numeric_limits<double>::infinity();
+    field(100002) = -5.0;
+    
+    FieldStatistics stats = field.computeStatistics();
+    EXPECT_EQ(stats.count, 100003u);
+    EXPECT_EQ(stats.numNaN, 2u);
+    EXPECT_EQ(stats.numInf, 1u);
+    EXPECT_FALSE(stats.isValid());
+    EXPECT_DOUBLE_EQ(stats.min, -5.0);
+    EXPECT_EQ(stats.max, std::numeric_limits<double>::infinity());
+    
+    field(50000) = 0.0;
+    stats = field.computeStatistics();
+    double expectedSum = 0.0;
+    for (double value : field.data) {
+        if (!std::isnan(value)) expectedSum += value;
+    }
+    EXPECT_NEAR(stats.sum, expectedSum, 1e-9);
+    EXPECT_NEAR(stats.mean(), expectedSum / 100001.0, 1e-12);
+    EXPECT_DOUBLE_EQ(stats.max, 0.799);
+}
+
+TEST(FieldManagerTest, ParallelValidation) {
+    FieldManager manager;
+    for (int s = 0; s < 60; ++s) {
+        manager.registerField("Y_" + std::to_string(s), FieldType::SCALAR, 5000);
+        manager.getField("Y_" + std::to_string(s)).fill(1.0 / 60);
+    }
+    manager.registerField("velocity", FieldType::VECTOR, 100000);
+    manager.getField("velocity").fill(2.0);
+    EXPECT_TRUE(manager.validateAll());
+    
+    manager.getField("Y_42")(4999) = std::nan("");
+    manager.getField("velocity")(99999, 2) = -std::numeric_limits<double>::infinity();
+    EXPECT_FALSE(manager.validateAll());
+    std::vector<std::string> invalid = manager.getInvalidFields();
+    ASSERT_EQ(invalid.size(), 2u);
+    EXPECT_EQ(invalid[0], "Y_42");
+    EXPECT_EQ(invalid[1], "velocity");
+    
+    auto stats = manager.computeStatistics();
+    EXPECT_EQ(stats.size(), 61u);
+    EXPECT_EQ(stats["velocity"].count, 300000u);
+    EXPECT_EQ(stats["velocity"].numInf, 1u);
+    EXPECT_EQ(stats["velocity"].sum, -std::numeric_limits<double>::infinity());
+    EXPECT_NEAR(stats["Y_0"].sum, 5000.0 / 60, 1e-12);
+    EXPECT_EQ(stats["Y_42"].numNaN, 1u);
+}
+
+TEST(FieldTest, ExpressionTemplates) {
+    const label n = 1001;
+    Field phi("phi", FieldType::SCALAR, n);
+    Field phiOld("phiOld", FieldType::SCALAR, n);
+    Field x("x", FieldType::SCALAR, n);
+    Field y("y", FieldType::SCALAR, n);
+    for (label i = 0; i < n; ++i) {
+        phiOld(i) = 1.0 + i;
+        x(i) = 0.5 * i;
+        y(i) = std::sqrt(static_cast<double>(i));
+    }
+    const double dt = 1e-3, a = 2.0, b = 3.0;
+    
+    phi = phiOld + dt * (a * x - b * y);
+    for (label i = 0; i < n; ++i) {
+        ASSERT_DOUBLE_EQ(phi(i), phiOld(i) + dt * (a * x(i) - b * y(i)));
+    }
+    
+    // The destination may appear on the right-hand side
+    phi = -phi / 2.0 + 1.0;
+    phi += x;
+    phi -= 2.0 * y;
+    for (label i = 0; i < n; ++i) {
+        double expected = -(phiOld(i) + dt * (a * x(i) - b * y(i))) / 2.0 + 1.0 + x(i) - 2.0 * y(i);
+        ASSERT_DOUBLE_EQ(phi(i), expected);
+    }
+    
+    // Vector fields: per-component arithmetic with scalar broadcast
+    Field U("U", FieldType::VECTOR, n);
+    Field momentum("rhoU", FieldType::VECTOR, n);
+    for (label i = 0; i < n; ++i) {
+        for (int c = 0; c < 3; ++c) U(i, c) = i + 0.1 * c;
+    }
+    momentum = x * U + 1.0;
+    for (label i = 0; i < n; ++i) {
+        for (int c = 0; c < 3; ++c) {
+            ASSERT_DOUBLE_EQ(momentum(i, c), x(i) * U(i, c) + 1.0);
+        }
+    }
+    
+    // Component access as operand and as target
+    phi = U.component(1) * 2.0 - y;
+    U.component(2) = U.component(0) + U.component(1);
+    U.component(0) = 5.0;
+    const Field& constU = U;
+    Field speed("speed", FieldType::SCALAR, n);
+    speed = constU.component(2) - constU.component(1);
+    for (label i = 0; i < n; ++i) {
+        ASSERT_DOUBLE_EQ(phi(i), (i + 0.1) * 2.0 - y(i));
+        ASSERT_DOUBLE_EQ(U(i, 2), (i + 0.0) + (i + 0.1));
+        ASSERT_DOUBLE_EQ(U(i, 0), 5.0);
+        ASSERT_DOUBLE_EQ(speed(i), i + 0.0);
+    }
+    
+    // Mismatched sizes and component counts are rejected
+    Field small("small", FieldType::SCALAR, 10);
+    EXPECT_THROW(phi = phi + small, std::runtime_error);
+    EXPECT_THROW(phi = U * 2.0, std::runtime_error);
+    EXPECT_THROW(U.component(0) = U + 1.0, std::runtime_error);
+}
+
+TEST(FieldTest, ExpressionAliasing) {
+    // A component view broadcast over its own field reads elements that
+    // the assignment overwrites; the result must match the unaliased one
+    const FieldPrecision precisions[] = {FieldPrecision::DOUBLE, FieldPrecision::FLOAT};
+    const FieldLayout layouts[] = {FieldLayout::INTERLEAVED, FieldLayout::BLOCKED};
+    for (FieldPrecision precision : precisions) {
+        for (FieldLayout layout : layouts) {
+            const label n = 5;
+            Field U("U", FieldType::VECTOR, n, precision, layout);
+            for (label c = 0; c < n; ++c) {
+                for (int comp = 0; comp < 3; ++comp) U.setValue(c, comp, 2.0 + comp + c);
+            }
+            U = U * U.component(0);
+            for (label c = 0; c < n; ++c) {
+                const double u0 = 2.0 + c;
+                for (int comp = 0; comp < 3; ++comp) {
+                    EXPECT_DOUBLE_EQ(U.value(c, comp), (2.0 + comp + c) * u0);
+                }
+            }
+            
+            U.fill(1.0);
+            U.component(1) = 3.0;
+            U += U.component(1);
+            for (label c = 0; c < n; ++c) {
+                EXPECT_DOUBLE_EQ(U.value(c, 0), 4.0);
+                EXPECT_DOUBLE_EQ(U.value(c, 1), 6.0);
+                EXPECT_DOUBLE_EQ(U.value(c, 2), 4.0);
+            }
+            
+            // Other components of the same field are separate elements
+            U.component(0) = U.component(1) * 2.0 + U.component(2);
+            for (label c = 0; c < n; ++c) {
+                EXPECT_DOUBLE_EQ(U.value(c, 0), 16.0);
+            }
+        }
+    }
+    
+    // The reported case: U = (2, 3, 4) scaled by its x component
+    Field U("U", FieldType::VECTOR, 1);
+    U(0, 0) = 2.0;
+    U(0, 1) = 3.0;
+    U(0, 2) = 4.0;
+    U = U * U.component(0);
+    EXPECT_DOUBLE_EQ(U(0, 0), 4.0);
+    EXPECT_DOUBLE_EQ(U(0, 1), 6.0);
+    EXPECT_DOUBLE_EQ(U(0, 2), 8.0);
+}
+
+TEST(FieldManagerTest, FieldHandles) {
+    FieldManager manager;
+    ScalarFieldId p = manager.registerScalarField("pressure", 10);
+    VectorFieldId U = manager.registerVectorField("velocity", 10);
+    FieldId T = manager.registerField("temperature", FieldType::SCALAR, 10);
+    EXPECT_TRUE(p.isValid());
+    EXPECT_NE(p, U);
+    EXPECT_FALSE(FieldId().isValid());
+    
+    // Handles and names address the same field
+    manager.getField(p)(3) = 101325.0;
+    EXPECT_DOUBLE_EQ(manager.getField("pressure")(3), 101325.0);
+    EXPECT_EQ(&manager.getField(U), &manager.getField("velocity"));
+    EXPECT_EQ(manager.getFieldId("temperature"), T);
+    EXPECT_EQ(manager.getScalarFieldId("pressure"), p);
+    EXPECT_EQ(manager.getVectorFieldId("velocity"), U);
+    
+    // Typed lookups check the field type
+    EXPECT_THROW(manager.getScalarFieldId("velocity"), std::invalid_argument);
+    EXPECT_THROW(manager.findOrRegisterVectorField("pressure", 10), std::invalid_argument);
+    EXPECT_THROW(manager.getFieldId("missing"), std::runtime_error);
+    
+    // Existing fields are found, re-registration keeps the id
+    EXPECT_EQ(manager.findOrRegisterScalarField("pressure", 10), p);
+    EXPECT_EQ(manager.registerScalarField("pressure", 20), p);
+    EXPECT_EQ(manager.getField(p).getSize(), 20);
+    
+    // Removed ids are invalid and not reused
+    manager.removeField("temperature");
+    EXPECT_FALSE(manager.hasField(T));
+    EXPECT_THROW(manager.getField(T), std::out_of_range);
+    FieldId k = manager.registerField("k", FieldType::SCALAR, 10);
+    EXPECT_NE(k, T);
+    EXPECT_EQ(manager.getNumFields(), 3);
+    EXPECT_EQ(manager.getFieldNames(), (std::vector<std::string>{"k", "pressure", "velocity"}));
+}
+
+TEST(FieldManagerTest, ArenaStorage) {
+    FieldManager manager;
+    FieldId a = manager.registerField("a", FieldType::SCALAR, 100);
+    FieldId b = manager.registerField("b", FieldType::VECTOR, 100);
+    FieldId c = manager.registerField("c", FieldType::SCALAR, 100);
+    manager.getField(a).fill(1.0);
+    manager.getField(b).fill(2.0);
+    manager.getField(c).fill(3.0);
+    
+    manager.enableArena();
+    ASSERT_TRUE(manager.isArenaEnabled());
+    FieldMemoryUsage usage;
+    size_t bytes = manager.getTotalMemoryUsage(&usage);
+    EXPECT_EQ(bytes, (100 + 300 + 100) * sizeof(double));
+    EXPECT_TRUE(usage.arenaEnabled);
+    EXPECT_EQ(usage.arenaChunks, 1);
+    EXPECT_EQ(usage.arenaUsedBytes, usage.arenaCapacity);
+    EXPECT_DOUBLE_EQ(usage.arenaFragmentation, 0.0);
+    
+    // Values survive the move; slabs are aligned and packed back to back
+    EXPECT_DOUBLE_EQ(manager.getField(b).min(), 2.0);
+    const double* pa = manager.getField(a).data.data();
+    const double* pb = manager.getField(b).data.data();
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(pa) % SIMD_ALIGNMENT, 0u);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(pb) % SIMD_ALIGNMENT, 0u);
+    EXPECT_EQ(static_cast<size_t>(pb - pa), 104u);  // 100 doubles rounded to 64-byte slabs
+    
+    // Resize rebuilds the arena in one allocation, keeping leading values
+    manager.resize(200);
+    manager.getTotalMemoryUsage(&usage);
+    EXPECT_EQ(usage.arenaChunks, 1);
+    EXPECT_EQ(manager.getField(c).getSize(), 200);
+    EXPECT_DOUBLE_EQ(manager.getField(c)(99), 3.0);
+    EXPECT_DOUBLE_EQ(manager.getField(c)(150), 0.0);
+    
+    // Removing two separated fields leaves two gaps; compaction closes them
+    manager.registerField("d", FieldType::VECTOR, 200);
+    manager.removeField("a");
+    manager.removeField("c");
+    manager.getTotalMemoryUsage(&usage);
+    EXPECT_EQ(usage.arenaChunks, 2);  // "d" did not fit and grew the arena
+    EXPECT_GT(usage.arenaFragmentation, 0.0);
+    
+    manager.compactArena();
+    manager.getTotalMemoryUsage(&usage);
+    EXPECT_EQ(usage.arenaChunks, 1);
+    EXPECT_DOUBLE_EQ(usage.arenaFragmentation, 0.0);
+    EXPECT_DOUBLE_EQ(manager.getField(b)(199, 2), 0.0);
+    EXPECT_DOUBLE_EQ(manager.getField(b)(0, 2), 2.0);
+    EXPECT_GE(usage.peakBytes, (200 * 5 + 600) * sizeof(double));
+    
+    // Copies of an arena field use the heap
+    Field copy(manager.getField(b));
+    EXPECT_EQ(copy.data.get_allocator().getArena(), nullptr);
+}
+
+TEST(FieldManagerTest, ScratchPool) {
+    FieldManager manager;
+    manager.registerField("p", FieldType::SCALAR, 50);
+    manager.enableArena();
+    
+    const double* first;
+    {
+        ScratchField tmp = manager.checkoutScratch(FieldType::VECTOR);
+        EXPECT_EQ(tmp->getSize(), 50);
+        EXPECT_EQ(tmp->getNumComponents(), 3);
+        tmp->fill(1.0);
+        first = tmp->data.data();
+        EXPECT_EQ(manager.getNumScratchInUse(), 1);
+        EXPECT_THROW(manager.resize(60), std::logic_error);
+    }
+    EXPECT_EQ(manager.getNumScratchInUse(), 0);
+    
+    // Returned fields are reused; a second concurrent checkout adds one
+    ScratchField t1 = manager.checkoutScratch(FieldType::VECTOR);
+    ScratchField t2 = manager.checkoutScratch(FieldType::VECTOR);
+    EXPECT_EQ(t1->data.data(), first);
+    EXPECT_NE(t2->data.data(), first);
+    EXPECT_EQ(manager.getNumScratchFields(), 2);
+    
+    FieldMemoryUsage usage;
+    manager.getTotalMemoryUsage(&usage);
+    EXPECT_EQ(usage.scratchBytes, 2 * 150 * sizeof(double));
+    
+    t1.release();
+    ScratchField moved = std::move(t2);
+    EXPECT_FALSE(t2.isValid());
+    moved.release();
+    EXPECT_EQ(manager.getNumScratchInUse(), 0);
+    
+    // Idle scratch fields follow a resize
+    manager.resize(80);
+    ScratchField t3 = manager.checkoutScratch(FieldType::VECTOR);
+    EXPECT_EQ(t3->getSize(), 80);
+    EXPECT_EQ(manager.getNumScratchFields(), 2);
+}
+
+TEST(FieldManagerTest, TimeLevels) {
+    FieldManager manager;
+    FieldId T = manager.registerScalarField("T", 100);
+    manager.getField(T).fill(1.0);
+    manager.setNumOldTimeLevels(T, 2);
+    EXPECT_EQ(manager.getNumOldTimeLevels(T), 2);
+    EXPECT_EQ(manager.getOldField(T, 2).name, "T_0_0");
+    EXPECT_DOUBLE_EQ(manager.getOldField(T, 2).max(), 1.0);
+    EXPECT_THROW(manager.getOldField(T, 3), std::out_of_range);
+    
+    FieldMemoryUsage usage;
+    manager.getTotalMemoryUsage(&usage);
+    EXPECT_EQ(usage.oldTimeBytes, 2 * 100 * sizeof(double));
+    EXPECT_EQ(usage.fieldBytes, 3 * 100 * sizeof(double));
+    
+    // Each step writes the current field in full; rotation only swaps buffers
+    const Field& T0 = manager.getOldField(T, 1);
+    const Field& T00 = manager.getOldField(T, 2);
+    std::vector<const double*> buffers = {manager.getField(T).data.data(), T0.data.data(), T00.data.data()};
+    for (int step = 2; step <= 4; ++step) {
+        manager.advanceTimeLevels();
+        manager.getField(T) = 1.0 * T0 + 1.0;
+    }
+    EXPECT_DOUBLE_EQ(manager.getField(T).max(), 4.0);
+    EXPECT_DOUBLE_EQ(T0.max(), 3.0);
+    EXPECT_DOUBLE_EQ(T00.max(), 2.0);
+    
+    // Three rotations bring every buffer back to its starting level
+    EXPECT_EQ(manager.getField(T).data.data(), buffers[0]);
+    EXPECT_EQ(T0.data.data(), buffers[1]);
+    EXPECT_EQ(T00.data.data(), buffers[2]);
+    
+    // Old levels follow resize and the arena
+    manager.enableArena();
+    manager.resize(120);
+    EXPECT_EQ(T00.getSize(), 120);
+    EXPECT_EQ(T00.data.get_allocator().getArena(), manager.getField(T).data.get_allocator().getArena());
+    EXPECT_DOUBLE_EQ(T00.value(99), 2.0);
+    
+    manager.setNumOldTimeLevels(T, 0);
+    EXPECT_EQ(manager.getNumOldTimeLevels(T), 0);
+}
+
+TEST(FieldTest, ReproducibleSums) {
+    // Large enough to run in parallel; values spread over many magnitudes
+    const label n = 300001;
+    Field phi("phi", FieldType::VECTOR, n);
+    std::vector<double> volume(n);
+    for (label i = 0; i < n; ++i) {
+        for (int c = 0; c < 3; ++c) {
+            phi(i, c) = std::sin(0.37 * i + c) * std::pow(10.0, (i * 7 + c) % 13 - 6);
+        }
+        volume[i] = 1.0 + 1e-3 * (i % 17);
+    }
+    
+    const int maxThreads = omp_get_max_threads();
+    omp_set_num_threads(1);
+    const double sum1 = phi.sum();
+    const double weighted1 = phi.weightedSum(volume.data(), 2);
+    for (int threads : {2, 3, 4, 7}) {
+        omp_set_num_threads(threads);
+        EXPECT_EQ(phi.sum(), sum1);
+        EXPECT_EQ(phi.weightedSum(volume.data(), 2), weighted1);
+    }
+    omp_set_num_threads(maxThreads);
+    
+    // The sum is independent of layout and correctly rounded to within a
+    // few ulps of a long double reference
+    long double reference = 0.0L;
+    for (double value : phi.data) reference += value;
+    EXPECT_NEAR(sum1, static_cast<double>(reference), 1e-15 * std::fabs(sum1) + 1e-12);
+    phi.setLayout(FieldLayout::BLOCKED);
+    EXPECT_EQ(phi.weightedSum(volume.data(), 2), weighted1);
+    
+    // Compensation recovers small terms swamped by a large one
+    Field x("x", FieldType::SCALAR, 10002);
+    x.fill(1.0);
+    x(0) = 1e16;
+    x(10001) = -1e16;
+    EXPECT_DOUBLE_EQ(x.sum(), 10000.0);
+    EXPECT_DOUBLE_EQ(x.mean(), 10000.0 / 10002.0);
+}
+
+TEST(FieldTest, FloatPrecision) {
+    const label n = 1000;
+    Field Y("Y", FieldType::SCALAR, n, FieldPrecision::FLOAT);
+    Field d("d", FieldType::SCALAR, n);
+    EXPECT_TRUE(Y.isFloat());
+    EXPECT_TRUE(Y.data.empty());
+    EXPECT_EQ(Y.getSize(), n);
+    EXPECT_EQ(Y.getBytes(), n * sizeof(float));
+    
+    for (label i = 0; i < n; ++i) {
+        Y.setValue(i, 0, 0.001 * i);
+        d(i) = 1.0;
+    }
+    EXPECT_FLOAT_EQ(Y.value(500), 0.5f);
+    EXPECT_DOUBLE_EQ(Y.min(), 0.0);
+    EXPECT_DOUBLE_EQ(Y.max(), static_cast<double>(0.999f));
+    
+    // Mixed-precision arithmetic and expressions compute in double
+    Y.add(d);
+    EXPECT_FLOAT_EQ(Y.value(0), 1.0f);
+    Y = 2.0 * Y - d;
+    EXPECT_FLOAT_EQ(Y.value(250), 1.5f);
+    d = d + Y;
+    EXPECT_DOUBLE_EQ(d(250), 1.0 + static_cast<double>(1.5f));
+    
+    Y.clamp(1.0, 2.0);
+    FieldStatistics stats = Y.computeStatistics();
+    EXPECT_EQ(stats.count, static_cast<size_t>(n));
+    EXPECT_DOUBLE_EQ(stats.min, 1.0);
+    EXPECT_DOUBLE_EQ(stats.max, 2.0);
+    Y.setValue(7, 0, std::numeric_limits<double>::quiet_NaN());
+    EXPECT_TRUE(Y.hasNaN());
+    
+    // Reference access needs double storage, in every build type
+    EXPECT_THROW(Y(0), std::logic_error);
+    EXPECT_THROW(static_cast<const Field&>(Y)(0), std::logic_error);
+    
+    Field U("U", FieldType::VECTOR, 4, FieldPrecision::FLOAT);
+    U.fillComponent(1, 3.0);
+    U.component(2) = U.component(1) * 2.0;
+    EXPECT_DOUBLE_EQ(U.minComponent(2), 6.0);
+    EXPECT_DOUBLE_EQ(U.maxComponent(0), 0.0);
+    U.setValue(0, 1, 9.0);
+    U.permute({3, 2, 1, 0});
+    EXPECT_DOUBLE_EQ(U.value(3, 1), 9.0);
+    U.resize(6);
+    EXPECT_EQ(U.floatData.size(), 18u);
+    
+    // Float fields move into and resize within the arena like double ones
+    FieldManager manager;
+    FieldId kId = manager.registerScalarField("k", 100, FieldPrecision::FLOAT);
+    manager.registerVectorField("velocity", 100);
+    manager.getField(kId).fill(0.25);
+    manager.enableArena();
+    manager.resize(150);
+    EXPECT_TRUE(manager.getField(kId).data.empty());
+    EXPECT_DOUBLE_EQ(manager.getField(kId).value(99), 0.25);
+    EXPECT_DOUBLE_EQ(manager.getField(kId).value(149), 0.0);
+    EXPECT_EQ(manager.getTotalMemoryUsage(), 150 * sizeof(float) + 450 * sizeof(double));
+    EXPECT_DOUBLE_EQ(manager.computeStatistics().at("k").max, 0.25);
+}
+
+TEST(FieldTest, BlockedLayout) {
+    const label n = 300;
+    Field A("A", FieldType::VECTOR, n);  // Interleaved reference
+    Field B("B", FieldType::VECTOR, n, FieldPrecision::DOUBLE, FieldLayout::BLOCKED);
+    EXPECT_TRUE(B.isBlocked());
+    EXPECT_EQ(B.index(5, 2), static_cast<size_t>(2 * n + 5));
+    EXPECT_EQ(A.index(5, 2), 17u);
+    for (label i = 0; i < n; ++i) {
+        for (int c = 0; c < 3; ++c) {
+            double v = std::sin(0.1 * i + c);
+            A(i, c) = v;
+            B(i, c) = v;
+        }
+    }
+    EXPECT_DOUBLE_EQ(B.data[n + 7], A(7, 1));
+    
+    for (int c = 0; c < 3; ++c) {
+        EXPECT_DOUBLE_EQ(B.minComponent(c), A.minComponent(c));
+        EXPECT_DOUBLE_EQ(B.maxComponent(c), A.maxComponent(c));
+    }
+    A.clampComponent(1, -0.5, 0.5);
+    B.clampComponent(1, -0.5, 0.5);
+    A.fillComponent(0, 2.0);
+    B.fillComponent(0, 2.0);
+    
+    // Expressions over mixed layouts, with scalar broadcast
+    Field rho("rho", FieldType::SCALAR, n);
+    rho.fill(0.5);
+    Field C("C", FieldType::VECTOR, n, FieldPrecision::DOUBLE, FieldLayout::BLOCKED);
+    C = 2.0 * A + rho * B;
+    B.component(2) = B.component(2) - rho;
+    A.component(2) -= 1.0 * rho;
+    for (label i = 0; i < n; ++i) {
+        for (int c = 0; c < 3; ++c) {
+            EXPECT_DOUBLE_EQ(B(i, c), A(i, c));
+            EXPECT_NEAR(C(i, c), 2.5 * A(i, c) + (c == 2 ? 1.25 : 0.0), 1e-12);
+        }
+    }
+    
+    // add/subtract across layouts go through the expression path
+    C.subtract(A);
+    C.add(B);
+    C.scale(0.4);
+    EXPECT_NEAR(C(10, 1), A(10, 1), 1e-12);  // (2.5A - A + B) * 0.4 with B == A
+    
+    // Layout conversion, permutation and resizing keep values by position
+    Field D(B);
+    D.setLayout(FieldLayout::INTERLEAVED);
+    EXPECT_FALSE(D.isBlocked());
+    EXPECT_DOUBLE_EQ(D.data[3 * 4 + 1], B(4, 1));
+    D.setLayout(FieldLayout::BLOCKED);
+    EXPECT_EQ(D.data, B.data);
+    
+    std::vector<label> reverse(n);
+    for (label i = 0; i < n; ++i) reverse[i] = n - 1 - i;
+    B.permute(reverse);
+    EXPECT_DOUBLE_EQ(B(0, 1), A(n - 1, 1));
+    B.resize(n + 10);
+    EXPECT_EQ(B.getComponentStride(), static_cast<size_t>(n + 10));
+    EXPECT_DOUBLE_EQ(B(0, 2), A(n - 1, 2));
+    EXPECT_DOUBLE_EQ(B(n + 5, 2), 0.0);
+    B.resize(5);
+    EXPECT_DOUBLE_EQ(B(4, 1), A(n - 5, 1));
+    
+    // Blocked fields in the arena and as scratch
+    FieldManager manager;
+    VectorFieldId uId = manager.registerVectorField("U", 50, FieldPrecision::FLOAT, FieldLayout::BLOCKED);
+    manager.getField(uId).fillComponent(1, 3.0);
+    manager.enableArena();
+    manager.resize(80);
+    EXPECT_DOUBLE_EQ(manager.getField(uId).value(49, 1), 3.0);
+    EXPECT_DOUBLE_EQ(manager.getField(uId).value(79, 1), 0.0);
+    EXPECT_DOUBLE_EQ(manager.getField(uId).value(49, 0), 0.0);
+    ScratchField tmp = manager.checkoutScratch(FieldType::VECTOR, FieldLayout::BLOCKED);
+    EXPECT_TRUE(tmp->isBlocked());
+    *tmp = manager.getField(uId) * 2.0;
+    EXPECT_DOUBLE_EQ(tmp->maxComponent(1), 6.0);
+}
+
+TEST(FieldTest, MixedPrecisionConservation) {
+    // Explicit finite-volume diffusion of a species blob, stored once as
+    // double and once as float. Face fluxes cancel pairwise, so the total
+    // mass sum(V * Y) is conserved up to the storage rounding.
+    Mesh mesh = MeshGenerator::createBoxMesh(8, 8, 8, Vector3D(0, 0, 0), Vector3D(1, 1, 1));
+    const MeshGeometry& g = mesh.geometry;
+    const label numCells = mesh.getNumCells();
+    
+    FieldManager fields;
+    FieldId yDouble = fields.registerScalarField("Y_double", numCells);
+    FieldId yFloat = fields.registerScalarField("Y_float", numCells, FieldPrecision::FLOAT);
+    for (label c = 0; c < numCells; ++c) {
+        double r2 = (g.cellCentroidX[c] - 0.3) * (g.cellCentroidX[c] - 0.3) +
+                    (g.cellCentroidY[c] - 0.5) * (g.cellCentroidY[c] - 0.5) +
+                    (g.cellCentroidZ[c] - 0.6) * (g.cellCentroidZ[c] - 0.6);
+        fields.getField(yDouble)(c) = 0.2 * std::exp(-r2 / 0.02);
+        fields.getField(yFloat).setValue(c, 0, fields.getField(yDouble)(c));
+    }
+    
+    auto totalMass = [&](const Field& Y) { return volumeIntegral(mesh, Y); };
+    const double mass0Double = totalMass(fields.getField(yDouble));
+    const double mass0Float = totalMass(fields.getField(yFloat));
+    
+    const double D = 1e-3, dt = 0.05;
+    for (int step = 0; step < 100; ++step) {
+        for (FieldId id : {yDouble, yFloat}) {
+            Field& Y = fields.getField(id);
+            ScratchField change = fields.checkoutScratch(FieldType::SCALAR);
+            change->fill(0.0);
+            for (label f = 0; f < mesh.getNumFaces(); ++f) {
+                const Face& face = mesh.faces[f];
+                if (face.isBoundary()) continue;
+                double flux = D * face.area * g.faceDeltaCoeff[f] *
+                              (Y.value(face.neighborCell) - Y.value(face.ownerCell));
+                (*change)(face.ownerCell) += flux;
+                (*change)(face.neighborCell) -= flux;
+            }
+            for (label c = 0; c < numCells; ++c) {
+                (*change)(c) *= dt / g.cellVolume[c];
+            }
+            Y += *change;
+        }
+    }
+    
+    const Field& Yd = fields.getField(yDouble);
+    const Field& Yf = fields.getField(yFloat);
+    EXPECT_NEAR(totalMass(Yd), mass0Double, 1e-12 * mass0Double);
+    EXPECT_NEAR(totalMass(Yf), mass0Float, 1e-5 * mass0Float);
+    EXPECT_LT(Yd.max(), 0.2 * 0.9);  // The blob did spread
+    for (label c = 0; c < numCells; ++c) {
+        EXPECT_NEAR(Yf.value(c), Yd(c), 1e-6);
+    }
+    EXPECT_EQ(fields.getNumScratchFields(), 1);
+    
+    FieldMemoryUsage usage;
+    fields.getTotalMemoryUsage(&usage);
+    EXPECT_EQ(usage.numFloatFields, 1);
+    EXPECT_EQ(usage.floatSavedBytes, static_cast<size_t>(numCells) * sizeof(float));
+}
@@ -1,5 +1,19 @@
 #include <gtest/gtest.h>
 #include "core/Mesh.h"
+#include "mesh/MeshGenerator.h"
+#include "mesh/MeshRenumbering.h"
+#include "core/FieldManager.h"
+#include "core/FieldIntegrals.h"
+#include "io/MeshFile.h"
+#include "mesh/MeshSpatialIndex.h"
+#include "combustion/CombustionModel.h"
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
 
 using namespace cfd;
 
@@ -32,7 +46,7 @@ TEST(MeshTest, AddFaces) {
     mesh.addNode(Vector3D(1, 1, 0));
     mesh.addNode(Vector3D(0, 1, 0));
     
-    std::vector<int> nodeIds = {0, 1, 2, 3};
+    std::vector<label> nodeIds = {0, 1, 2, 3};
     int faceId = mesh.addFace(nodeIds, 0, -1);
     
     EXPECT_EQ(mesh.getNumFaces(), 1);
@@ -48,7 +62,7 @@ TEST(MeshTest, FaceGeometry) {
     mesh.addNode(Vector3D(1, 1, 0));
     mesh.addNode(Vector3D(0, 1, 0));
     
-    std::vector<int> nodeIds = {0, 1, 2, 3};
+    std::vector<label> nodeIds = {0, 1, 2, 3};
     int faceId = mesh.addFace(nodeIds, 0, -1);
     
     mesh.computeFaceGeometry(faceId);
@@ -89,6 +103,12 @@ TEST(MeshTest, Connectivity) {
     int cell0 = mesh.addCell({face0, face2});
     int cell1 = mesh.addCell({face1, face2});
     
+    // Queries before the tables are built return nothing rather than
+    // reading past them
+    EXPECT_TRUE(mesh.getCellNeighbors(cell1).empty());
+    EXPECT_TRUE(mesh.getNodeCells(5).empty());
+    EXPECT_EQ(mesh.getCellFaces(cell0).size(), 2u);
+    
     mesh.buildConnectivity();
     
     EXPECT_EQ(mesh.getNumCells(), 2);
@@ -108,9 +128,586 @@ TEST(MeshTest, Validation) {
     mesh.addNode(Vector3D(1, 0, 0));
     mesh.addNode(Vector3D(0, 1, 0));
     
-    std::vector<int> nodeIds = {0, 1, 2};
+    std::vector<label> nodeIds = {0, 1, 2};
     mesh.addFace(nodeIds, 0, -1);
     mesh.addCell({0});
     
     EXPECT_TRUE(mesh.validate());
 }
+
+TEST(MeshTest, CSRConnectivity) {
+    Mesh mesh;
+    
+    // Two unit quads sharing the edge 1-4
+    mesh.addNode(Vector3D(0, 0, 0));
+    mesh.addNode(Vector3D(1, 0, 0));
+    mesh.addNode(Vector3D(2, 0, 0));
+    mesh.addNode(Vector3D(0, 1, 0));
+    mesh.addNode(Vector3D(1, 1, 0));
+    mesh.addNode(Vector3D(2, 1, 0));
+    
+    int face0 = mesh.addFace({0, 1, 4, 3}, 0, -1);
+    int face1 = mesh.addFace({1, 2, 5, 4}, 1, -1);
+    int face2 = mesh.addFace({1, 4}, 0, 1);
+    
+    mesh.addCell({face0, face2});
+    mesh.addCell({face1, face2});
+    mesh.buildConnectivity();
+    
+    // Face -> node and cell -> face rows are packed in insertion order
+    EXPECT_EQ(mesh.faceNodes.getNumRows(), 3);
+    EXPECT_EQ(mesh.faceNodes.getNumEntries(), 10);
+    EXPECT_EQ(mesh.faceNodes.getRowSize(face1), 4);
+    EXPECT_EQ(mesh.faceNodes.row(face1)[1], 2);
+    EXPECT_EQ(mesh.cellFaces.row(1)[0], face1);
+    EXPECT_EQ(mesh.cellFaces.row(1)[1], face2);
+    
+    // Cell -> cell
+    ASSERT_EQ(mesh.cellNeighbors.getRowSize(0), 1);
+    EXPECT_EQ(mesh.cellNeighbors.row(0)[0], 1);
+    EXPECT_EQ(mesh.cellNeighbors.row(1)[0], 0);
+    
+    // Node -> cell: shared nodes list both cells exactly once
+    EXPECT_EQ(mesh.nodeCells.getRowSize(0), 1);
+    EXPECT_EQ(mesh.nodeCells.getRowSize(1), 2);
+    EXPECT_EQ(mesh.nodeCells.getRowSize(4), 2);
+    EXPECT_EQ(mesh.getNodeCells(4), (std::vector<label>{0, 1}));
+    EXPECT_EQ(mesh.getCellFaces(0), (std::vector<label>{face0, face2}));
+}
+
+TEST(MeshTest, SoAGeometry) {
+    Mesh mesh;
+    mesh.addNode(Vector3D(0, 0, 0));
+    mesh.addNode(Vector3D(2, 0, 0));
+    mesh.addNode(Vector3D(2, 2, 0));
+    mesh.addNode(Vector3D(0, 2, 0));
+    
+    int faceId = mesh.addFace({0, 1, 2, 3}, 0, -1);
+    mesh.addCell({faceId});
+    mesh.computeAllGeometry();
+    
+    const MeshGeometry& geom = mesh.geometry;
+    ASSERT_EQ(geom.getNumFaces(), 1);
+    ASSERT_EQ(geom.getNumCells(), 1);
+    
+    // Area vector = unit normal * area
+    EXPECT_NEAR(geom.faceAreaZ[0], 4.0, 1e-12);
+    EXPECT_NEAR(geom.faceAreaX[0], 0.0, 1e-12);
+    EXPECT_NEAR(geom.faceCentroidX[0], 1.0, 1e-12);
+    EXPECT_NEAR(geom.cellCentroidY[0], mesh.getCell(0).centroid.y, 1e-12);
+    
+    // Arrays are 64-byte aligned
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(geom.faceAreaX.data()) % SIMD_ALIGNMENT, 0u);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(geom.cellVolume.data()) % SIMD_ALIGNMENT, 0u);
+}
+
+TEST(MeshTest, BoxMeshGeometry) {
+    Mesh mesh = MeshGenerator::createBoxMesh(4, 3, 2, Vector3D(0, 0, 0), Vector3D(4, 6, 1));
+    
+    EXPECT_EQ(mesh.getNumCells(), 24);
+    EXPECT_EQ(mesh.getNumNodes(), 5 * 4 * 3);
+    EXPECT_EQ(mesh.getNumBoundaryFaces(), 2 * (3 * 2 + 4 * 2 + 4 * 3));
+    EXPECT_TRUE(mesh.validate());
+    
+    // Every hex is 1 x 2 x 0.5, including cells with faces they do not own
+    for (int c = 0; c < mesh.getNumCells(); ++c) {
+        EXPECT_NEAR(mesh.getCell(c).volume, 1.0, 1e-12);
+        EXPECT_NEAR(mesh.geometry.cellInvVolume[c], 1.0, 1e-12);
+    }
+    EXPECT_NEAR(mesh.getCell(0).centroid.x, 0.5, 1e-12);
+    EXPECT_NEAR(mesh.getCell(0).centroid.y, 1.0, 1e-12);
+    EXPECT_NEAR(mesh.getCell(0).centroid.z, 0.25, 1e-12);
+    
+    // Node -> cell: corner node touches 1 cell, interior node 8, sorted
+    EXPECT_EQ(mesh.nodeCells.getRowSize(0), 1);
+    int interior = 1 + 5 * (1 + 4 * 1);
+    ASSERT_EQ(mesh.nodeCells.getRowSize(interior), 8);
+    Span<const label> row = mesh.nodeCells.row(interior);
+    EXPECT_TRUE(std::is_sorted(row.begin(), row.end()));
+    
+    EXPECT_EQ(mesh.boundaries["xmin"].faceIds.size(), 6u);
+    EXPECT_EQ(mesh.cellNeighbors.getRowSize(0), 3);
+}
+
+namespace {
+
+// Box mesh with cells, faces and nodes shuffled into a poor ordering
+Mesh createScrambledBox(int n) {
+    Mesh mesh = MeshGenerator::createBoxMesh(n, n, n, Vector3D(0, 0, 0), Vector3D(1, 1, 1));
+    std::mt19937 rng(42);
+    std::vector<label> cells(mesh.getNumCells()), faces(mesh.getNumFaces()), nodes(mesh.getNumNodes());
+    std::iota(cells.begin(), cells.end(), 0);
+    std::iota(faces.begin(), faces.end(), 0);
+    std::iota(nodes.begin(), nodes.end(), 0);
+    std::shuffle(cells.begin(), cells.end(), rng);
+    std::shuffle(faces.begin(), faces.end(), rng);
+    std::shuffle(nodes.begin(), nodes.end(), rng);
+    mesh.permute(cells, faces, nodes);
+    return mesh;
+}
+
+} // namespace
+
+TEST(MeshTest, PermutePreservesGeometry) {
+    Mesh mesh = createScrambledBox(4);
+    
+    EXPECT_TRUE(mesh.validate());
+    for (int c = 0; c < mesh.getNumCells(); ++c) {
+        EXPECT_NEAR(mesh.getCell(c).volume, 1.0 / 64.0, 1e-12);
+    }
+    for (const auto& face : mesh.faces) {
+        if (!face.isBoundary()) {
+            EXPECT_LT(face.ownerCell, face.neighborCell);
+        }
+    }
+    
+    // Recomputing geometry from the permuted topology reproduces the
+    // permuted values, so flipped faces kept a consistent orientation
+    Mesh recomputed = mesh;
+    recomputed.computeAllGeometry();
+    for (int f = 0; f < mesh.getNumFaces(); ++f) {
+        EXPECT_NEAR(recomputed.geometry.faceAreaX[f], mesh.geometry.faceAreaX[f], 1e-12);
+        EXPECT_NEAR(recomputed.geometry.faceAreaY[f], mesh.geometry.faceAreaY[f], 1e-12);
+        EXPECT_NEAR(recomputed.geometry.faceAreaZ[f], mesh.geometry.faceAreaZ[f], 1e-12);
+    }
+    
+    size_t patchFaces = 0;
+    for (const auto& pair : mesh.boundaries) {
+        for (int faceId : pair.second.faceIds) {
+            EXPECT_TRUE(mesh.getFace(faceId).isBoundary());
+        }
+        patchFaces += pair.second.faceIds.size();
+    }
+    EXPECT_EQ(static_cast<int>(patchFaces), mesh.getNumBoundaryFaces());
+}
+
+TEST(MeshTest, RenumberingReducesBandwidth) {
+    const RenumberingMethod methods[] = {RenumberingMethod::REVERSE_CUTHILL_MCKEE,
+                                         RenumberingMethod::MORTON,
+                                         RenumberingMethod::HILBERT};
+    for (RenumberingMethod method : methods) {
+        Mesh mesh = createScrambledBox(8);
+        
+        // Field tagged with each cell's centroid must follow its cell
+        FieldManager fields;
+        fields.registerField("x", FieldType::SCALAR, mesh.getNumCells());
+        for (int c = 0; c < mesh.getNumCells(); ++c) {
+            fields.getField("x")(c) = mesh.getCell(c).centroid.x;
+        }
+        
+        const Field& x = fields.getField("x");
+        std::vector<double> xBefore(x.data.begin(), x.data.end());
+        RenumberingReport report = MeshRenumbering(method).renumber(mesh, &fields);
+        
+        // The reported order maps each new cell back to its old id
+        ASSERT_EQ(static_cast<int>(report.cellNewToOld.size()), mesh.getNumCells());
+        for (int c = 0; c < mesh.getNumCells(); ++c) {
+            EXPECT_DOUBLE_EQ(xBefore[report.cellNewToOld[c]], mesh.getCell(c).centroid.x);
+        }
+        
+        EXPECT_GT(report.bandwidthBefore, mesh.getNumCells() / 2);
+        if (method == RenumberingMethod::REVERSE_CUTHILL_MCKEE) {
+            // RCM targets the bandwidth itself; curves only bound the mean
+            EXPECT_LT(report.bandwidthAfter, report.bandwidthBefore / 4);
+        }
+        EXPECT_LT(report.meanDistanceAfter, report.meanDistanceBefore / 4);
+        EXPECT_TRUE(mesh.validate()) << MeshRenumbering::generateReport(report);
+        for (int c = 0; c < mesh.getNumCells(); ++c) {
+            EXPECT_DOUBLE_EQ(fields.getField("x")(c), mesh.getCell(c).centroid.x);
+        }
+    }
+}
+
+TEST(MeshTest, HilbertCurveIsContinuous) {
+    // Walking a 4x4x4 grid in Hilbert order moves one step at a time
+    std::vector<std::pair<uint64_t, std::array<int, 3>>> points;
+    for (int x = 0; x < 4; ++x) {
+        for (int y = 0; y < 4; ++y) {
+            for (int z = 0; z < 4; ++z) {
+                points.push_back({MeshRenumbering::hilbertKey(x, y, z), {x, y, z}});
+            }
+        }
+    }
+    std::sort(points.begin(), points.end());
+    EXPECT_EQ(points.back().first, 63u);
+    for (size_t i = 1; i < points.size(); ++i) {
+        int dist = 0;
+        for (int d = 0; d < 3; ++d) {
+            dist += std::abs(points[i].second[d] - points[i - 1].second[d]);
+        }
+        EXPECT_EQ(dist, 1);
+    }
+    
+    EXPECT_EQ(MeshRenumbering::mortonKey(1, 0, 0), 4u);
+    EXPECT_EQ(MeshRenumbering::mortonKey(1, 1, 1), 7u);
+}
+
+TEST(MeshTest, OrderedFaces) {
+    Mesh mesh = createScrambledBox(3);
+    EXPECT_FALSE(mesh.hasOrderedFaces());
+    
+    int numBoundary = mesh.getNumBoundaryFaces();
+    mesh.orderFaces();
+    ASSERT_TRUE(mesh.hasOrderedFaces());
+    EXPECT_EQ(mesh.getNumBoundaryFaces(), numBoundary);
+    EXPECT_EQ(mesh.getNumInternalFaces(), 3 * 2 * 9);
+    
+    // Internal prefix, sorted by (owner, neighbor)
+    for (int f = 0; f < mesh.getNumInternalFaces(); ++f) {
+        EXPECT_FALSE(mesh.getFace(f).isBoundary());
+        if (f > 0) {
+            const Face& prev = mesh.getFace(f - 1);
+            const Face& face = mesh.getFace(f);
+            EXPECT_TRUE(prev.ownerCell < face.ownerCell ||
+                        (prev.ownerCell == face.ownerCell && prev.neighborCell < face.neighborCell));
+        }
+    }
+    
+    // Patches tile the boundary range without gaps
+    int next = mesh.getNumInternalFaces();
+    for (const auto& pair : mesh.boundaries) {
+        const BoundaryPatch& patch = pair.second;
+        EXPECT_EQ(patch.startFace, next);
+        EXPECT_EQ(patch.numFaces, 9);
+        for (int f = patch.startFace; f < patch.startFace + patch.numFaces; ++f) {
+            EXPECT_TRUE(mesh.getFace(f).isBoundary());
+        }
+        next += patch.numFaces;
+    }
+    EXPECT_EQ(next, mesh.getNumFaces());
+    
+    // Adding a face drops back to the scanning path
+    mesh.addFace({0, 1, 2}, 0, -1);
+    EXPECT_FALSE(mesh.hasOrderedFaces());
+    EXPECT_EQ(mesh.getNumBoundaryFaces(), numBoundary + 1);
+}
+
+TEST(MeshTest, ConnectivityViews) {
+    Mesh mesh = MeshGenerator::createBoxMesh(3, 3, 3, Vector3D(0, 0, 0), Vector3D(1, 1, 1));
+    
+    for (int c = 0; c < mesh.getNumCells(); ++c) {
+        Span<const label> neighbors = mesh.getCellNeighborsView(c);
+        EXPECT_EQ(std::vector<label>(neighbors.begin(), neighbors.end()), mesh.getCellNeighbors(c));
+        
+        Span<const label> faces = mesh.getCellFacesView(c);
+        EXPECT_EQ(faces.size(), 6u);
+        EXPECT_EQ(std::vector<label>(faces.begin(), faces.end()), mesh.getCellFaces(c));
+    }
+    
+    // Views alias the CSR storage rather than copying it
+    Span<const label> nodeCells = mesh.getNodeCellsView(5);
+    EXPECT_EQ(nodeCells.data(), mesh.nodeCells.indices.data() + mesh.nodeCells.offsets[5]);
+    EXPECT_EQ(mesh.getFaceNodesView(0).size(), 4u);
+}
+
+TEST(MeshTest, MeshFileRoundTrip) {
+    Mesh mesh = MeshGenerator::createBoxMesh(4, 3, 2, Vector3D(0, 0, 0), Vector3D(2, 1.5, 1));
+    const std::string path = "test_roundtrip.cfdmesh";
+    MeshFile::write(mesh, path);
+    
+    Mesh loaded = MeshFile::read(path);
+    ASSERT_EQ(loaded.getNumNodes(), mesh.getNumNodes());
+    ASSERT_EQ(loaded.getNumFaces(), mesh.getNumFaces());
+    ASSERT_EQ(loaded.getNumCells(), mesh.getNumCells());
+    EXPECT_TRUE(loaded.validate());
+    
+    // Topology is bit-identical
+    EXPECT_EQ(loaded.faceNodes.offsets, mesh.faceNodes.offsets);
+    EXPECT_EQ(loaded.faceNodes.indices, mesh.faceNodes.indices);
+    EXPECT_EQ(loaded.cellFaces.indices, mesh.cellFaces.indices);
+    EXPECT_EQ(loaded.cellNeighbors.indices, mesh.cellNeighbors.indices);
+    EXPECT_EQ(loaded.nodeCells.offsets, mesh.nodeCells.offsets);
+    for (int f = 0; f < mesh.getNumFaces(); ++f) {
+        EXPECT_EQ(loaded.getFace(f).ownerCell, mesh.getFace(f).ownerCell);
+        EXPECT_EQ(loaded.getFace(f).neighborCell, mesh.getFace(f).neighborCell);
+        EXPECT_DOUBLE_EQ(loaded.getFace(f).area, mesh.getFace(f).area);
+        EXPECT_DOUBLE_EQ(loaded.geometry.faceAreaZ[f], mesh.geometry.faceAreaZ[f]);
+        EXPECT_EQ(loaded.geometry.faceWeight[f], mesh.geometry.faceWeight[f]);
+        EXPECT_EQ(loaded.geometry.faceDeltaCoeff[f], mesh.geometry.faceDeltaCoeff[f]);
+        EXPECT_EQ(loaded.geometry.faceNonOrthX[f], mesh.geometry.faceNonOrthX[f]);
+    }
+    for (int c = 0; c < mesh.getNumCells(); ++c) {
+        EXPECT_DOUBLE_EQ(loaded.getCell(c).volume, mesh.getCell(c).volume);
+        EXPECT_DOUBLE_EQ(loaded.geometry.cellCentroidY[c], mesh.getCell(c).centroid.y);
+    }
+    EXPECT_EQ(loaded.getNode(7).position.x, mesh.getNode(7).position.x);
+    
+    // Patch names, types and face ranges survive
+    ASSERT_TRUE(loaded.hasOrderedFaces());
+    EXPECT_EQ(loaded.getNumInternalFaces(), mesh.getNumInternalFaces());
+    ASSERT_EQ(loaded.boundaries.size(), mesh.boundaries.size());
+    for (const auto& pair : mesh.boundaries) {
+        const BoundaryPatch& patch = loaded.boundaries.at(pair.first);
+        EXPECT_EQ(patch.type, pair.second.type);
+        EXPECT_EQ(patch.faceIds, pair.second.faceIds);
+        EXPECT_EQ(patch.startFace, pair.second.startFace);
+        EXPECT_EQ(patch.numFaces, pair.second.numFaces);
+    }
+    
+    // Wrong version and bad magic are rejected
+    {
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        uint32_t version = MeshFile::FORMAT_VERSION + 1;
+        file.seekp(8);
+        file.write(reinterpret_cast<const char*>(&version), sizeof(version));
+    }
+    EXPECT_THROW(MeshFile::read(path), std::runtime_error);
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file << "not a mesh file at all, just some text padding it out past the header size"
+             << std::string(512, ' ');
+    }
+    EXPECT_THROW(MeshFile::read(path), std::runtime_error);
+    std::remove(path.c_str());
+    
+    EXPECT_THROW(MeshFile::read("missing.cfdmesh"), std::runtime_error);
+}
+
+TEST(MeshTest, MeshFileRejectsCorruptConnectivity) {
+    Mesh mesh = MeshGenerator::createBoxMesh(3, 3, 3, Vector3D(0, 0, 0), Vector3D(1, 1, 1));
+    const std::string path = "test_corrupt.cfdmesh";
+    
+    // Overwrite one label of a section in a fresh copy of the file
+    auto corrupt = [&](MeshFile::Section section, size_t entry, label value) {
+        MeshFile::write(mesh, path);
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        MeshFile::Header header;
+        file.read(reinterpret_cast<char*>(&header), sizeof(header));
+        file.seekp(static_cast<std::streamoff>(header.sectionOffset[section] + entry * sizeof(label)));
+        file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    };
+    
+    corrupt(MeshFile::FACE_NODE_INDICES, 5, mesh.getNumNodes());
+    EXPECT_THROW(MeshFile::read(path), std::runtime_error);
+    corrupt(MeshFile::CELL_FACE_INDICES, 0, -3);
+    EXPECT_THROW(MeshFile::read(path), std::runtime_error);
+    corrupt(MeshFile::CELL_FACE_OFFSETS, 4, 1);  // Offsets decrease
+    EXPECT_THROW(MeshFile::read(path), std::runtime_error);
+    corrupt(MeshFile::NODE_CELL_INDICES, 2, mesh.getNumCells());
+    EXPECT_THROW(MeshFile::read(path), std::runtime_error);
+    corrupt(MeshFile::FACE_NEIGHBOR, 0, mesh.getNumCells());
+    EXPECT_THROW(MeshFile::read(path), std::runtime_error);
+    
+    // Unmodified copy still loads
+    corrupt(MeshFile::FACE_OWNER, 0, mesh.getFace(0).ownerCell);
+    EXPECT_NO_THROW(MeshFile::read(path));
+    std::remove(path.c_str());
+}
+
+TEST(MeshTest, SparkKernelThroughSpatialIndex) {
+    Mesh mesh = createScrambledBox(10);
+    MeshSpatialIndex index(mesh);
+    
+    // Indexed and full-scan searches pick the same kernel cells
+    for (const Vector3D& location : {Vector3D(0.5, 0.5, 0.5), Vector3D(0.03, 0.9, 0.41), Vector3D(1.0, 0.0, 0.2)}) {
+        SparkConfig config;
+        config.location = location;
+        config.kernelRadius = 0.17;
+        SparkIgnition scan, indexed;
+        scan.initialize(config);
+        indexed.initialize(config);
+        indexed.setSpatialIndex(&index);
+        const std::vector<label> expected = scan.findKernelCells(mesh);
+        EXPECT_FALSE(expected.empty());
+        EXPECT_EQ(indexed.findKernelCells(mesh), expected);
+    }
+    
+    // The combustion model keeps its index in step with a moving mesh
+    FieldManager fields;
+    ScalarFieldId temperatureId = fields.registerScalarField("temperature", mesh.getNumCells());
+    CombustionModel combustion;
+    combustion.initialize(CombustionConfig());
+    combustion.setMesh(mesh);
+    SparkConfig config;
+    config.location = Vector3D(0.75, 0.5, 0.5);
+    config.kernelRadius = 0.12;
+    config.ignitionTime = 1.0;
+    combustion.initializeSpark(config, 0.0);
+    
+    std::vector<label> allNodes(mesh.getNumNodes());
+    std::iota(allNodes.begin(), allNodes.end(), 0);
+    mesh.translateNodes(allNodes, Vector3D(0.25, 0, 0));
+    mesh.updateGeometry();
+    
+    combustion.applySpark(fields, 0.5);  // Before ignition: nothing
+    EXPECT_EQ(fields.getField(temperatureId).max(), 0.0);
+    combustion.applySpark(fields, 1.0);
+    SparkIgnition scan;
+    scan.initialize(config);
+    const std::vector<label> kernel = scan.findKernelCells(mesh);
+    ASSERT_FALSE(kernel.empty());
+    std::vector<label> heated;
+    for (label c = 0; c < mesh.getNumCells(); ++c) {
+        if (fields.getField(temperatureId)(c) > 0.0) heated.push_back(c);
+    }
+    EXPECT_EQ(heated, kernel);
+}
+
+TEST(MeshTest, SpatialIndexQueries) {
+    Mesh mesh = createScrambledBox(10);
+    MeshSpatialIndex index(mesh);
+    ASSERT_TRUE(index.isBuilt());
+    EXPECT_EQ(index.getNumCells(), mesh.getNumCells());
+    
+    auto bruteRadius = [&](const Vector3D& p, double r) {
+        std::vector<label> cells;
+        for (int c = 0; c < mesh.getNumCells(); ++c) {
+            if ((mesh.getCell(c).centroid - p).magnitude() < r) cells.push_back(c);
+        }
+        return cells;
+    };
+    
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> coord(-0.1, 1.1);
+    for (int trial = 0; trial < 20; ++trial) {
+        Vector3D p(coord(rng), coord(rng), coord(rng));
+        EXPECT_EQ(index.findCellsInRadius(p, 0.23), bruteRadius(p, 0.23));
+        
+        // k nearest match a full sort by centroid distance
+        std::vector<label> all(mesh.getNumCells());
+        std::iota(all.begin(), all.end(), 0);
+        std::sort(all.begin(), all.end(), [&](int a, int b) {
+            double da = (mesh.getCell(a).centroid - p).magnitudeSquared();
+            double db = (mesh.getCell(b).centroid - p).magnitudeSquared();
+            return (da != db) ? (da < db) : (a < b);
+        });
+        all.resize(5);
+        EXPECT_EQ(index.findNearestCells(p, 5), all);
+        
+        // Point location agrees with the cell's own face planes
+        int cell = index.findCell(mesh, p);
+        bool inside = p.x >= 0 && p.x <= 1 && p.y >= 0 && p.y <= 1 && p.z >= 0 && p.z <= 1;
+        if (inside) {
+            ASSERT_GE(cell, 0);
+            EXPECT_TRUE(MeshSpatialIndex::cellContains(mesh, cell, p));
+            EXPECT_LT((mesh.getCell(cell).centroid - p).magnitude(), std::sqrt(3.0) * 0.05 + 1e-12);
+        } else {
+            EXPECT_EQ(cell, -1);
+        }
+    }
+    
+    // Refit follows moved nodes without rebuilding
+    int before = index.getNumTreeNodes();
+    for (auto& node : mesh.nodes) {
+        node.position += Vector3D(2.0, 0.0, 0.0);
+    }
+    mesh.computeAllGeometry();
+    index.refit(mesh);
+    EXPECT_EQ(index.getNumTreeNodes(), before);
+    EXPECT_EQ(index.findCellsInRadius(Vector3D(2.5, 0.5, 0.5), 0.3), bruteRadius(Vector3D(2.5, 0.5, 0.5), 0.3));
+    EXPECT_EQ(index.findCell(mesh, Vector3D(0.5, 0.5, 0.5)), -1);
+    EXPECT_GE(index.findCell(mesh, Vector3D(2.5, 0.5, 0.5)), 0);
+}
+
+TEST(MeshTest, IncrementalGeometryUpdate) {
+    const int n = 6;
+    Mesh mesh = MeshGenerator::createBoxMesh(n, n, n, Vector3D(0, 0, 0), Vector3D(1, 1, 1));
+    
+    // Piston: lift the top node layer
+    std::vector<label> pistonNodes;
+    for (const Node& node : mesh.nodes) {
+        if (node.position.z > 1.0 - 1e-12) pistonNodes.push_back(node.id);
+    }
+    ASSERT_EQ(pistonNodes.size(), static_cast<size_t>((n + 1) * (n + 1)));
+    
+    mesh.translateNodes(pistonNodes, Vector3D(0, 0, 0.25));
+    EXPECT_TRUE(mesh.hasMovedNodes());
+    EXPECT_EQ(mesh.getMovedNodes().size(), pistonNodes.size());
+    
+    // Only the top cell layer is recomputed
+    EXPECT_EQ(mesh.updateGeometry(), n * n);
+    EXPECT_FALSE(mesh.hasMovedNodes());
+    EXPECT_EQ(mesh.updateGeometry(), 0);
+    
+    Mesh reference = mesh;
+    reference.computeAllGeometry();
+    for (label f = 0; f < mesh.getNumFaces(); ++f) {
+        EXPECT_NEAR(mesh.getFace(f).area, reference.getFace(f).area, 1e-14);
+        EXPECT_NEAR(mesh.geometry.faceCentroidZ[f], reference.geometry.faceCentroidZ[f], 1e-14);
+    }
+    double volume = 0.0;
+    for (label c = 0; c < mesh.getNumCells(); ++c) {
+        EXPECT_NEAR(mesh.getCell(c).volume, reference.getCell(c).volume, 1e-14);
+        EXPECT_NEAR(mesh.geometry.cellCentroidZ[c], reference.getCell(c).centroid.z, 1e-14);
+        volume += mesh.geometry.cellVolume[c];
+    }
+    EXPECT_NEAR(volume, 1.25, 1e-12);
+    
+    // Single-node moves and direct writes are tracked too
+    mesh.setNodePosition(0, Vector3D(-0.01, 0, 0));
+    mesh.nodes[1].position.y -= 0.01;
+    mesh.markNodeMoved(1);
+    EXPECT_EQ(mesh.updateGeometry(), 2);
+}
+
+TEST(MeshTest, FaceFactors) {
+    const int n = 4;
+    Mesh mesh = MeshGenerator::createBoxMesh(n, n, n, Vector3D(0, 0, 0), Vector3D(1, 1, 1));
+    const MeshGeometry& g = mesh.geometry;
+    ASSERT_EQ(static_cast<label>(g.faceWeight.size()), mesh.getNumFaces());
+    
+    // Uniform orthogonal grid: midpoint weights, 1/h spacing, no correction
+    const double h = 1.0 / n;
+    for (label f = 0; f < mesh.getNumFaces(); ++f) {
+        bool boundary = mesh.getFace(f).isBoundary();
+        EXPECT_NEAR(g.faceWeight[f], boundary ? 1.0 : 0.5, 1e-12);
+        EXPECT_NEAR(g.faceDeltaCoeff[f], boundary ? 2.0 / h : 1.0 / h, 1e-9);
+        EXPECT_NEAR(g.faceLaplacianCoeff[f], h * h * g.faceDeltaCoeff[f], 1e-9);
+        EXPECT_NEAR(g.faceNonOrthX[f], 0.0, 1e-12);
+        EXPECT_NEAR(g.faceNonOrthY[f], 0.0, 1e-12);
+        EXPECT_NEAR(g.faceNonOrthZ[f], 0.0, 1e-12);
+    }
+    
+    // Shear the top layer: factors around it change and match a full rebuild
+    std::vector<label> topNodes;
+    for (const Node& node : mesh.nodes) {
+        if (node.position.z > 1.0 - 1e-12) topNodes.push_back(node.id);
+    }
+    mesh.translateNodes(topNodes, Vector3D(0.1, 0, 0.3));
+    mesh.updateGeometry();
+    
+    Mesh reference = mesh;
+    reference.computeAllGeometry();
+    bool anySkewed = false;
+    for (label f = 0; f < mesh.getNumFaces(); ++f) {
+        EXPECT_NEAR(g.faceWeight[f], reference.geometry.faceWeight[f], 1e-12);
+        EXPECT_NEAR(g.faceDeltaCoeff[f], reference.geometry.faceDeltaCoeff[f], 1e-9);
+        EXPECT_NEAR(g.faceLaplacianCoeff[f], reference.geometry.faceLaplacianCoeff[f], 1e-9);
+        EXPECT_NEAR(g.faceNonOrthX[f], reference.geometry.faceNonOrthX[f], 1e-12);
+        EXPECT_NEAR(g.faceNonOrthZ[f], reference.geometry.faceNonOrthZ[f], 1e-12);
+        if (std::abs(g.faceNonOrthX[f]) > 1e-6) anySkewed = true;
+    }
+    EXPECT_TRUE(anySkewed);
+}
+
+TEST(MeshTest, FieldIntegrals) {
+    Mesh mesh = MeshGenerator::createBoxMesh(6, 5, 4, Vector3D(0, 0, 0), Vector3D(3, 2, 1));
+    const MeshGeometry& g = mesh.geometry;
+    const label numCells = mesh.getNumCells();
+    
+    Field T("T", FieldType::SCALAR, numCells);
+    Field U("U", FieldType::VECTOR, numCells, FieldPrecision::DOUBLE, FieldLayout::BLOCKED);
+    for (label c = 0; c < numCells; ++c) {
+        T(c) = 1.0 + 2.0 * g.cellCentroidX[c];
+        U(c, 0) = 2.0;
+        U(c, 1) = g.cellCentroidY[c];
+        U(c, 2) = -1.0;
+    }
+    
+    // Linear fields are integrated exactly by the midpoint rule
+    EXPECT_NEAR(totalVolume(mesh), 6.0, 1e-12);
+    EXPECT_NEAR(volumeIntegral(mesh, T), 6.0 * (1.0 + 2.0 * 1.5), 1e-12);
+    EXPECT_NEAR(volumeAverage(mesh, U, 1), 1.0, 1e-12);
+    
+    EXPECT_NEAR(patchArea(mesh, "xmax"), 2.0, 1e-12);
+    EXPECT_NEAR(patchAverage(mesh, T, "xmin"), 1.0 + 2.0 * 0.25, 1e-12);
+    EXPECT_NEAR(patchIntegral(mesh, U, "zmin", 2), -6.0, 1e-12);
+    
+    // Outward fluxes: 2 * 2 through xmax, -(2 * 2) through xmin; the
+    // uniform z velocity leaves through zmin only
+    EXPECT_NEAR(patchFlux(mesh, U, "xmax"), 4.0, 1e-12);
+    EXPECT_NEAR(patchFlux(mesh, U, "xmin"), -4.0, 1e-12);
+    EXPECT_NEAR(patchFlux(mesh, U, "zmin"), 3.0 * 2.0, 1e-12);
+    EXPECT_THROW(patchFlux(mesh, T, "xmax"), std::invalid_argument);
+    EXPECT_THROW(patchArea(mesh, "inlet"), std::runtime_error);
+}
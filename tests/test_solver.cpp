@@ -0,0 +1,733 @@
+#include <gtest/gtest.h>
+#include "solver/FVMatrix.h"
+#include "solver/FluidDynamics.h"
+#include "solver/LinearSolver.h"
+#include "solver/AMGPreconditioner.h"
+#include "solver/TimeStepController.h"
+#include "solver/ThermodynamicProperties.h"
+#include "solver/CFDSolver.h"
+#include "turbulence/KEpsilonModel.h"
+#include "core/FieldIntegrals.h"
+#include "mesh/MeshGenerator.h"
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <omp.h>
+
+using namespace cfd;
+
+namespace {
+
+// Dense y = A x straight from the LDU arrays
+std::vector<double> denseMultiply(const FVMatrix& A, const std::vector<double>& x) {
+    const FVAddressing& addr = A.getAddressing();
+    std::vector<double> y(A.getNumCells());
+    for (label c = 0; c < A.getNumCells(); ++c) {
+        y[c] = A.diag[c] * x[c];
+    }
+    for (label i = 0; i < addr.getNumInternalFaces(); ++i) {
+        y[addr.lowerAddr[i]] += A.upper()[i] * x[addr.upperAddr[i]];
+        y[addr.upperAddr[i]] += A.lower()[i] * x[addr.lowerAddr[i]];
+    }
+    return y;
+}
+
+// -laplacian(x) = 1 on the unit cube with x = 0 on the whole boundary
+void assemblePoisson(const Mesh& mesh, FVMatrix& A) {
+    const MeshGeometry& g = mesh.geometry;
+    A.zero();
+    A.fillInternalFaces([&](label, label f, double& upper, double& lower) {
+        upper = lower = -mesh.faces[f].area * g.faceDeltaCoeff[f];
+    });
+    A.fillBoundaryFaces([&](label, label f, double& diag, double&) {
+        diag = mesh.faces[f].area * g.faceDeltaCoeff[f];
+    });
+    A.collectDiagonal();
+    for (label c = 0; c < A.getNumCells(); ++c) A.source[c] = g.cellVolume[c];
+}
+
+} // anonymous namespace
+
+TEST(FVMatrixTest, AddressingAndProducts) {
+    Mesh mesh = MeshGenerator::createBoxMesh(4, 3, 2, Vector3D(0, 0, 0), Vector3D(1, 1, 1));
+    FVAddressing addr(mesh);
+    EXPECT_TRUE(addr.matches(mesh));
+    EXPECT_EQ(addr.getNumCells(), 24);
+    EXPECT_EQ(addr.getNumInternalFaces(), 3 * 3 * 2 + 4 * 2 * 2 + 4 * 3 * 1);
+    EXPECT_EQ(addr.getNumBoundaryFaces(), 2 * (3 * 2 + 4 * 2 + 4 * 3));
+    EXPECT_EQ(addr.rows.getNumEntries(), 2 * addr.getNumInternalFaces());
+    for (label c = 0; c < addr.getNumCells(); ++c) {
+        Span<const label> row = addr.rows.row(c);
+        EXPECT_TRUE(std::is_sorted(row.begin(), row.end()));
+    }
+    
+    // Asymmetric coefficients, diagonal from the face terms
+    FVMatrix A(addr);
+    A.zero();
+    A.fillInternalFaces([](label i, label, double& upper, double& lower) {
+        upper = -1.0 - 0.1 * i;
+        lower = -2.0 + 0.05 * i;
+    });
+    A.fillBoundaryFaces([](label b, label, double& diag, double& source) {
+        diag = 0.5;
+        source = 1.0 + b;
+    });
+    A.collectDiagonal();
+    EXPECT_FALSE(A.isSymmetric());
+    
+    std::vector<double> x(A.getNumCells()), y(A.getNumCells()), r(A.getNumCells());
+    for (label c = 0; c < A.getNumCells(); ++c) x[c] = std::sin(1.0 + c);
+    A.multiply(x.data(), y.data());
+    std::vector<double> reference = denseMultiply(A, x);
+    for (label c = 0; c < A.getNumCells(); ++c) {
+        EXPECT_NEAR(y[c], reference[c], 1e-12);
+    }
+    
+    // Conservative fluxes: internal columns sum to zero, so the face terms
+    // cancel in sum(A 1) and only the boundary terms remain
+    std::vector<double> ones(A.getNumCells(), 1.0);
+    A.multiply(ones.data(), y.data());
+    double boundarySource = 0.0, totalSource = 0.0, total = 0.0;
+    for (label c = 0; c < A.getNumCells(); ++c) {
+        total += y[c];
+        totalSource += A.source[c];
+    }
+    for (label b = 0; b < addr.getNumBoundaryFaces(); ++b) boundarySource += A.boundarySource[b];
+    EXPECT_NEAR(total, 0.5 * addr.getNumBoundaryFaces(), 1e-9);
+    EXPECT_DOUBLE_EQ(totalSource, boundarySource);
+    
+    A.residual(ones.data(), r.data());
+    EXPECT_NEAR(r[0], A.source[0] - y[0], 1e-12);
+}
+
+TEST(FVMatrixTest, FluidDynamicsAssembly) {
+    const int n = 8;
+    Mesh mesh = MeshGenerator::createBoxMesh(n, n, n, Vector3D(0, 0, 0), Vector3D(1, 1, 1));
+    FieldManager fields;
+    FluidDynamics fluid;
+    fluid.initialize(mesh, fields);
+    
+    // Uniform flow: divergence-free, so the pressure source vanishes inside
+    Field& velocity = fields.getField("velocity");
+    for (label c = 0; c < mesh.getNumCells(); ++c) velocity(c, 0) = 2.0;
+    fields.getField("density").fill(1.2);
+    fields.getField("temperature").fill(300.0);
+    fields.getField("pressure").fill(101325.0);
+    
+    const double dt = 1e-3;
+    fluid.computeMomentum(fields, dt);
+    fluid.solvePressureCorrection(fields);
+    
+    const FVMatrix& U = fluid.getMomentumMatrix();
+    const FVMatrix& P = fluid.getPressureMatrix();
+    const double* momentumStorage = U.offDiag.data();
+    const double* pressureStorage = P.diag.data();
+    
+    // Upwind momentum: M-matrix with the time term on the diagonal
+    const FVAddressing& addr = fluid.getAddressing();
+    for (label c = 0; c < mesh.getNumCells(); ++c) {
+        double offSum = 0.0;
+        for (label k = addr.rows.offsets[c]; k < addr.rows.offsets[c + 1]; ++k) {
+            EXPECT_LE(U.offDiag[addr.rowCoeffs[k]], 0.0);
+            offSum += std::abs(U.offDiag[addr.rowCoeffs[k]]);
+        }
+        const double timeTerm = 1.2 * mesh.geometry.cellVolume[c] / dt;
+        if (addr.cellBoundaryFaces.getRowSize(c) == 0) {
+            EXPECT_NEAR(U.diag[c] - offSum, timeTerm, 1e-9 * timeTerm);
+        }
+    }
+    
+    // Pressure: symmetric, zero row sums (no outlet), no source in uniform flow
+    EXPECT_TRUE(P.isSymmetric());
+    std::vector<double> ones(mesh.getNumCells(), 1.0), y(mesh.getNumCells());
+    P.multiply(ones.data(), y.data());
+    for (label c = 0; c < mesh.getNumCells(); ++c) {
+        EXPECT_NEAR(y[c], 0.0, 1e-15);
+        if (addr.cellBoundaryFaces.getRowSize(c) == 0) {
+            EXPECT_NEAR(P.source[c], 0.0, 1e-12);
+        }
+    }
+    
+    // Refilling reuses the storage and does not depend on the thread count
+    std::vector<double> diag1(U.diag.begin(), U.diag.end());
+    const int maxThreads = omp_get_max_threads();
+    omp_set_num_threads(3);
+    fluid.computeMomentum(fields, dt);
+    fluid.solvePressureCorrection(fields);
+    omp_set_num_threads(maxThreads);
+    EXPECT_EQ(U.offDiag.data(), momentumStorage);
+    EXPECT_EQ(P.diag.data(), pressureStorage);
+    for (label c = 0; c < mesh.getNumCells(); ++c) {
+        EXPECT_EQ(U.diag[c], diag1[c]);
+    }
+}
+
+TEST(LinearSolverTest, AMGPreconditionedCG) {
+    // Iterations with AMG stay nearly flat under refinement, while
+    // Jacobi-PCG iterations grow with the mesh size
+    int amgIterations[2], jacobiIterations[2];
+    const int sizes[2] = {8, 24};
+    for (int m = 0; m < 2; ++m) {
+        const int n = sizes[m];
+        Mesh mesh = MeshGenerator::createBoxMesh(n, n, n, Vector3D(0, 0, 0), Vector3D(1, 1, 1));
+        FVAddressing addr(mesh);
+        FVMatrix A(addr);
+        assemblePoisson(mesh, A);
+        ASSERT_TRUE(A.isSymmetric());
+        
+        AMGPreconditioner amg;
+        amg.setup(A);
+        EXPECT_GE(amg.getNumLevels(), 1);
+        EXPECT_LE(amg.getLevelSize(amg.getNumLevels() - 1), amg.coarsestSize);
+        EXPECT_LT(amg.getOperatorComplexity(), 2.0);
+        
+        JacobiPreconditioner jacobi;
+        jacobi.setup(A);
+        
+        PCGSolver pcg;
+        pcg.relativeTolerance = 1e-8;
+        std::vector<double> x(A.getNumCells(), 0.0), r(A.getNumCells());
+        SolverPerformance perf = pcg.solve(A, amg, A.source.data(), x.data());
+        EXPECT_TRUE(perf.converged);
+        amgIterations[m] = perf.iterations;
+        
+        // The returned residual is the true one
+        A.residual(x.data(), r.data());
+        double rr = 0.0, bb = 0.0;
+        for (label c = 0; c < A.getNumCells(); ++c) {
+            rr += r[c] * r[c];
+            bb += A.source[c] * A.source[c];
+        }
+        EXPECT_LE(std::sqrt(rr / bb), 1e-7);
+        
+        // Symmetric maximum principle: the solution is positive inside
+        for (label c = 0; c < A.getNumCells(); ++c) EXPECT_GT(x[c], 0.0);
+        
+        std::vector<double> y(A.getNumCells(), 0.0);
+        perf = pcg.solve(A, jacobi, A.source.data(), y.data());
+        EXPECT_TRUE(perf.converged);
+        jacobiIterations[m] = perf.iterations;
+        for (label c = 0; c < A.getNumCells(); ++c) EXPECT_NEAR(y[c], x[c], 1e-6 * x[c]);
+    }
+    EXPECT_LT(amgIterations[0], jacobiIterations[0]);
+    EXPECT_LE(amgIterations[1], amgIterations[0] + 4);
+    EXPECT_GT(jacobiIterations[1], 2 * jacobiIterations[0]);
+}
+
+TEST(LinearSolverTest, PressureCorrection) {
+    // Closed box: singular Neumann problem, solved for the zero-mean p'
+    const int n = 12;
+    Mesh mesh = MeshGenerator::createBoxMesh(n, n, n, Vector3D(0, 0, 0), Vector3D(1, 1, 1));
+    FieldManager fields;
+    FluidDynamics fluid;
+    fluid.initialize(mesh, fields);
+    
+    Field& velocity = fields.getField("velocity");
+    for (label c = 0; c < mesh.getNumCells(); ++c) {
+        const Vector3D& x = mesh.cells[c].centroid;
+        velocity(c, 0) = std::sin(3.0 * x.x) * std::cos(2.0 * x.y);
+        velocity(c, 1) = x.z;
+    }
+    fields.getField("density").fill(1.2);
+    fields.getField("temperature").fill(300.0);
+    fields.getField("pressure").fill(101325.0);
+    
+    const double dt = 1e-3;
+    fluid.computeMomentum(fields, dt);
+    fluid.solvePressureCorrection(fields);
+    const SolverPerformance& perf = fluid.getPressurePerformance();
+    EXPECT_TRUE(perf.converged);
+    EXPECT_GT(perf.iterations, 0);
+    
+    const AlignedVector<double>& correction = fluid.getPressureCorrection();
+    double mean = 0.0;
+    for (double p : correction) mean += p;
+    EXPECT_NEAR(mean / mesh.getNumCells(), 0.0, 1e-9);
+    
+    // Corrected face fluxes are conservative in every cell
+    const FVAddressing& addr = fluid.getAddressing();
+    const AlignedVector<double>& F = fluid.getMassFlux();
+    std::vector<double> divergence(mesh.getNumCells(), 0.0);
+    double fluxScale = 0.0;
+    for (label i = 0; i < addr.getNumInternalFaces(); ++i) {
+        const label f = addr.internalFaces[i];
+        const label P = addr.lowerAddr[i], N = addr.upperAddr[i];
+        const double corrected = F[f] - dt * mesh.faces[f].area * mesh.geometry.faceDeltaCoeff[f] *
+                                            (correction[N] - correction[P]);
+        divergence[P] += corrected;
+        divergence[N] -= corrected;
+        fluxScale = std::max(fluxScale, std::abs(F[f]));
+    }
+    for (label c = 0; c < mesh.getNumCells(); ++c) {
+        EXPECT_NEAR(divergence[c], 0.0, 1e-6 * fluxScale);
+    }
+    
+    // The hierarchy is kept for the next step
+    const int levels = fluid.getPressurePreconditioner().getNumLevels();
+    fluid.computeMomentum(fields, 2 * dt);
+    fluid.solvePressureCorrection(fields);
+    EXPECT_TRUE(fluid.getPressurePerformance().converged);
+    EXPECT_EQ(fluid.getPressurePreconditioner().getNumLevels(), levels);
+    
+    // No old levels registered: the velocity is corrected in place
+    const double before = velocity(0, 0);
+    fluid.updateVelocity(fields);
+    EXPECT_NE(velocity(0, 0), before);
+    EXPECT_TRUE(std::isfinite(velocity(0, 0)));
+}
+
+TEST(LinearSolverTest, PressureMatrixFollowsMesh) {
+    // Static mesh: the coefficients and hierarchy are kept between steps.
+    // Once the mesh moves both are rebuilt for the new geometry
+    const int n = 6;
+    Mesh mesh = MeshGenerator::createBoxMesh(n, n, n, Vector3D(0, 0, 0), Vector3D(1, 1, 1));
+    FieldManager fields;
+    FluidDynamics fluid;
+    fluid.initialize(mesh, fields);
+    
+    Field& velocity = fields.getField("velocity");
+    for (label c = 0; c < mesh.getNumCells(); ++c) {
+        velocity(c, 0) = std::sin(3.0 * mesh.cells[c].centroid.y);
+    }
+    fields.getField("density").fill(1.2);
+    fields.getField("temperature").fill(300.0);
+    fields.getField("pressure").fill(101325.0);
+    
+    const double dt = 1e-3;
+    const FVMatrix& P = fluid.getPressureMatrix();
+    fluid.computeMomentum(fields, dt);
+    fluid.solvePressureCorrection(fields);
+    std::vector<double> diag0(P.diag.begin(), P.diag.end());
+    
+    // Matches a fresh hierarchy on the current matrix, bit for bit
+    auto matchesFreshHierarchy = [&]() {
+        AMGPreconditioner fresh;
+        fresh.setup(P);
+        std::vector<double> r(mesh.getNumCells()), z1(r.size()), z2(r.size());
+        for (size_t i = 0; i < r.size(); ++i) r[i] = std::cos(0.7 * i);
+        fresh.apply(r.data(), z1.data());
+        fluid.getPressurePreconditioner().apply(r.data(), z2.data());
+        return z1 == z2;
+    };
+    EXPECT_TRUE(matchesFreshHierarchy());
+    
+    // Lift the top node layer: the top cells grow by half
+    std::vector<label> topNodes;
+    for (const Node& node : mesh.nodes) {
+        if (node.position.z > 1.0 - 1e-12) topNodes.push_back(node.id);
+    }
+    mesh.translateNodes(topNodes, Vector3D(0, 0, 0.5 / n));
+    mesh.updateGeometry();
+    
+    fluid.computeMomentum(fields, dt);
+    fluid.solvePressureCorrection(fields);
+    EXPECT_TRUE(fluid.getPressurePerformance().converged);
+    EXPECT_TRUE(matchesFreshHierarchy());
+    label changedRows = 0;
+    for (label c = 0; c < mesh.getNumCells(); ++c) {
+        changedRows += (P.diag[c] != diag0[c]);
+    }
+    EXPECT_GT(changedRows, 0);
+    
+    // The corrected fluxes are conservative on the moved mesh
+    const FVAddressing& addr = fluid.getAddressing();
+    const AlignedVector<double>& F = fluid.getMassFlux();
+    const AlignedVector<double>& correction = fluid.getPressureCorrection();
+    std::vector<double> divergence(mesh.getNumCells(), 0.0);
+    double fluxScale = 0.0;
+    for (label i = 0; i < addr.getNumInternalFaces(); ++i) {
+        const label f = addr.internalFaces[i];
+        const label owner = addr.lowerAddr[i], neighbor = addr.upperAddr[i];
+        const double corrected = F[f] - dt * mesh.geometry.faceLaplacianCoeff[f] *
+                                            (correction[neighbor] - correction[owner]);
+        divergence[owner] += corrected;
+        divergence[neighbor] -= corrected;
+        fluxScale = std::max(fluxScale, std::abs(F[f]));
+    }
+    for (label c = 0; c < mesh.getNumCells(); ++c) {
+        EXPECT_NEAR(divergence[c], 0.0, 1e-6 * fluxScale);
+    }
+}
+
+TEST(LinearSolverTest, MatrixFreeMomentum) {
+    const int n = 10;
+    Mesh mesh = MeshGenerator::createBoxMesh(n, n, n, Vector3D(0, 0, 0), Vector3D(1, 1, 1));
+    FieldManager fields;
+    FluidDynamics assembled, matrixFree;
+    assembled.initialize(mesh, fields);
+    matrixFree.setMatrixFree(true);
+    matrixFree.initialize(mesh, fields);
+    EXPECT_TRUE(matrixFree.isMatrixFree());
+    EXPECT_EQ(matrixFree.getMomentumMatrix().getMemoryUsage(), 0u);
+    
+    Field& velocity = fields.getField("velocity");
+    for (label c = 0; c < mesh.getNumCells(); ++c) {
+        const Vector3D& x = mesh.cells[c].centroid;
+        velocity(c, 0) = 5.0 * std::sin(3.0 * x.y);
+        velocity(c, 1) = -2.0 * x.x;
+        velocity(c, 2) = 1.0;
+    }
+    fields.getField("density").fill(1.2);
+    Field& temperature = fields.getField("temperature");
+    for (label c = 0; c < mesh.getNumCells(); ++c) temperature(c) = 300.0 + 500.0 * mesh.cells[c].centroid.z;
+    
+    // Large dt so convection and diffusion are not swamped by the time term
+    const double dt = 1.0;
+    assembled.computeMomentum(fields, dt);
+    matrixFree.computeMomentum(fields, dt);
+    const FVMatrix& A = assembled.getMomentumMatrix();
+    const FVTransportOperator& B = matrixFree.getMomentumOperator();
+    EXPECT_EQ(&matrixFree.getMomentumSystem(), static_cast<const LinearOperator*>(&B));
+    
+    const label numCells = mesh.getNumCells();
+    std::vector<double> x(numCells), ya(numCells), yb(numCells);
+    for (label c = 0; c < numCells; ++c) x[c] = std::cos(0.7 * c);
+    A.apply(x.data(), ya.data());
+    B.apply(x.data(), yb.data());
+    for (label c = 0; c < numCells; ++c) {
+        EXPECT_NEAR(B.diag[c], A.diag[c], 1e-12 * std::abs(A.diag[c]));
+        EXPECT_NEAR(yb[c], ya[c], 1e-12 * A.diag[c]);
+    }
+    
+    // Diagonal-only storage: 5x or more below the assembled coefficients
+    EXPECT_GE(A.getMemoryUsage(), 5 * B.getMemoryUsage());
+    
+    // Non-symmetric solve: both representations give the same iterates
+    EXPECT_FALSE(A.isSymmetric());
+    JacobiPreconditioner jacobiA, jacobiB;
+    jacobiA.setup(A);
+    jacobiB.setup(B);
+    BiCGStabSolver solver;
+    solver.relativeTolerance = 1e-10;
+    std::vector<double> xa(numCells, 0.0), xb(numCells, 0.0), r(numCells);
+    SolverPerformance perfA = solver.solve(A, jacobiA, ya.data(), xa.data());
+    SolverPerformance perfB = solver.solve(B, jacobiB, ya.data(), xb.data());
+    EXPECT_TRUE(perfA.converged);
+    EXPECT_TRUE(perfB.converged);
+    EXPECT_EQ(perfA.iterations, perfB.iterations);
+    for (label c = 0; c < numCells; ++c) {
+        EXPECT_NEAR(xa[c], x[c], 1e-7);
+        EXPECT_NEAR(xb[c], x[c], 1e-7);
+    }
+    
+    // Switching back releases the operator and assembles again
+    matrixFree.setMatrixFree(false);
+    EXPECT_EQ(matrixFree.getMomentumOperator().getMemoryUsage(), 0u);
+    matrixFree.computeMomentum(fields, dt);
+    EXPECT_EQ(matrixFree.getMomentumMatrix().getMemoryUsage(), A.getMemoryUsage());
+}
+
+TEST(TimeStepTest, Controller) {
+    TimeStepLimits limits;
+    limits.maxCourant = 0.5;
+    limits.maxGrowth = 1.2;
+    limits.maxTimeStep = 1e-3;
+    TimeStepController controller(limits);
+    const double never = 1e30;
+    
+    // Courant 1 at dt: halve at once; Courant 0.1: grow by 1.2 only
+    EXPECT_DOUBLE_EQ(controller.proposeTimeStep(1e-5, 1.0, 1e-5, never), 5e-6);
+    EXPECT_DOUBLE_EQ(controller.proposeTimeStep(1e-5, 0.1, 1e-5, never), 1.2e-5);
+    EXPECT_DOUBLE_EQ(controller.proposeTimeStep(1e-5, 0.1, 1e-5, 3e-6), 3e-6);
+    EXPECT_DOUBLE_EQ(controller.proposeTimeStep(9e-4, 0.0, 9e-4, never), 1e-3);
+    
+    // Growth continues from the proposal after a step cut short by a sync
+    EXPECT_DOUBLE_EQ(controller.proposeTimeStep(1e-6, 1e-4, 1e-5, never), 1.2e-5);
+    
+    // Sync: land exactly, or split the approach into two equal steps
+    bool lands = false;
+    EXPECT_DOUBLE_EQ(controller.fitToSyncTime(0.3, 1e-3, 0.3005, lands), 0.3005 - 0.3);
+    EXPECT_TRUE(lands);
+    EXPECT_DOUBLE_EQ(controller.fitToSyncTime(0.3, 1e-3, 0.3015, lands), 0.5 * (0.3015 - 0.3));
+    EXPECT_FALSE(lands);
+    EXPECT_DOUBLE_EQ(controller.fitToSyncTime(0.3, 1e-3, 0.31, lands), 1e-3);
+    EXPECT_FALSE(lands);
+    
+    // Sync times equal up to rounding: the second is already reached
+    const double outputTime = 3 * 1e-4, checkpointTime = 3e-4;
+    ASSERT_NE(outputTime, checkpointTime);
+    EXPECT_TRUE(controller.isSyncReached(checkpointTime, outputTime));
+    EXPECT_DOUBLE_EQ(controller.fitToSyncTime(checkpointTime, 1e-5, outputTime, lands), 1e-5);
+    EXPECT_FALSE(lands);
+    const double justBeyond = 0.3 + 1e-3 + 1e-13;
+    EXPECT_DOUBLE_EQ(controller.fitToSyncTime(0.3, 1e-3, justBeyond, lands), justBeyond - 0.3);
+    EXPECT_TRUE(lands);
+    
+    // Quiet flow: geometric growth up to maxTimeStep, then constant
+    double dt = 1e-6;
+    int steps = 0;
+    while (dt < limits.maxTimeStep && steps < 100) {
+        const double next = controller.proposeTimeStep(dt, 1e-3, dt, never);
+        EXPECT_LE(next, 1.2 * dt * (1.0 + 1e-12));
+        dt = next;
+        steps++;
+    }
+    EXPECT_DOUBLE_EQ(dt, limits.maxTimeStep);
+    EXPECT_LE(steps, 40);
+}
+
+TEST(TimeStepTest, AdaptiveSolver) {
+    // 1 mm box, slow flow: Courant allows large steps until the flame
+    // limit (0.2 cells per step at 1 m/s) takes over after ignition
+    Mesh mesh = MeshGenerator::createBoxMesh(6, 6, 6, Vector3D(0, 0, 0), Vector3D(1e-3, 1e-3, 1e-3));
+    SimulationConfig config;
+    config.endTime = 1e-2;
+    config.timeStep = 1e-5;
+    config.outputInterval = 1e-3;
+    config.checkpointInterval = 2.5e-3;
+    config.adaptiveTimeStep = true;
+    config.timeStepLimits.maxTimeStep = 1e-3;
+    InitialConditions ic;
+    ic.velocity = Vector3D(0.05, 0, 0);
+    
+    SparkConfig spark;
+    spark.location = Vector3D(5e-4, 5e-4, 5e-4);
+    
+    double lastStep[2];
+    int iterations[2];
+    for (int burning = 0; burning < 2; ++burning) {
+        CFDSolver solver;
+        solver.initialize(mesh, config);
+        solver.setInitialConditions(ic);
+        spark.ignitionTime = burning ? 0.0 : 1.0;
+        solver.setSpark(spark);
+        solver.solve();
+        EXPECT_EQ(solver.getCurrentTime(), config.endTime);
+        lastStep[burning] = solver.getLastTimeStep();
+        iterations[burning] = solver.getCurrentIteration();
+    }
+    const double cellSize = 1e-3 / 6;
+    EXPECT_LE(lastStep[1], 0.2 * cellSize * (1.0 + 1e-9));
+    EXPECT_GT(lastStep[0], 10.0 * lastStep[1]);
+    EXPECT_GT(iterations[1], 3 * iterations[0]);
+}
+
+TEST(TimeStepTest, CoincidingSyncTimes) {
+    // Every third output (k * 1e-4) coincides with a checkpoint (k * 3e-4)
+    // only up to rounding; both are met by the same step, never by an
+    // extra sliver step
+    Mesh mesh = MeshGenerator::createBoxMesh(4, 4, 4, Vector3D(0, 0, 0), Vector3D(1e-3, 1e-3, 1e-3));
+    SimulationConfig config;
+    config.endTime = 9e-4;
+    config.timeStep = 1e-5;
+    config.outputInterval = 1e-4;
+    config.checkpointInterval = 3e-4;
+    config.adaptiveTimeStep = true;
+    InitialConditions ic;
+    ic.velocity = Vector3D(0.05, 0, 0);
+
+    CFDSolver solver;
+    solver.initialize(mesh, config);
+    solver.setInitialConditions(ic);
+    solver.solve();
+    EXPECT_EQ(solver.getCurrentTime(), config.endTime);
+    EXPECT_GE(solver.getSmallestTimeStep(), 1e-6);
+    EXPECT_GT(solver.getCurrentIteration(), 9);
+}
+
+TEST(ThermoTest, BatchedMatchesPerCell) {
+    // Two species whose NASA ranges switch at Tmid inside the sampled
+    // temperatures; one mass-fraction field in float, one in double
+    ThermodynamicProperties thermo;
+    Species n2("N2", 28.0134);
+    n2.setNASACoeffs({3.531, -1.237e-4, -5.030e-7, 2.435e-9, -1.409e-12, -1046.98, 2.967},
+                     {2.953, 1.397e-3, -4.926e-7, 7.860e-11, -4.608e-15, -923.95, 5.872}, 1000.0);
+    Species o2("O2", 31.9988);
+    o2.setNASACoeffs({3.782, -2.997e-3, 9.847e-6, -9.682e-9, 3.244e-12, -1063.94, 3.658},
+                     {3.661, 6.564e-4, -1.411e-7, 2.058e-11, -1.299e-15, -1215.98, 3.415}, 1000.0);
+    thermo.addSpecies(n2);
+    thermo.addSpecies(o2);
+
+    const label n = 1000;
+    Field yN2("Y_N2", FieldType::SCALAR, n, FieldPrecision::FLOAT);
+    Field yO2("Y_O2", FieldType::SCALAR, n);
+    std::vector<double> T(n), p(n);
+    for (label c = 0; c < n; ++c) {
+        T[c] = 300.0 + 1.5 * c;
+        p[c] = 101325.0 * (1.0 + 0.001 * c);
+        yO2(c) = 0.1 + 0.2 * c / n;
+        yN2.setValue(c, 0, 1.0 - yO2(c));
+    }
+    const std::vector<const Field*> Y = {&yN2, &yO2};
+
+    // A sub-range, with sentinels outside it left untouched
+    const label begin = 7, end = 905;
+    std::vector<double> rho(n, -1.0), cp(n, -1.0), h(n, -1.0), mu(n, -1.0);
+    thermo.computeDensity(T.data(), p.data(), Y, begin, end, rho.data());
+    thermo.computeCp(T.data(), Y, begin, end, cp.data());
+    thermo.computeEnthalpy(T.data(), Y, begin, end, h.data());
+    thermo.computeViscosity(T.data(), Y, begin, end, mu.data());
+
+    for (label c = 0; c < n; ++c) {
+        if (c < begin || c >= end) {
+            EXPECT_EQ(rho[c], -1.0);
+            EXPECT_EQ(h[c], -1.0);
+            continue;
+        }
+        const std::vector<double> y = {yN2.value(c), yO2.value(c)};
+        EXPECT_NEAR(rho[c], thermo.getDensity(T[c], p[c], y), 1e-12 * rho[c]);
+        EXPECT_NEAR(cp[c], thermo.getCp(T[c], y), 1e-12 * cp[c]);
+        EXPECT_NEAR(h[c], thermo.getEnthalpy(T[c], y), 1e-9 * std::abs(h[c]) + 1e-9);
+        EXPECT_NEAR(mu[c], thermo.getViscosity(T[c], y), 1e-12 * mu[c]);
+    }
+
+    // No species: air molecular weight, as the per-cell function
+    const std::vector<const Field*> none;
+    thermo.computeDensity(T.data(), p.data(), none, 0, n, rho.data());
+    EXPECT_NEAR(rho[0], thermo.getDensity(T[0], p[0], {}), 1e-12 * rho[0]);
+
+    // Mass-fraction fields must cover the range
+    Field shortField("Y_short", FieldType::SCALAR, 10);
+    const std::vector<const Field*> bad = {&shortField};
+    EXPECT_THROW(thermo.computeCp(T.data(), bad, 0, n, cp.data()), std::invalid_argument);
+}
+
+TEST(ThermoTest, SolverDensityFromSpecies) {
+    // Species added to the solver get float mass-fraction fields that the
+    // equation of state reads every step
+    Species n2("N2", 28.0134);
+    Species o2("O2", 31.9988);
+    Mesh mesh = MeshGenerator::createBoxMesh(3, 3, 3, Vector3D(0, 0, 0), Vector3D(1, 1, 1));
+    SimulationConfig config;
+    config.endTime = 2e-3;
+    config.timeStep = 1e-3;
+    CFDSolver solver;
+    solver.initialize(mesh, config);
+    solver.addSpecies(n2);
+    solver.addSpecies(o2);
+    
+    InitialConditions ic;
+    ic.temperature = 800.0;
+    EXPECT_THROW(solver.setInitialConditions(ic), std::invalid_argument);
+    ic.massFractions = {0.4, 0.6};
+    solver.setInitialConditions(ic);
+    solver.solve();
+    
+    ThermodynamicProperties thermo;
+    thermo.addSpecies(n2);
+    thermo.addSpecies(o2);
+    const FieldManager& fields = solver.getFields();
+    const Field& yN2 = fields.getField("Y_N2");
+    const Field& yO2 = fields.getField("Y_O2");
+    EXPECT_TRUE(yN2.isFloat());
+    const Field& T = fields.getField("temperature");
+    const Field& p = fields.getField("pressure");
+    const Field& rho = fields.getField("density");
+    for (label c = 0; c < mesh.getNumCells(); ++c) {
+        const double expected = thermo.getDensity(T(c), p(c), {yN2.value(c), yO2.value(c)});
+        EXPECT_NEAR(rho(c), expected, 1e-12 * expected);
+    }
+    // Heavier than air at the same state
+    EXPECT_GT(rho(0), thermo.getDensity(T(0), p(0), {}) * 1.03);
+}
+
+TEST(TurbulenceTest, ViscosityUsesStartOfStepDensity) {
+    // Solver order: rotate levels, solve turbulence, then rewrite density.
+    // In step 2 the current density still holds the step-0 buffer, so mu_t
+    // must come from the old level (the density at the start of the step)
+    Mesh mesh = MeshGenerator::createBoxMesh(3, 3, 3, Vector3D(0, 0, 0), Vector3D(1, 1, 1));
+    const label numCells = mesh.getNumCells();
+    FieldManager fields;
+    ScalarFieldId densityId = fields.registerScalarField("density", numCells);
+    KEpsilonModel turbulence;
+    turbulence.initialize(mesh, fields);
+
+    auto densityAt = [](int step, label c) { return 1.0 + 0.5 * step + 0.01 * c; };
+    for (label c = 0; c < numCells; ++c) fields.getField(densityId)(c) = densityAt(0, c);
+    fields.setNumOldTimeLevels(densityId, 1);
+
+    for (int step = 0; step < 2; ++step) {
+        fields.advanceTimeLevels();
+        turbulence.solve(fields, 1e-3);
+        const Field& k = fields.getField("k");
+        const Field& epsilon = fields.getField("epsilon");
+        for (label c = 0; c < numCells; ++c) {
+            const double expected = densityAt(step, c) * 0.09 * k.value(c) * k.value(c) / epsilon.value(c);
+            EXPECT_NEAR(turbulence.getTurbulentViscosity(c), expected, 1e-12 * expected) << "step " << step;
+        }
+        for (label c = 0; c < numCells; ++c) fields.getField(densityId)(c) = densityAt(step + 1, c);
+    }
+}
+
+TEST(TurbulenceTest, FloatStorageTracksDouble) {
+    // The solver stores k and epsilon in float; a double-precision model
+    // run over the same steps is the reference for their integrals
+    Mesh mesh = MeshGenerator::createBoxMesh(4, 4, 4, Vector3D(0, 0, 0), Vector3D(1, 1, 1));
+    const label numCells = mesh.getNumCells();
+    SimulationConfig config;
+    config.endTime = 2.0;
+    config.timeStep = 0.02;
+    config.outputInterval = 10.0;
+    config.checkpointInterval = 10.0;
+
+    CFDSolver solver;
+    solver.initialize(mesh, config);
+    solver.setInitialConditions(InitialConditions());
+    solver.solve();
+    const FieldManager& solverFields = solver.getFields();
+    const Field& k = solverFields.getField("k");
+    const Field& epsilon = solverFields.getField("epsilon");
+    EXPECT_TRUE(k.isFloat());
+    EXPECT_TRUE(epsilon.isFloat());
+
+    FieldManager reference;
+    reference.getField(reference.registerScalarField("k", numCells)).fill(0.1);
+    reference.getField(reference.registerScalarField("epsilon", numCells)).fill(0.01);
+    KEpsilonModel turbulence;
+    turbulence.initialize(mesh, reference);
+    for (int step = 0; step < solver.getCurrentIteration(); ++step) {
+        turbulence.solve(reference, config.timeStep);
+    }
+    const Field& kRef = reference.getField("k");
+    const Field& epsilonRef = reference.getField("epsilon");
+    EXPECT_FALSE(kRef.isFloat());
+    EXPECT_GT(std::abs(epsilonRef(0) - 0.01), 5e-4);  // The quantities did evolve
+    const double kTotal = volumeIntegral(mesh, kRef);
+    const double epsilonTotal = volumeIntegral(mesh, epsilonRef);
+    EXPECT_NEAR(volumeIntegral(mesh, k), kTotal, 1e-5 * kTotal);
+    EXPECT_NEAR(volumeIntegral(mesh, epsilon), epsilonTotal, 1e-5 * epsilonTotal);
+
+    FieldMemoryUsage usage;
+    solverFields.getTotalMemoryUsage(&usage);
+    EXPECT_EQ(usage.numFloatFields, 2);
+    EXPECT_EQ(usage.floatSavedBytes, 2 * static_cast<size_t>(numCells) * sizeof(float));
+}
+
+TEST(TimeStepTest, ChemistryLimitOverAllCells) {
+    // A -> B, first order: the consumption time 1 / (k rho) is shorter in
+    // the denser cell whichever order the cells are integrated in
+    ReactionMechanism mechanism;
+    mechanism.addSpecies(Species("A", 28.0));
+    mechanism.addSpecies(Species("B", 28.0));
+    Reaction reaction;
+    reaction.reactants = {0};
+    reaction.stoichReactants = {1.0};
+    reaction.products = {1};
+    reaction.stoichProducts = {1.0};
+    reaction.A = 10.0;
+    reaction.reversible = false;
+    mechanism.addReaction(reaction);
+
+    ChemistryIntegrator chemistry;
+    chemistry.setMechanism(mechanism);
+    auto integrateCell = [&](double p) {
+        std::vector<double> Y = {0.5, 0.5};
+        chemistry.integrate(1000.0, p, Y, 1e-9);
+    };
+
+    chemistry.beginStep();
+    integrateCell(1e6);
+    const double denseLimit = chemistry.getMaxTimeStep();
+    chemistry.beginStep();
+    integrateCell(1e5);
+    const double lightLimit = chemistry.getMaxTimeStep();
+    ASSERT_LT(denseLimit, lightLimit);
+
+    chemistry.beginStep();
+    integrateCell(1e6);
+    integrateCell(1e5);
+    EXPECT_DOUBLE_EQ(chemistry.getMaxTimeStep(), denseLimit);
+
+    chemistry.beginStep();
+    EXPECT_EQ(chemistry.getMaxTimeStep(), std::numeric_limits<double>::max());
+}